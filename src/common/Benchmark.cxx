@@ -0,0 +1,289 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <chrono>
+#include <random>
+
+#include "OSystem.hxx"
+#include "Console.hxx"
+#include "Cart.hxx"
+#include "TIA.hxx"
+#include "EventHandler.hxx"
+#include "FrameBuffer.hxx"
+#include "Settings.hxx"
+#include "FSNode.hxx"
+#include "HeadlessRunner.hxx"
+#include "AtariNTSC.hxx"
+
+#include "Benchmark.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Benchmark::Benchmark(OSystem& osystem)
+  : myOSystem(osystem)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Benchmark::Result Benchmark::run(const FilesystemNode& rom, uInt32 frames)
+{
+  Result result;
+  result.path = rom.getPath();
+
+  // Console creation (including the autodetection of the display format)
+  // isn't part of the measurement
+  BenchmarkTimer::enable(false);
+  const string& error = myOSystem.createConsole(rom);
+  if(error != EmptyString)
+  {
+    result.error = error;
+    return result;
+  }
+
+  Console& console = myOSystem.console();
+  result.bsType = console.cartridge().detectedType();
+  result.format = console.about().DisplayFormat;
+
+  // The speed is measured with the timers disabled, since they add some
+  // overhead to each call of the code they measure
+  const uInt64 startCycles = console.tia().cycles();
+  const uInt64 startTime = myOSystem.getTicks();
+  result.frames = runFrames(frames, result.error);
+  result.time = myOSystem.getTicks() - startTime;
+  result.cycles = console.tia().cycles() - startCycles;
+
+  // The time taken by each subsystem is then measured in a second pass
+  // over the same number of frames, with the timers enabled
+  if(result.error == "")
+  {
+    BenchmarkTimer::reset();
+    BenchmarkTimer::enable(true);
+    const uInt64 startSplitTime = myOSystem.getTicks();
+    runFrames(result.frames, result.error);
+    result.splitTime = myOSystem.getTicks() - startSplitTime;
+    BenchmarkTimer::enable(false);
+
+    for(int i = 0; i < BenchmarkTimer::NumSubsystems; ++i)
+      result.subsystem[i] = BenchmarkTimer::total(BenchmarkTimer::Subsystem(i));
+  }
+
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Benchmark::runFrames(uInt32 frames, string& error)
+{
+  // Run through the normal path for each frame, so that everything
+  // (including rendering of the TIA image) is measured
+  FrameBuffer& fb = myOSystem.frameBuffer();
+  for(uInt32 frame = 0; frame < frames; ++frame)
+  {
+    // Entering the debugger (ie, on a fatal error) stops the emulation
+    if(myOSystem.eventHandler().state() != EventHandlerState::EMULATION)
+    {
+      error = "emulation stopped after " + std::to_string(frame) + " frames";
+      return frame;
+    }
+    fb.update();
+  }
+  return frames;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Benchmark::runAll(const FilesystemNode& node, uInt32 frames, ostream& out)
+{
+  FSList files;
+  HeadlessRunner::getRomFiles(node, files);
+
+  Result total;
+  total.path = "TOTAL";
+  total.bsType = total.format = "-";
+
+  // Rendering mustn't wait for the refresh of the display; the setting is
+  // restored afterwards, so that it isn't saved to the config file
+  Settings& settings = myOSystem.settings();
+  const bool vsync = settings.getBool("vsync");
+  settings.setValue("vsync", false);
+
+  uInt32 failed = 0;
+  printHeader(out);
+  for(const auto& file: files)
+  {
+    const Result& result = run(file, frames);
+    print(result, out);
+    if(result.error != "")
+    {
+      ++failed;
+      continue;
+    }
+
+    total.frames += result.frames;
+    total.cycles += result.cycles;
+    total.time   += result.time;
+    total.splitTime += result.splitTime;
+    for(int i = 0; i < BenchmarkTimer::NumSubsystems; ++i)
+      total.subsystem[i] += result.subsystem[i];
+  }
+  if(files.size() > 1)
+    print(total, out);
+
+  settings.setValue("vsync", vsync);
+
+  return failed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Benchmark::runNTSC(uInt32 frames, ostream& out)
+{
+  using Kernel = AtariNTSC::Kernel;
+
+  // A full NTSC frame; since each pixel is filtered the same way, random
+  // pixels are as good as a real image, and also test all palette entries
+  constexpr uInt32 width = 160, height = 262, numImages = 16;
+  const uInt32 outWidth = AtariNTSC::outWidth(width);
+  const AtariNTSC::Setup* setups[] = {
+    &AtariNTSC::TV_Composite, &AtariNTSC::TV_SVideo,
+    &AtariNTSC::TV_RGB, &AtariNTSC::TV_Bad
+  };
+
+  std::mt19937 random(2600);
+  uInt8 palette[AtariNTSC::palette_size * 3];
+  for(auto& c: palette)
+    c = uInt8(random());
+  unique_ptr<uInt8[]> images = make_unique<uInt8[]>(width * height * numImages);
+  for(uInt32 i = 0; i < width * height * numImages; ++i)
+    images[i] = uInt8(random()) & 0xFE;
+  unique_ptr<uInt32[]> expected = make_unique<uInt32[]>(outWidth * height);
+  unique_ptr<uInt32[]> output = make_unique<uInt32[]>(outWidth * height);
+
+  // The filter is quite large, so don't put it on the stack
+  unique_ptr<AtariNTSC> ntsc = make_unique<AtariNTSC>();
+  auto render = [&](Kernel kernel, uInt32 image, uInt32* buffer) {
+    ntsc->setKernel(kernel);
+    ntsc->render(&images[width * height * (image % numImages)], width, height,
+                 buffer, outWidth * sizeof(uInt32));
+  };
+
+  out << "Kernel|Frames|Time (s)|FPS|Speedup|Output" << endl;
+
+  uInt32 failed = 0;
+  double scalarTime = 0;
+  for(Kernel kernel: { Kernel::Scalar, Kernel::SSE2, Kernel::AVX2, Kernel::NEON })
+  {
+    if(!AtariNTSC::isKernelSupported(kernel))
+      continue;
+
+    ntsc->initialize(AtariNTSC::TV_Composite, palette);
+    const auto start = std::chrono::steady_clock::now();
+    for(uInt32 frame = 0; frame < frames; ++frame)
+      render(kernel, frame, output.get());
+    const double time = std::max(std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - start).count(), 1e-9);
+    if(kernel == Kernel::Scalar)
+      scalarTime = time;
+
+    // Every setup results in different kernel tables, so check them all
+    bool identical = true;
+    for(const AtariNTSC::Setup* setup: setups)
+    {
+      ntsc->initialize(*setup, palette);
+      for(uInt32 image = 0; image < numImages && identical; ++image)
+      {
+        render(Kernel::Scalar, image, expected.get());
+        render(kernel, image, output.get());
+        identical = std::equal(expected.get(), expected.get() + outWidth * height,
+                               output.get());
+      }
+    }
+    if(!identical)
+      ++failed;
+
+    ostringstream buf;
+    buf << std::fixed << std::setprecision(3)
+        << AtariNTSC::kernelName(kernel) << "|"
+        << frames << "|"
+        << time << "|"
+        << std::setprecision(1) << frames / time << "|"
+        << std::setprecision(2) << scalarTime / time << "|"
+        << (identical ? "identical" : "DIFFERENT");
+    out << buf.str() << endl;
+  }
+
+  return failed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Benchmark::printHeader(ostream& out)
+{
+  out << "File|"
+      << "Type|"
+      << "Format|"
+      << "Frames|"
+      << "Time (s)|"
+      << "FPS|"
+      << "MHz|"
+      << "CPU %|"
+      << "TIA %|"
+      << "ARM %|"
+      << "Render %|"
+      << "Audio %|"
+      << "Other %"
+      << endl;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Benchmark::print(const Result& result, ostream& out)
+{
+  out << result.path << "|";
+  if(result.error != "" && result.frames == 0)
+  {
+    out << "ERROR: " << result.error << endl;
+    return;
+  }
+
+  // All times in nanoseconds
+  const double time = std::max(double(result.time) * 1000.0, 1.0);
+  const double splitTime = std::max(double(result.splitTime) * 1000.0, 1.0);
+  const uInt64* t = result.subsystem;
+
+  // The CPU drives the TIA and ARM, so their time is included in that of
+  // the CPU; we only want the time taken by the CPU itself
+  const double cpu = std::max(double(t[BenchmarkTimer::CPU]) -
+      t[BenchmarkTimer::TIA] - t[BenchmarkTimer::ARM], 0.0);
+  const double other = std::max(splitTime - t[BenchmarkTimer::CPU] -
+      t[BenchmarkTimer::Render] - t[BenchmarkTimer::Audio], 0.0);
+  auto percent = [&](double value) { return 100.0 * value / splitTime; };
+
+  ostringstream buf;
+  buf << std::fixed << std::setprecision(3)
+      << result.bsType << "|"
+      << result.format << "|"
+      << result.frames << "|"
+      << time / 1e9 << "|"
+      << std::setprecision(1) << result.frames / time * 1e9 << "|"
+      << std::setprecision(3) << result.cycles / time * 1e3 << "|"
+      << std::setprecision(1)
+      << percent(cpu) << "|"
+      << percent(t[BenchmarkTimer::TIA]) << "|"
+      << percent(t[BenchmarkTimer::ARM]) << "|"
+      << percent(t[BenchmarkTimer::Render]) << "|"
+      << percent(t[BenchmarkTimer::Audio]) << "|"
+      << percent(other);
+  if(result.error != "")
+    buf << "|" << result.error;
+
+  out << buf.str() << endl;
+}
@@ -0,0 +1,135 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef BENCHMARK_HXX
+#define BENCHMARK_HXX
+
+class OSystem;
+class FilesystemNode;
+
+#include "bspf.hxx"
+#include "BenchmarkTimer.hxx"
+
+/**
+  This class measures the emulation speed for a set of ROMs, for detecting
+  performance regressions between releases.  Each ROM is run for a fixed
+  number of frames through the normal emulation path (TIA, CPU, cartridge,
+  rendering of the TIA image and sound), as fast as possible.
+
+  Besides the overall speed, the time spent in each of the major subsystems
+  is reported (see BenchmarkTimer).  Since the timers slow down the code
+  they measure, this is done in a second pass over the same number of
+  frames, and only the speed of the first pass is reported.  When combined with 'headless' mode,
+  no output devices are used at all, and the results only depend on the
+  emulation core.
+
+  @author  Stephen Anthony
+*/
+class Benchmark
+{
+  public:
+    /**
+      Contains the results of benchmarking a single ROM.
+    */
+    struct Result
+    {
+      string path;     // full path of the ROM file
+      string error;    // non-empty if the ROM couldn't be run
+      string bsType;   // bankswitch type (as detected/used)
+      string format;   // display format (NTSC/PAL/etc)
+      uInt32 frames;   // number of frames emulated
+      uInt64 cycles;   // number of system cycles emulated
+      uInt64 time;     // total time taken (in microseconds)
+      uInt64 splitTime;  // time taken by the instrumented pass (in microseconds)
+      uInt64 subsystem[BenchmarkTimer::NumSubsystems];  // (in nanoseconds)
+
+      Result() : frames(0), cycles(0), time(0), splitTime(0) {
+        std::fill_n(subsystem, int(BenchmarkTimer::NumSubsystems), 0);
+      }
+    };
+
+    Benchmark(OSystem& osystem);
+
+    /**
+      Create a console for the given ROM, and measure the time it takes
+      to emulate the given number of frames.
+
+      @param rom     The ROM file to run
+      @param frames  The number of frames to emulate
+
+      @return  The results of the run (the 'error' field is set on failure)
+    */
+    Result run(const FilesystemNode& rom, uInt32 frames);
+
+    /**
+      Benchmark the given ROM, or all ROMs in the given directory (or ZIP
+      archive), and print the results (one line per ROM, followed by the
+      totals for all ROMs) to the given stream.
+
+      @param node    A ROM file or a directory containing ROM files
+      @param frames  The number of frames to emulate for each ROM
+      @param out     The stream to print the results to
+
+      @return  The number of ROMs which couldn't be run
+    */
+    uInt32 runAll(const FilesystemNode& node, uInt32 frames, ostream& out);
+
+    /**
+      Render the given number of frames (of random pixels) through the NTSC
+      filter, once for each of its kernels supported by the CPU, and print
+      the time taken.  The output of the vectorized kernels is also compared
+      to that of the scalar kernel, which it must match bit-exactly.
+
+      @param frames  The number of frames to render for each kernel
+      @param out     The stream to print the results to
+
+      @return  The number of kernels whose output didn't match
+    */
+    static uInt32 runNTSC(uInt32 frames, ostream& out);
+
+    /**
+      Print the column names / the results of a single run,
+      as a '|' separated line.
+    */
+    static void printHeader(ostream& out);
+    static void print(const Result& result, ostream& out);
+
+  private:
+    /**
+      Emulate the given number of frames of the current console.
+
+      @param frames  The number of frames to emulate
+      @param error   Set if the emulation stopped before all frames were done
+
+      @return  The number of frames actually emulated
+    */
+    uInt32 runFrames(uInt32 frames, string& error);
+
+  private:
+    // The OSystem the consoles are created in
+    OSystem& myOSystem;
+
+  private:
+    // Following constructors and assignment operators not supported
+    Benchmark() = delete;
+    Benchmark(const Benchmark&) = delete;
+    Benchmark(Benchmark&&) = delete;
+    Benchmark& operator=(const Benchmark&) = delete;
+    Benchmark& operator=(Benchmark&&) = delete;
+};
+
+#endif
@@ -0,0 +1,126 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef BENCHMARK_TIMER_HXX
+#define BENCHMARK_TIMER_HXX
+
+#include <atomic>
+#include <chrono>
+
+#include "bspf.hxx"
+
+/**
+  This class accumulates the (wall-clock) time spent in each of the major
+  emulation subsystems, for use by the 'benchmark' mode.  Timing is off
+  by default, in which case a Scope costs only a single test.
+
+  Note that the subsystems nest; the time spent in the TIA and ARM
+  emulation is also included in the time of the CPU, which drives them.
+
+  @author  Stephen Anthony
+*/
+class BenchmarkTimer
+{
+  public:
+    enum Subsystem {
+      CPU,     // M6502::execute()
+      TIA,     // TIA::cycle()
+      ARM,     // Thumbulator::run()
+      Render,  // TIASurface::render()
+      Audio,   // sound generation
+      NumSubsystems
+    };
+
+    /**
+      Measures the time spent in the enclosing scope, when timing is enabled.
+    */
+    class Scope
+    {
+      public:
+        Scope(Subsystem subsystem)
+          : mySubsystem(subsystem),
+            myActive(enabled().load(std::memory_order_relaxed))
+        {
+          if(myActive)
+            myStart = Clock::now();
+        }
+        ~Scope()
+        {
+          if(myActive)
+            totals()[mySubsystem] += uInt64(std::chrono::duration_cast
+                <std::chrono::nanoseconds>(Clock::now() - myStart).count());
+        }
+
+      private:
+        Subsystem mySubsystem;
+        bool myActive;
+        std::chrono::steady_clock::time_point myStart;
+
+      private:
+        // Following constructors and assignment operators not supported
+        Scope() = delete;
+        Scope(const Scope&) = delete;
+        Scope(Scope&&) = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&) = delete;
+    };
+
+    /**
+      Turn timing on or off.
+    */
+    static void enable(bool enable) { enabled() = enable; }
+
+    /**
+      Reset all accumulated times to zero.
+    */
+    static void reset()
+    {
+      for(int i = 0; i < NumSubsystems; ++i)
+        totals()[i] = 0;
+    }
+
+    /**
+      Answer the accumulated time (in nanoseconds) for the given subsystem.
+    */
+    static uInt64 total(Subsystem subsystem) { return totals()[subsystem]; }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    // These are shared by all threads, since some subsystems (ie, sound)
+    // may run in a different thread than the emulation core
+    static std::atomic<bool>& enabled()
+    {
+      static std::atomic<bool> enabled(false);
+      return enabled;
+    }
+    static std::atomic<uInt64>* totals()
+    {
+      static std::atomic<uInt64> totals[NumSubsystems];
+      return totals;
+    }
+
+  private:
+    // Following constructors and assignment operators not supported
+    BenchmarkTimer() = delete;
+    BenchmarkTimer(const BenchmarkTimer&) = delete;
+    BenchmarkTimer(BenchmarkTimer&&) = delete;
+    BenchmarkTimer& operator=(const BenchmarkTimer&) = delete;
+    BenchmarkTimer& operator=(BenchmarkTimer&&) = delete;
+};
+
+#endif
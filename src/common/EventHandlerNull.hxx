@@ -0,0 +1,59 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef EVENTHANDLER_NULL_HXX
+#define EVENTHANDLER_NULL_HXX
+
+#include "EventHandler.hxx"
+
+/**
+  This class implements an event handler with no backend toolkit at all.
+  It never generates any events; it's used during headless emulation,
+  where the core still needs an Event object to query.
+
+  @author  Stephen Anthony
+*/
+class EventHandlerNull : public EventHandler
+{
+  public:
+    /**
+      Create a new null event handler object
+    */
+    EventHandlerNull(OSystem& osystem) : EventHandler(osystem) { }
+    virtual ~EventHandlerNull() = default;
+
+  private:
+    /**
+      Enable/disable text events (distinct from single-key events).
+    */
+    void enableTextEvents(bool enable) override { }
+
+    /**
+      There is no event source, so there is nothing to collect.
+    */
+    void pollEvent() override { }
+
+  private:
+    // Following constructors and assignment operators not supported
+    EventHandlerNull() = delete;
+    EventHandlerNull(const EventHandlerNull&) = delete;
+    EventHandlerNull(EventHandlerNull&&) = delete;
+    EventHandlerNull& operator=(const EventHandlerNull&) = delete;
+    EventHandlerNull& operator=(EventHandlerNull&&) = delete;
+};
+
+#endif
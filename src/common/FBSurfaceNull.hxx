@@ -0,0 +1,104 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef FBSURFACE_NULL_HXX
+#define FBSURFACE_NULL_HXX
+
+#include "bspf.hxx"
+#include "FBSurface.hxx"
+#include "Rect.hxx"
+
+/**
+  An FBSurface backed only by system memory, used when there is no
+  display available (ie, during headless emulation).  All drawing
+  primitives from FBSurface work as usual; the results simply never
+  make it to the screen.
+
+  @author  Stephen Anthony
+*/
+class FBSurfaceNull : public FBSurface
+{
+  public:
+    FBSurfaceNull(uInt32 width, uInt32 height, const uInt32* data)
+      : myWidth(0),
+        myHeight(0)
+    {
+      createSurface(width, height, data);
+    }
+    virtual ~FBSurfaceNull() = default;
+
+    uInt32 width() const override  { return mySrcR.width();  }
+    uInt32 height() const override { return mySrcR.height(); }
+
+    const GUI::Rect& srcRect() const override { return mySrcR; }
+    const GUI::Rect& dstRect() const override { return myDstR; }
+    void setSrcPos(uInt32 x, uInt32 y) override  { mySrcR.moveTo(x, y); }
+    void setSrcSize(uInt32 w, uInt32 h) override { mySrcR.setWidth(w);  mySrcR.setHeight(h); }
+    void setDstPos(uInt32 x, uInt32 y) override  { myDstR.moveTo(x, y); }
+    void setDstSize(uInt32 w, uInt32 h) override { myDstR.setWidth(w);  myDstR.setHeight(h); }
+    void setVisible(bool visible) override { }
+
+    void translateCoords(Int32& x, Int32& y) const override
+    {
+      x -= myDstR.x();  y -= myDstR.y();
+    }
+    bool render() override { return true; }
+    void invalidate() override { }
+    void free() override { }
+    void reload() override { }
+    void resize(uInt32 width, uInt32 height) override
+    {
+      // We will only resize when necessary
+      if(width <= myWidth && height <= myHeight)
+        return;
+
+      createSurface(width, height, nullptr);
+    }
+
+  protected:
+    void applyAttributes(bool immediate) override { }
+
+  private:
+    void createSurface(uInt32 width, uInt32 height, const uInt32* data)
+    {
+      myWidth  = width;
+      myHeight = height;
+      myBuffer = make_unique<uInt32[]>(width * height);
+      if(data)
+        std::copy_n(data, width * height, myBuffer.get());
+
+      mySrcR = myDstR = GUI::Rect(width, height);
+
+      myPixels = myBuffer.get();
+      myPitch  = width;
+    }
+
+    // Following constructors and assignment operators not supported
+    FBSurfaceNull() = delete;
+    FBSurfaceNull(const FBSurfaceNull&) = delete;
+    FBSurfaceNull(FBSurfaceNull&&) = delete;
+    FBSurfaceNull& operator=(const FBSurfaceNull&) = delete;
+    FBSurfaceNull& operator=(FBSurfaceNull&&) = delete;
+
+  private:
+    unique_ptr<uInt32[]> myBuffer;
+    uInt32 myWidth, myHeight;
+
+    GUI::Rect mySrcR, myDstR;
+};
+
+#endif
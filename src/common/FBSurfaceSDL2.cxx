@@ -24,6 +24,8 @@ FBSurfaceSDL2::FBSurfaceSDL2(FrameBufferSDL2& buffer,
     mySurface(nullptr),
     myTexture(nullptr),
     mySurfaceIsDirty(true),
+    myDirtyTop(0),
+    myDirtyBottom(~0u),
     myIsVisible(true),
     myTexAccess(SDL_TEXTUREACCESS_STREAMING),
     myInterpolate(false),
@@ -90,6 +92,9 @@ void FBSurfaceSDL2::setSrcPos(uInt32 x, uInt32 y)
 {
   mySrcR.x = x;  mySrcR.y = y;
   mySrcGUIR.moveTo(x, y);
+
+  // Parts of the texture that weren't displayed before may be stale
+  myDirtyTop = 0;  myDirtyBottom = ~0u;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -97,6 +102,9 @@ void FBSurfaceSDL2::setSrcSize(uInt32 w, uInt32 h)
 {
   mySrcR.w = w;  mySrcR.h = h;
   mySrcGUIR.setWidth(w);  mySrcGUIR.setHeight(h);
+
+  // Parts of the texture that weren't displayed before may be stale
+  myDirtyTop = 0;  myDirtyBottom = ~0u;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -136,7 +144,21 @@ bool FBSurfaceSDL2::render()
 
 //cerr << "render()\n";
     if(myTexAccess == SDL_TEXTUREACCESS_STREAMING)
-      SDL_UpdateTexture(myTexture, &mySrcR, mySurface->pixels, mySurface->pitch);
+    {
+      // Only upload the rows that changed since the last upload
+      const uInt32 top = std::max(myDirtyTop, uInt32(mySrcR.y));
+      const uInt32 bottom = std::min(myDirtyBottom, uInt32(mySrcR.y + mySrcR.h));
+
+      if(top < bottom)
+      {
+        const SDL_Rect rect = { mySrcR.x, Int32(top), mySrcR.w, Int32(bottom - top) };
+        const uInt8* pixels = static_cast<const uInt8*>(mySurface->pixels) +
+            top * mySurface->pitch + mySrcR.x * myFB.myPixelFormat->BytesPerPixel;
+
+        SDL_UpdateTexture(myTexture, &rect, pixels, mySurface->pitch);
+      }
+      myDirtyTop = ~0u;  myDirtyBottom = 0;
+    }
     SDL_RenderCopy(myFB.myRenderer, myTexture, &mySrcR, &myDstR);
 
     mySurfaceIsDirty = false;
@@ -147,6 +169,18 @@ bool FBSurfaceSDL2::render()
   return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FBSurfaceSDL2::setDirtyRows(uInt32 y, uInt32 h)
+{
+  mySurfaceIsDirty = true;
+
+  if(h > 0)
+  {
+    myDirtyTop = std::min(myDirtyTop, y);
+    myDirtyBottom = std::max(myDirtyBottom, y + h);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FBSurfaceSDL2::invalidate()
 {
@@ -171,6 +205,9 @@ void FBSurfaceSDL2::reload()
   myTexture = SDL_CreateTexture(myFB.myRenderer, myFB.myPixelFormat->format,
       myTexAccess, mySurface->w, mySurface->h);
 
+  // The new texture has to be uploaded completely
+  myDirtyTop = 0;  myDirtyBottom = ~0u;
+
   // If the data is static, we only upload it once
   if(myTexAccess == SDL_TEXTUREACCESS_STATIC)
     SDL_UpdateTexture(myTexture, nullptr, myStaticData, myStaticPitch);
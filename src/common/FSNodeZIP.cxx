@@ -186,12 +186,7 @@ uInt32 FilesystemNodeZIP::read(BytePtr& image) const
   }
 
   ZipHandler& zip = open(_zipFile);
-
-  bool found = false;
-  while(zip.hasNext() && !found)
-    found = zip.next() == _virtualPath;
-
-  return found ? zip.decompress(image) : 0;
+  return zip.find(_virtualPath) ? zip.decompress(image) : 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -205,6 +200,3 @@ AbstractFSNode* FilesystemNodeZIP::getParent() const
 
   return new FilesystemNodeZIP(string(start, end - start - 1));
 }
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-unique_ptr<ZipHandler> FilesystemNodeZIP::myZipHandler = make_unique<ZipHandler>();
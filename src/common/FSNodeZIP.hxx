@@ -65,6 +65,10 @@ class FilesystemNodeZIP : public AbstractFSNode
 
     uInt32 read(BytePtr& image) const;
 
+    // A file inside the archive changes only when the archive does
+    bool getStats(uInt64& size, uInt64& modtime) const
+    { return _realNode && _realNode->getStats(size, modtime); }
+
   private:
     FilesystemNodeZIP(const string& zipfile, const string& virtualpath,
         shared_ptr<AbstractFSNode> realnode, bool isdir);
@@ -99,12 +103,14 @@ class FilesystemNodeZIP : public AbstractFSNode
 
     bool _isDirectory, _isFile;
 
-    // ZipHandler static reference variable responsible for accessing ZIP files
-    static unique_ptr<ZipHandler> myZipHandler;
+    // ZipHandler responsible for accessing ZIP files
+    // Each thread gets its own handler, so that different threads can
+    // read from (possibly the same) ZIP files at the same time
     inline static ZipHandler& open(const string& file)
     {
-      myZipHandler->open(file);
-      return *myZipHandler;
+      static thread_local ZipHandler handler;
+      handler.open(file);
+      return handler;
     }
 
     // Get last component of path
@@ -0,0 +1,111 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef FRAMEBUFFER_NULL_HXX
+#define FRAMEBUFFER_NULL_HXX
+
+class OSystem;
+
+#include "bspf.hxx"
+#include "FrameBuffer.hxx"
+#include "FBSurfaceNull.hxx"
+
+/**
+  This class implements a framebuffer that never opens a window or
+  touches the video hardware.  It is used for headless emulation, where
+  only the emulation core (and perhaps the TIA framebuffer contents) is
+  of interest.  Surfaces created here are kept in system memory.
+
+  @author  Stephen Anthony
+*/
+class FrameBufferNull : public FrameBuffer
+{
+  public:
+    /**
+      Creates a new null framebuffer
+    */
+    FrameBufferNull(OSystem& osystem) : FrameBuffer(osystem) { }
+    virtual ~FrameBufferNull() = default;
+
+    //////////////////////////////////////////////////////////////////////
+    // The following are derived from public methods in FrameBuffer.hxx
+    //////////////////////////////////////////////////////////////////////
+    void showCursor(bool show) override { }
+    bool fullScreen() const override { return false; }
+
+    /**
+      Pixels are always stored in ARGB8888 format.
+    */
+    void getRGB(uInt32 pixel, uInt8* r, uInt8* g, uInt8* b) const override
+    {
+      *r = (pixel >> 16) & 0xff;  *g = (pixel >> 8) & 0xff;  *b = pixel & 0xff;
+    }
+    uInt32 mapRGB(uInt8 r, uInt8 g, uInt8 b) const override
+    {
+      return (uInt32(r) << 16) | (uInt32(g) << 8) | uInt32(b);
+    }
+
+    /**
+      There is no onscreen image, so this always returns a black area.
+    */
+    void readPixels(uInt8* buffer, uInt32 pitch, const GUI::Rect& rect) const override
+    {
+      for(uInt32 y = 0; y < rect.height(); ++y)
+        std::fill_n(buffer + y * pitch, rect.width() << 2, 0);
+    }
+
+    void clear() override { }
+
+  protected:
+    //////////////////////////////////////////////////////////////////////
+    // The following are derived from protected methods in FrameBuffer.hxx
+    //////////////////////////////////////////////////////////////////////
+    /**
+      Report a single display large enough for every video mode, and
+      a single (pseudo) renderer.
+    */
+    void queryHardware(vector<GUI::Size>& displays, VariantList& renderers) override
+    {
+      displays.emplace_back(1920, 1080);
+      VarList::push_back(renderers, "None", "null");
+    }
+
+    Int32 getCurrentDisplayIndex() override { return 0; }
+    bool setVideoMode(const string& title, const VideoMode& mode) override { return true; }
+    void invalidate() override { }
+
+    unique_ptr<FBSurface> createSurface(uInt32 w, uInt32 h, const uInt32* data)
+        const override
+    {
+      return make_unique<FBSurfaceNull>(w, h, data);
+    }
+
+    void grabMouse(bool grab) override { }
+    void setWindowIcon() override { }
+    string about() const override { return "Video system: none (headless)\n"; }
+    void postFrameUpdate() override { }
+
+  private:
+    // Following constructors and assignment operators not supported
+    FrameBufferNull() = delete;
+    FrameBufferNull(const FrameBufferNull&) = delete;
+    FrameBufferNull(FrameBufferNull&&) = delete;
+    FrameBufferNull& operator=(const FrameBufferNull&) = delete;
+    FrameBufferNull& operator=(FrameBufferNull&&) = delete;
+};
+
+#endif
@@ -0,0 +1,338 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <thread>
+#include <unordered_map>
+
+#include "MediaFactory.hxx"
+#include "OSystem.hxx"
+#include "Settings.hxx"
+#include "Random.hxx"
+#include "Console.hxx"
+#include "Cart.hxx"
+#include "M6532.hxx"
+#include "System.hxx"
+#include "TIA.hxx"
+#include "FSNode.hxx"
+#include "MD5.hxx"
+#include "BSTypeCache.hxx"
+#include "Base.hxx"
+#include "SoundWav.hxx"
+#include "LauncherFilterDialog.hxx"
+
+#ifdef DEBUGGER_SUPPORT
+  #include "Debugger.hxx"
+  #include "CartDebug.hxx"
+#endif
+
+#include "HeadlessRunner.hxx"
+
+using Common::Base;
+
+std::mutex HeadlessRunner::ourDebuggerMutex;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+HeadlessRunner::HeadlessRunner(OSystem& osystem)
+  : myOSystem(osystem)
+{
+  // Results must only depend on the ROM, and not on when (or in which
+  // thread) it was run
+  myOSystem.random().useFixedSeed(0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+HeadlessRunner::Result HeadlessRunner::run(const FilesystemNode& rom, uInt32 frames)
+{
+  Result result;
+  result.path = rom.getPath();
+
+  unique_ptr<Console> console;
+  try
+  {
+    console = myOSystem.openConsole(rom, result.md5);
+  }
+  catch(const runtime_error& e)
+  {
+    result.error = e.what();
+    return result;
+  }
+  if(!console)
+  {
+    result.error = "couldn't open ROM";
+    return result;
+  }
+
+  // Record the sound output, if requested; in this case, the OSystem
+  // has been created with a SoundWav object (see MediaFactory)
+  SoundWav* wav = nullptr;
+  const string& wavdir = myOSystem.settings().getString("wavdir");
+  if(wavdir != "")
+  {
+    FilesystemNode dir(wavdir);
+    if(!dir.isDirectory())
+      dir.makeDir();
+    const string& filename = FilesystemNode(wavdir).getPath() + rom.getName() + ".wav";
+
+    // This sets the number of channels of the file
+    console->initializeAudio();
+    wav = static_cast<SoundWav*>(&myOSystem.sound());
+    if(!wav->openFile(filename, console->system().cycles()))
+    {
+      result.error = "couldn't create " + filename;
+      return result;
+    }
+  }
+
+  TIA& tia = console->tia();
+  uInt32 startFrame = tia.frameCount();
+  for(uInt32 i = 0; i < frames; ++i)
+    tia.update();
+
+  if(wav)
+    wav->closeFile(console->system().cycles());
+
+  const ConsoleInfo& info = console->about();
+  result.md5       = info.CartMD5;
+  result.bsType    = console->cartridge().detectedType();
+  result.format    = info.DisplayFormat;
+  result.frames    = tia.frameCount() - startFrame;
+  result.scanlines = tia.scanlinesLastFrame();
+  result.cycles    = tia.cycles();
+  result.frameHash = MD5::hash(tia.frameBuffer(), tia.width() * tia.height());
+  for(uInt16 addr = 0; addr < 128; ++addr)
+    result.ram[addr] = console->riot().peek(0x80 | addr);
+
+#ifdef DEBUGGER_SUPPORT
+  // This is done last, since it switches banks
+  const string& disasmdir = myOSystem.settings().getString("disasmdir");
+  if(disasmdir != "")
+    result.error = disassemble(*console, rom, disasmdir);
+#endif
+
+  return result;
+}
+
+#ifdef DEBUGGER_SUPPORT
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string HeadlessRunner::disassemble(Console& console, const FilesystemNode& rom,
+                                   const string& dir)
+{
+  FilesystemNode node(dir);
+  if(!node.isDirectory())
+    node.makeDir();
+
+  unique_ptr<Debugger> debugger;
+  {
+    std::lock_guard<std::mutex> lock(ourDebuggerMutex);
+    debugger = make_unique<Debugger>(myOSystem, console);
+  }
+  // DiStella must be able to read the whole ROM without triggering
+  // any bankswitching
+  debugger->lockBankswitchState();
+  CartDebug& cart = debugger->cartDebug();
+
+  string error;
+  const string& asmfile = FilesystemNode(dir).getPath() + rom.getName() + ".asm";
+  ofstream asmout(asmfile);
+  if(asmout.is_open())
+  {
+    cart.writeDisassembly(asmout, rom, true);
+
+    // The directives include the code determined by DiStella, so they
+    // can only be written after the disassembly
+    const string& cfgfile = FilesystemNode(dir).getPath() + rom.getName() + ".cfg";
+    ofstream cfgout(cfgfile);
+    if(cfgout.is_open())
+      cart.writeConfigFile(cfgout, true);
+    else
+      error = "couldn't create " + cfgfile;
+  }
+  else
+    error = "couldn't create " + asmfile;
+
+  // Destroying the debugger changes static state too
+  {
+    std::lock_guard<std::mutex> lock(ourDebuggerMutex);
+    debugger.reset();
+  }
+  return error;
+}
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 HeadlessRunner::runAll(const FilesystemNode& node, uInt32 frames,
+                              uInt32 jobs, ostream& out)
+{
+  FSList files;
+  getRomFiles(node, files);
+
+  if(jobs == 0)
+    jobs = std::thread::hardware_concurrency();
+  jobs = BSPF::clamp(jobs, 1u, uInt32(files.size()));
+
+  vector<Result> results(files.size());
+  std::atomic<uInt32> next(0);
+
+  const Settings& settings = myOSystem.settings();
+  if(settings.getString("wavdir") != "" || settings.getString("disasmdir") != "")
+    checkOutputNames(files, results);
+
+  if(jobs > 1)
+  {
+    // Every worker gets its own OSystem; these are created here (one at
+    // a time), since OSystem creation touches shared resources
+    vector<unique_ptr<OSystem>> workers;
+    for(uInt32 i = 0; i < jobs; ++i)
+    {
+      unique_ptr<OSystem> osystem = createWorkerOSystem();
+      if(osystem)
+        workers.push_back(std::move(osystem));
+    }
+
+    unique_ptr<std::thread[]> threads = make_unique<std::thread[]>(workers.size());
+    for(uInt32 i = 0; i < workers.size(); ++i)
+    {
+      OSystem* osystem = workers[i].get();
+      threads[i] = std::thread([=, &files, &next, &results] {
+        HeadlessRunner runner(*osystem);
+        runner.runFiles(files, frames, next, results);
+      });
+    }
+    for(uInt32 i = 0; i < workers.size(); ++i)
+      threads[i].join();
+
+    // Only the main OSystem saves its detection cache on exit
+    for(const auto& worker: workers)
+      myOSystem.bsTypeCache().merge(worker->bsTypeCache());
+  }
+  // Take care of anything the workers didn't (or couldn't) run
+  runFiles(files, frames, next, results);
+
+  uInt32 failed = 0;
+  printHeader(out);
+  for(const auto& result: results)
+  {
+    if(result.error != "")
+      ++failed;
+    print(result, out);
+  }
+  return failed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void HeadlessRunner::runFiles(const FSList& files, uInt32 frames,
+                              std::atomic<uInt32>& next, vector<Result>& results)
+{
+  uInt32 i;
+  while((i = next++) < files.size())
+    if(results[i].error == "")  // not rejected by checkOutputNames()
+      results[i] = run(files[i], frames);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void HeadlessRunner::checkOutputNames(const FSList& files, vector<Result>& results)
+{
+  // The output files are named after the ROM files, which are all in the
+  // same directory; so names can only collide on case-insensitive systems
+  std::unordered_map<string, uInt32> names;
+  for(uInt32 i = 0; i < files.size(); ++i)
+  {
+    string name = files[i].getName();
+    std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+
+    const auto& it = names.emplace(name, i);
+    if(!it.second)
+    {
+      results[i].path  = files[i].getPath();
+      results[i].error = "output files would overwrite those of " +
+                         files[it.first->second].getPath();
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unique_ptr<OSystem> HeadlessRunner::createWorkerOSystem() const
+{
+  unique_ptr<OSystem> osystem = MediaFactory::createOSystem();
+  Settings& settings = osystem->settings();
+  settings.copyFrom(myOSystem.settings());
+
+  // Only the main OSystem should log anything
+  settings.setValue("loglevel", 0);
+
+  if(!osystem->create())
+    return nullptr;
+
+  return osystem;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void HeadlessRunner::getRomFiles(const FilesystemNode& node, FSList& files)
+{
+  if(node.isDirectory())
+  {
+    FSList children;
+    children.reserve(2048);
+    node.getChildren(children, FilesystemNode::kListFilesOnly);
+    for(const auto& file: children)
+    {
+      string extension;
+      if(LauncherFilterDialog::isValidRomName(file, extension))
+        files.push_back(file);
+    }
+    std::sort(files.begin(), files.end());
+  }
+  else
+    files.push_back(node);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void HeadlessRunner::printHeader(ostream& out)
+{
+  out << "File|"
+      << "MD5|"
+      << "Type|"
+      << "Format|"
+      << "Frames|"
+      << "Scanlines|"
+      << "Cycles|"
+      << "FrameMD5|"
+      << "RAM"
+      << endl;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void HeadlessRunner::print(const Result& result, ostream& out)
+{
+  out << result.path << "|";
+  if(result.error != "")
+  {
+    out << "ERROR: " << result.error << endl;
+    return;
+  }
+
+  out << result.md5       << "|"
+      << result.bsType    << "|"
+      << result.format    << "|"
+      << result.frames    << "|"
+      << result.scanlines << "|"
+      << result.cycles    << "|"
+      << result.frameHash << "|";
+  for(uInt32 i = 0; i < 128; ++i)
+    out << Base::HEX2 << int(result.ram[i]);
+  out << std::dec << endl;
+}
@@ -0,0 +1,173 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef HEADLESS_RUNNER_HXX
+#define HEADLESS_RUNNER_HXX
+
+class OSystem;
+class Console;
+class FilesystemNode;
+class FSList;
+
+#include <atomic>
+#include <mutex>
+
+#include "bspf.hxx"
+
+/**
+  This class runs the emulation core without any video, audio or event
+  processing, as fast as the host CPU allows.  It is meant for batch
+  processing of (possibly very many) ROMs, where only the final state of
+  each console is of interest; for example, for regression testing.
+
+  The OSystem must have been created in 'headless' mode, so that no
+  display or sound device is ever opened.  If the 'wavdir' setting is
+  given, the sound output of each ROM is written to a WAV file there
+  (named after the ROM file, with '.wav' appended).
+  If the 'disasmdir' setting is given, all banks of each ROM are
+  disassembled after the run (so that code and graphics which have
+  actually been accessed are recognized as such), and written there
+  as a DASM source file and a Distella config file (named after the
+  ROM file, with '.asm' and '.cfg' appended).
+
+  @author  Stephen Anthony
+*/
+class HeadlessRunner
+{
+  public:
+    /**
+      Contains the results of running a single ROM.
+    */
+    struct Result
+    {
+      string path;        // full path of the ROM file
+      string error;       // non-empty if the ROM couldn't be run
+      string md5;         // MD5 of the ROM image
+      string bsType;      // bankswitch type (as detected/used)
+      string format;      // display format (NTSC/PAL/etc)
+      uInt32 frames;      // number of frames actually emulated
+      uInt32 scanlines;   // scanlines in the last frame
+      uInt64 cycles;      // total system cycles emulated
+      string frameHash;   // MD5 of the final TIA framebuffer (palette indices)
+      uInt8  ram[128];    // final contents of the RIOT RAM
+
+      Result() : frames(0), scanlines(0), cycles(0) { memset(ram, 0, 128); }
+    };
+
+    HeadlessRunner(OSystem& osystem);
+
+    /**
+      Create a console for the given ROM, and run it for the given
+      number of frames.
+
+      @param rom     The ROM file to run
+      @param frames  The number of frames to emulate
+
+      @return  The results of the run (the 'error' field is set on failure)
+    */
+    Result run(const FilesystemNode& rom, uInt32 frames);
+
+    /**
+      Run the given ROM, or all ROMs in the given directory (or ZIP archive),
+      and print the results (one line per ROM, sorted by filename) to the
+      given stream.
+
+      The ROMs are distributed over the given number of worker threads.
+      Each worker creates its own headless OSystem (with the same settings
+      as ours), so that consoles running in parallel never share any state.
+      The results are identical to those of a single-threaded run.
+
+      @param node    A ROM file or a directory containing ROM files
+      @param frames  The number of frames to emulate for each ROM
+      @param jobs    The number of threads to use (0 means one per CPU core)
+      @param out     The stream to print the results to
+
+      @return  The number of ROMs which couldn't be run
+    */
+    uInt32 runAll(const FilesystemNode& node, uInt32 frames, uInt32 jobs,
+                  ostream& out);
+
+    /**
+      Get the given ROM, or all ROMs in the given directory (or ZIP
+      archive), sorted by filename.
+
+      @param node   A ROM file or a directory containing ROM files
+      @param files  The list to add the ROMs to
+    */
+    static void getRomFiles(const FilesystemNode& node, FSList& files);
+
+    /**
+      Print the column names / the results of a single run,
+      as a '|' separated line.
+    */
+    static void printHeader(ostream& out);
+    static void print(const Result& result, ostream& out);
+
+  private:
+    /**
+      Repeatedly take the next index from 'next' and run the corresponding
+      ROM, until all ROMs have been run.  This may be called from several
+      threads at once, each with its own HeadlessRunner.
+    */
+    void runFiles(const FSList& files, uInt32 frames,
+                  std::atomic<uInt32>& next, vector<Result>& results);
+
+    /**
+      Create another headless OSystem, with the same settings as ours.
+
+      @return  The new OSystem, or nullptr if it couldn't be created
+    */
+    unique_ptr<OSystem> createWorkerOSystem() const;
+
+    /**
+      Check that the files written for each ROM (which are named after the
+      ROM file) don't overwrite those of another ROM.  The results of any
+      ROMs for which this is the case are set to an error, and these ROMs
+      aren't run at all.
+    */
+    void checkOutputNames(const FSList& files, vector<Result>& results);
+
+  #ifdef DEBUGGER_SUPPORT
+    /**
+      Disassemble all banks of the given console's ROM, and write the
+      results to the given directory.
+
+      @return  An error message, or the empty string on success
+    */
+    string disassemble(Console& console, const FilesystemNode& rom,
+                       const string& dir);
+  #endif
+
+  private:
+    // The OSystem the consoles are created from
+    OSystem& myOSystem;
+
+    // Creating/destroying a debugger changes static state (the debugger
+    // returned by Debugger::debugger(), the DiStella settings), so the
+    // workers must do this one at a time
+    static std::mutex ourDebuggerMutex;
+
+  private:
+    // Following constructors and assignment operators not supported
+    HeadlessRunner() = delete;
+    HeadlessRunner(const HeadlessRunner&) = delete;
+    HeadlessRunner(HeadlessRunner&&) = delete;
+    HeadlessRunner& operator=(const HeadlessRunner&) = delete;
+    HeadlessRunner& operator=(HeadlessRunner&&) = delete;
+};
+
+#endif
@@ -43,12 +43,14 @@
 #endif
 
 #include "FrameBufferSDL2.hxx"
+#include "FrameBufferNull.hxx"
 #include "EventHandlerSDL2.hxx"
+#include "EventHandlerNull.hxx"
 #ifdef SOUND_SUPPORT
   #include "SoundSDL2.hxx"
-#else
-  #include "SoundNull.hxx"
 #endif
+#include "SoundNull.hxx"
+#include "SoundWav.hxx"
 
 /**
   This class deals with the different framebuffer/sound/event
@@ -59,6 +61,9 @@
   in case we ever have multiple backend implementations again (should
   not be necessary since SDL2 covers this nicely).
 
+  In 'headless' mode, null video/audio/event objects are always created,
+  so that emulation can run without a display or sound device.
+
   @author  Stephen Anthony
 */
 class MediaFactory
@@ -105,20 +110,31 @@ class MediaFactory
 
     static unique_ptr<FrameBuffer> createVideo(OSystem& osystem)
     {
+      if(osystem.settings().getBool("headless"))
+        return make_unique<FrameBufferNull>(osystem);
+
       return make_unique<FrameBufferSDL2>(osystem);
     }
 
     static unique_ptr<Sound> createAudio(OSystem& osystem)
     {
     #ifdef SOUND_SUPPORT
-      return make_unique<SoundSDL2>(osystem);
-    #else
-      return make_unique<SoundNull>(osystem);
+      if(!osystem.settings().getBool("headless"))
+        return make_unique<SoundSDL2>(osystem);
     #endif
+      // In headless mode, sound can only be written to WAV files
+      if(osystem.settings().getBool("headless") &&
+         osystem.settings().getString("wavdir") != "")
+        return make_unique<SoundWav>(osystem);
+
+      return make_unique<SoundNull>(osystem);
     }
 
     static unique_ptr<EventHandler> createEventHandler(OSystem& osystem)
     {
+      if(osystem.settings().getBool("headless"))
+        return make_unique<EventHandlerNull>(osystem);
+
       return make_unique<EventHandlerSDL2>(osystem);
     }
 
@@ -32,28 +32,37 @@ PNGLibrary::PNGLibrary(const FrameBuffer& fb)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PNGLibrary::loadImage(const string& filename, FBSurface& surface)
 {
-  #define loadImageERROR(s) { err_message = s; goto done; }
+  ImageData image;
+  readImage(filename, image);
+  loadImage(image, surface);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PNGLibrary::readImage(const string& filename, ImageData& image)
+{
+  #define readImageERROR(s) { err_message = s; goto done; }
 
   png_structp png_ptr = nullptr;
   png_infop info_ptr = nullptr;
   png_uint_32 iwidth, iheight;
   int bit_depth, color_type, interlace_type;
+  unique_ptr<png_bytep[]> row_pointers;
   const char* err_message = nullptr;
 
   ifstream in(filename, std::ios_base::binary);
   if(!in.is_open())
-    loadImageERROR("No image found");
+    readImageERROR("No image found");
 
   // Create the PNG loading context structure
   png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr,
                  png_user_error, png_user_warn);
   if(png_ptr == nullptr)
-    loadImageERROR("Couldn't allocate memory for PNG file");
+    readImageERROR("Couldn't allocate memory for PNG file");
 
   // Allocate/initialize the memory for image information.  REQUIRED.
 	info_ptr = png_create_info_struct(png_ptr);
   if(info_ptr == nullptr)
-    loadImageERROR("Couldn't create image information for PNG file");
+    readImageERROR("Couldn't create image information for PNG file");
 
   // Set up the input control
   png_set_read_fn(png_ptr, &in, png_read_data);
@@ -77,7 +86,7 @@ void PNGLibrary::loadImage(const string& filename, FBSurface& surface)
   }
   else if(color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
   {
-    loadImageERROR("Greyscale PNG images not supported");
+    readImageERROR("Greyscale PNG images not supported");
   }
   else if(color_type == PNG_COLOR_TYPE_PALETTE)
   {
@@ -85,26 +94,26 @@ void PNGLibrary::loadImage(const string& filename, FBSurface& surface)
   }
   else if(color_type != PNG_COLOR_TYPE_RGB)
   {
-    loadImageERROR("Unknown format in PNG image");
+    readImageERROR("Unknown format in PNG image");
   }
 
-  // Create/initialize storage area for the current image
-  if(!allocateStorage(iwidth, iheight))
-    loadImageERROR("Not enough memory to read PNG file");
+  // Create space for the entire image (3 bytes per pixel in RGB format)
+  image.width  = iwidth;
+  image.height = iheight;
+  image.pitch  = iwidth * 3;
+  image.buffer = make_unique<png_byte[]>(image.pitch * iheight);
+  row_pointers = make_unique<png_bytep[]>(iheight);
 
   // The PNG read function expects an array of rows, not a single 1-D array
-  for(uInt32 irow = 0, offset = 0; irow < ReadInfo.height; ++irow, offset += ReadInfo.pitch)
-    ReadInfo.row_pointers[irow] = png_bytep(ReadInfo.buffer.get() + offset);
+  for(uInt32 irow = 0, offset = 0; irow < iheight; ++irow, offset += image.pitch)
+    row_pointers[irow] = png_bytep(image.buffer.get() + offset);
 
   // Read the entire image in one go
-  png_read_image(png_ptr, ReadInfo.row_pointers.get());
+  png_read_image(png_ptr, row_pointers.get());
 
   // We're finished reading
   png_read_end(png_ptr, info_ptr);
 
-  // Load image into the surface, setting the correct dimensions
-  loadImagetoSurface(surface);
-
   // Cleanup
 done:
   if(png_ptr)
@@ -228,40 +237,10 @@ done:
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool PNGLibrary::allocateStorage(png_uint_32 w, png_uint_32 h)
-{
-  // Create space for the entire image (3 bytes per pixel in RGB format)
-  uInt32 req_buffer_size = w * h * 3;
-  if(req_buffer_size > ReadInfo.buffer_size)
-  {
-    ReadInfo.buffer = make_unique<png_byte[]>(req_buffer_size);
-    if(ReadInfo.buffer == nullptr)
-      return false;
-
-    ReadInfo.buffer_size = req_buffer_size;
-  }
-  uInt32 req_row_size = h;
-  if(req_row_size > ReadInfo.row_size)
-  {
-    ReadInfo.row_pointers = make_unique<png_bytep[]>(req_row_size);
-    if(ReadInfo.row_pointers == nullptr)
-      return false;
-
-    ReadInfo.row_size = req_row_size;
-  }
-
-  ReadInfo.width  = w;
-  ReadInfo.height = h;
-  ReadInfo.pitch  = w * 3;
-
-  return true;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void PNGLibrary::loadImagetoSurface(FBSurface& surface)
+void PNGLibrary::loadImage(const ImageData& image, FBSurface& surface)
 {
   // First determine if we need to resize the surface
-  uInt32 iw = ReadInfo.width, ih = ReadInfo.height;
+  uInt32 iw = image.width, ih = image.height;
   if(iw > surface.width() || ih > surface.height())
     surface.resize(iw, ih);
 
@@ -273,14 +252,14 @@ void PNGLibrary::loadImagetoSurface(FBSurface& surface)
   // Convert RGB triples into pixels and store in the surface
   uInt32 *s_buf, s_pitch;
   surface.basePtr(s_buf, s_pitch);
-  uInt8* i_buf = ReadInfo.buffer.get();
-  uInt32 i_pitch = ReadInfo.pitch;
+  const uInt8* i_buf = image.buffer.get();
+  uInt32 i_pitch = image.pitch;
 
   for(uInt32 irow = 0; irow < ih; ++irow, i_buf += i_pitch, s_buf += s_pitch)
   {
-    uInt8*  i_ptr = i_buf;
+    const uInt8* i_ptr = i_buf;
     uInt32* s_ptr = s_buf;
-    for(uInt32 icol = 0; icol < ReadInfo.width; ++icol, i_ptr += 3)
+    for(uInt32 icol = 0; icol < iw; ++icol, i_ptr += 3)
       *s_ptr++ = myFB.mapRGB(*i_ptr, *(i_ptr+1), *(i_ptr+2));
   }
 }
@@ -335,8 +314,3 @@ void PNGLibrary::png_user_error(png_structp ctx, png_const_charp str)
 {
   throw runtime_error(string("PNGLibrary error: ") + str);
 }
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-PNGLibrary::ReadInfoType PNGLibrary::ReadInfo = {
-  nullptr, nullptr, 0, 0, 0, 0, 0
-};
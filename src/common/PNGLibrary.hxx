@@ -25,6 +25,8 @@ class FBSurface;
 class Properties;
 
 #include "bspf.hxx"
+#include "Rect.hxx"
+#include "Variant.hxx"
 
 /**
   This class implements a thin wrapper around the libpng library, and
@@ -38,6 +40,12 @@ class PNGLibrary
   public:
     PNGLibrary(const FrameBuffer& fb);
 
+    // A decoded PNG image, stored as RGB triples
+    struct ImageData {
+      BytePtr buffer;
+      png_uint_32 width, height, pitch;
+    };
+
     /**
       Read a PNG image from the specified file into a FBSurface structure,
       scaling the image to the surface bounds.
@@ -51,6 +59,27 @@ class PNGLibrary
     */
     void loadImage(const string& filename, FBSurface& surface);
 
+    /**
+      Decode a PNG image from the specified file.  Since this doesn't
+      touch any surfaces, it may be called from any thread.
+
+      @param filename  The filename to load the PNG image
+      @param image     The decoded image data
+
+      @post  On failure, a runtime_error is thrown containing a more
+             detailed error message.
+    */
+    static void readImage(const string& filename, ImageData& image);
+
+    /**
+      Load previously decoded image data into the FBSurface.  The surface
+      is resized as necessary to accommodate the data.
+
+      @param image    The decoded image data
+      @param surface  The FBSurface into which to place the PNG data
+    */
+    void loadImage(const ImageData& image, FBSurface& surface);
+
     /**
       Save the current FrameBuffer image to a PNG file.  Note that in most
       cases this will be a TIA image, but it could actually be used for
@@ -85,30 +114,6 @@ class PNGLibrary
   private:
     const FrameBuffer& myFB;
 
-    // The following data remains between invocations of allocateStorage,
-    // and is only changed when absolutely necessary.
-    struct ReadInfoType {
-      BytePtr buffer;
-      unique_ptr<png_bytep[]> row_pointers;
-      png_uint_32 width, height, pitch;
-      uInt32 buffer_size, row_size;
-    };
-    static ReadInfoType ReadInfo;
-
-    /**
-      Allocate memory for PNG read operations.  This is used to provide a
-      basic memory manager, so that we don't constantly allocate and deallocate
-      memory for each image loaded.
-
-      The method fills the 'ReadInfo' struct with valid memory locations
-      dependent on the given dimensions.  If memory has been previously
-      allocated and it can accommodate the given dimensions, it is used directly.
-
-      @param iwidth  The width of the PNG image
-      @param iheight The height of the PNG image
-    */
-    bool allocateStorage(png_uint_32 iwidth, png_uint_32 iheight);
-
     /** The actual method which saves a PNG image.
 
       @param out      The output stream for writing PNG data
@@ -121,14 +126,6 @@ class PNGLibrary
                    png_uint_32 width, png_uint_32 height,
                    const VariantList& comments);
 
-    /**
-      Load the PNG data from 'ReadInfo' into the FBSurface.  The surface
-      is resized as necessary to accommodate the data.
-
-      @param surface  The FBSurface into which to place the PNG data
-    */
-    void loadImagetoSurface(FBSurface& surface);
-
     /**
       Write PNG tEXt chunks to the image.
     */
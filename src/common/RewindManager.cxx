@@ -120,15 +120,65 @@ bool RewindManager::addState(const string& message, bool timeMachine)
   if(myStateList.full())
     compressStates();
 
+  // Check if the new state can be based on the keyframe of the last state
+  shared_ptr<ByteArray> keyframe;
+  uInt32 keyDistance = 0;
+  if(!myStateList.empty())
+  {
+    const RewindState& lastState = *myStateList.last();
+    if(lastState.keyframe && lastState.keyDistance + 1 < KEYFRAME_INTERVAL)
+    {
+      keyframe = lastState.keyframe;
+      keyDistance = lastState.keyDistance + 1;
+    }
+  }
+
   // Add new state at the end of the list (queue adds at end)
   // This updates the 'current' iterator inside the list
   myStateList.addLast();
   RewindState& state = myStateList.current();
-  Serializer& s = state.data;
+  Serializer& s = myScratch;
 
   s.rewind();  // rewind Serializer internal buffers
   if(myStateManager.saveState(s) && myOSystem.console().tia().saveDisplay(s))
   {
+    const uInt32 size = s.size();
+    myStateBuffer.resize(size);
+    s.rewind();
+    s.getByteArray(myStateBuffer.data(), size);
+
+    if(keyframe)
+    {
+      decodeKeyframe(keyframe);
+      encodeDelta(myKeyframeBuffer.data(), uInt32(myKeyframeBuffer.size()),
+                  myStateBuffer.data(), size, myDeltaBuffer);
+
+      // Start a new keyframe when too much has changed since the last one
+      if(myDeltaBuffer.size() > keyframe->size() / 2)
+        keyframe = nullptr;
+    }
+
+    if(keyframe)
+    {
+      state.delta.assign(myDeltaBuffer.begin(), myDeltaBuffer.end());
+      state.keyDistance = keyDistance;
+    }
+    else
+    {
+      keyframe = make_shared<ByteArray>();
+      encodeDelta(nullptr, 0, myStateBuffer.data(), size, *keyframe);
+      state.delta.clear();
+      state.keyDistance = 0;
+
+      // The uncompressed data is still available, no need to decode it again
+      myKeyframe = keyframe;
+      myKeyframeBuffer.swap(myStateBuffer);
+    }
+    // The node may have held a much larger state before
+    if(state.delta.capacity() > state.delta.size() * 2)
+      state.delta.shrink_to_fit();
+
+    state.keyframe = keyframe;
     state.message = message;
     state.cycles = myOSystem.console().tia().cycles();
     myLastTimeMachineAdd = timeMachine;
@@ -156,10 +206,6 @@ uInt32 RewindManager::rewindState(uInt32 numStates)
         // ...except when the last state was added automatically,
         // because that already happened one interval before
         myLastTimeMachineAdd = false;
-
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      s.rewind();  // rewind Serializer internal buffers
     }
     else
       break;
@@ -190,10 +236,6 @@ uInt32 RewindManager::unwindState(uInt32 numStates)
       // Set internal current iterator to nextCycles state (forward in time),
       // since we will now process this state
       myStateList.moveToNext();
-
-      RewindState& state = myStateList.current();
-      Serializer& s = state.data;
-      s.rewind();  // rewind Serializer internal buffers
     }
     else
       break;
@@ -257,8 +299,9 @@ void RewindManager::compressStates()
 string RewindManager::loadState(Int64 startCycles, uInt32 numStates)
 {
   RewindState& state = myStateList.current();
-  Serializer& s = state.data;
+  Serializer& s = myScratch;
 
+  decodeState(state);
   myStateManager.loadState(s);
   myOSystem.console().tia().loadDisplay(s);
 
@@ -275,6 +318,108 @@ string RewindManager::loadState(Int64 startCycles, uInt32 numStates)
   return message.str();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::decodeKeyframe(const shared_ptr<ByteArray>& keyframe)
+{
+  if(keyframe != myKeyframe)
+  {
+    decodeDelta(nullptr, 0, *keyframe, myKeyframeBuffer);
+    myKeyframe = keyframe;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::decodeState(const RewindState& state)
+{
+  decodeKeyframe(state.keyframe);
+
+  const ByteArray* data = &myKeyframeBuffer;
+  if(!state.delta.empty())
+  {
+    decodeDelta(myKeyframeBuffer.data(), uInt32(myKeyframeBuffer.size()),
+                state.delta, myStateBuffer);
+    data = &myStateBuffer;
+  }
+
+  myScratch.rewind();
+  myScratch.putByteArray(data->data(), uInt32(data->size()));
+  myScratch.rewind();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::encodeDelta(const uInt8* base, uInt32 baseSize,
+                                const uInt8* data, uInt32 size, ByteArray& out)
+{
+  // A run of changed bytes is only ended by at least this many unchanged ones
+  constexpr uInt32 MIN_RUN = 4;
+
+  // Stored are the uncompressed size, followed by pairs of the number of
+  // unchanged and changed bytes, the latter followed by the changed bytes
+  // XOR'ed with the base; all numbers are stored using 7 bits per byte
+  const auto putNumber = [&out](uInt32 value) {
+    for(; value >= 0x80; value >>= 7)
+      out.push_back(uInt8(value | 0x80));
+    out.push_back(uInt8(value));
+  };
+  const auto diff = [&](uInt32 i) -> uInt8 {
+    return data[i] ^ (i < baseSize ? base[i] : 0);
+  };
+
+  out.clear();
+  putNumber(size);
+
+  uInt32 i = 0;
+  while(i < size)
+  {
+    uInt32 start = i;
+    while(i < size && diff(i) == 0)
+      ++i;
+    putNumber(i - start);
+
+    start = i;
+    uInt32 unchanged = 0;
+    while(i < size && unchanged < MIN_RUN)
+      unchanged = diff(i++) == 0 ? unchanged + 1 : 0;
+    i -= unchanged;
+
+    putNumber(i - start);
+    for(uInt32 j = start; j < i; ++j)
+      out.push_back(diff(j));
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RewindManager::decodeDelta(const uInt8* base, uInt32 baseSize,
+                                const ByteArray& delta, ByteArray& out)
+{
+  size_t pos = 0;
+  const auto getNumber = [&delta, &pos]() {
+    uInt32 value = 0;
+    for(uInt32 shift = 0; ; shift += 7)
+    {
+      const uInt8 b = delta[pos++];
+      value |= uInt32(b & 0x7f) << shift;
+      if(!(b & 0x80))
+        return value;
+    }
+  };
+  const auto baseByte = [&](uInt32 i) -> uInt8 {
+    return i < baseSize ? base[i] : 0;
+  };
+
+  const uInt32 size = getNumber();
+  out.resize(size);
+
+  uInt32 i = 0;
+  while(i < size)
+  {
+    for(uInt32 n = getNumber(); n > 0; --n, ++i)
+      out[i] = baseByte(i);
+    for(uInt32 n = getNumber(); n > 0; --n, ++i)
+      out[i] = delta[pos++] ^ baseByte(i);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string RewindManager::getUnitString(Int64 cycles)
 {
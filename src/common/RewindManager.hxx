@@ -22,6 +22,7 @@ class OSystem;
 class StateManager;
 
 #include "LinkedObjectPool.hxx"
+#include "Serializer.hxx"
 #include "bspf.hxx"
 
 /**
@@ -34,6 +35,10 @@ class StateManager;
   Unwinding involves moving the internal iterator forwards in time (towards
   the end of the list).
 
+  To save memory, states are stored compressed, and most of them only as the
+  difference to a previous keyframe state.  Since each state keeps a reference
+  to its keyframe, states can be removed in any order.
+
   Any time a new state is added, all states from the current iterator position
   to the end of the list (aka, all future states) are removed, and the internal
   iterator moves to the insertion point of the data (the end of the list).
@@ -151,10 +156,25 @@ class RewindManager
     double myFactor;
     bool   myLastTimeMachineAdd;
 
+    // Scratch space used while saving and loading states
+    Serializer myScratch;
+    ByteArray myStateBuffer, myDeltaBuffer;
+
+    // The most recently used keyframe, in compressed and uncompressed form
+    shared_ptr<ByteArray> myKeyframe;
+    ByteArray myKeyframeBuffer;
+
+    // Every KEYFRAME_INTERVAL states (or whenever the delta grows too big),
+    // a state is stored completely; all others only store the bytes which
+    // differ from that keyframe
+    static constexpr uInt32 KEYFRAME_INTERVAL = 30;
+
     struct RewindState {
-      Serializer data;  // actual save state
-      string message;   // describes save state origin
-      uInt64 cycles;    // cycles since emulation started
+      shared_ptr<ByteArray> keyframe; // compressed keyframe this state is based on
+      ByteArray delta;    // compressed difference to keyframe (empty for keyframes)
+      uInt32 keyDistance; // number of states since keyframe was added
+      string message;     // describes save state origin
+      uInt64 cycles;      // cycles since emulation started
 
       // We do nothing on object instantiation or copy
       // The goal of LinkedObjectPool is to not do any allocations at all
@@ -183,6 +203,42 @@ class RewindManager
     */
     string loadState(Int64 startCycles, uInt32 numStates);
 
+    /**
+      Uncompress the given keyframe into 'myKeyframeBuffer', unless this
+      has already been done.
+    */
+    void decodeKeyframe(const shared_ptr<ByteArray>& keyframe);
+
+    /**
+      Uncompress the given state into the scratch Serializer, so it can be
+      loaded from there.
+    */
+    void decodeState(const RewindState& state);
+
+    /**
+      Store the XOR of 'data' and 'base' in 'out', run-length encoding
+      all unchanged (zero) bytes.  A missing base is treated as all zeros.
+
+      @param base      The data the delta is calculated against
+      @param baseSize  The size of the base data
+      @param data      The data to compress
+      @param size      The size of the data to compress
+      @param out       The buffer receiving the compressed data
+    */
+    static void encodeDelta(const uInt8* base, uInt32 baseSize,
+                            const uInt8* data, uInt32 size, ByteArray& out);
+
+    /**
+      Reverse the operation of 'encodeDelta', using the same base.
+
+      @param base      The data the delta was calculated against
+      @param baseSize  The size of the base data
+      @param delta     The compressed data
+      @param out       The buffer receiving the uncompressed data
+    */
+    static void decodeDelta(const uInt8* base, uInt32 baseSize,
+                            const ByteArray& delta, ByteArray& out);
+
   private:
     // Following constructors and assignment operators not supported
     RewindManager() = delete;
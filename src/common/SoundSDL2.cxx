@@ -19,7 +19,6 @@
 
 #include <sstream>
 #include <cassert>
-#include <cmath>
 
 #include "SDL_lib.hxx"
 #include "TIASnd.hxx"
@@ -30,6 +29,7 @@
 #include "OSystem.hxx"
 #include "Console.hxx"
 #include "SoundSDL2.hxx"
+#include "BenchmarkTimer.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 SoundSDL2::SoundSDL2(OSystem& osystem)
@@ -37,10 +37,13 @@ SoundSDL2::SoundSDL2(OSystem& osystem)
     myIsEnabled(false),
     myIsInitializedFlag(false),
     myLastRegisterSetCycle(0),
+    myDroppedMask(0),
+    myLastProcessedCycle(0),
+    myPlayedClocks(0),
+    myResyncWrites(true),
     myNumChannels(0),
-    myFragmentSizeLogBase2(0),
-    myFragmentSizeLogDiv1(0),
-    myFragmentSizeLogDiv2(0),
+    myTargetBacklog(0),
+    myAverageBacklog(0),
     myIsMuted(true),
     myVolume(100)
 {
@@ -80,12 +83,8 @@ SoundSDL2::SoundSDL2(OSystem& osystem)
     return;
   }
 
-  // Pre-compute fragment-related variables as much as possible
-  myFragmentSizeLogBase2 = log(myHardwareSpec.samples) / log(2.0);
-  myFragmentSizeLogDiv1 = myFragmentSizeLogBase2 / 60.0;
-  myFragmentSizeLogDiv2 = (myFragmentSizeLogBase2 - 1) / 60.0;
-
   myIsInitializedFlag = true;
+  setFrameRate(60.0);
   SDL_PauseAudio(1);
 
   myOSystem.logMessage("SoundSDL2::SoundSDL2 initialized", 2);
@@ -160,6 +159,15 @@ void SoundSDL2::close()
     myLastRegisterSetCycle = 0;
     myTIASound.reset();
     myRegWriteQueue.clear();
+    myDroppedMask = 0;
+    myResyncWrites = true;
+    if(myRegWriteQueue.overflows() > 0)
+    {
+      ostringstream buf;
+      buf << "SoundSDL2: " << myRegWriteQueue.overflows()
+          << " register writes didn't fit into the queue";
+      myOSystem.logMessage(buf.str(), 2);
+    }
     myOSystem.logMessage("SoundSDL2::close", 2);
   }
 }
@@ -183,6 +191,8 @@ void SoundSDL2::reset()
     myLastRegisterSetCycle = 0;
     myTIASound.reset();
     myRegWriteQueue.clear();
+    myDroppedMask = 0;
+    myResyncWrites = true;
     mute(myIsMuted);
   }
 }
@@ -236,111 +246,140 @@ void SoundSDL2::setChannels(uInt32 channels)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL2::setFrameRate(float framerate)
 {
-  // Recalculate since frame rate has changed
-  // FIXME - should we clear out the queue or adjust the values in it?
-  myFragmentSizeLogDiv1 = myFragmentSizeLogBase2 / framerate;
-  myFragmentSizeLogDiv2 = (myFragmentSizeLogBase2 - 1) / framerate;
+  if(!myIsInitializedFlag)
+    return;
+
+  // The emulation creates the register writes for a whole frame at once,
+  // and the audio thread needs them in time for a whole fragment; so aim
+  // for about that many audio clocks being queued
+  myTargetBacklog = TIASound::CLOCK_FREQUENCY / framerate +
+      double(myHardwareSpec.samples) * TIASound::CLOCK_FREQUENCY / myHardwareSpec.freq;
+  myAverageBacklog = myTargetBacklog;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL2::set(uInt16 addr, uInt8 value, uInt64 cycle)
 {
-  SDL_LockAudio();
+  // This is called from the emulation thread, while the audio thread
+  // concurrently processes the queue; no locking is required, since
+  // the queue is only ever modified at its tail here
 
-  // First, calculate how many seconds would have past since the last
-  // register write on a real 2600
-  double delta = double(cycle - myLastRegisterSetCycle) / 1193191.66666667;
+  // Retry any writes which previously didn't fit into the queue
+  for(uInt32 i = 0; myDroppedMask && i < 6; ++i)
+    if((myDroppedMask & (1 << i)) &&
+        myRegWriteQueue.enqueue(TIARegister::AUDC0 + i, myDroppedValues[i], cycle))
+      myDroppedMask &= ~(1 << i);
 
-  // Now, adjust the time based on the frame rate the user has selected. For
-  // the sound to "scale" correctly, we have to know the games real frame
-  // rate (e.g., 50 or 60) and the currently emulated frame rate. We use these
-  // values to "scale" the time before the register change occurs.
-  myRegWriteQueue.enqueue(addr, value, delta);
+  if(!myRegWriteQueue.enqueue(addr, value, cycle))
+  {
+    const uInt32 i = addr - TIARegister::AUDC0;
+    if(i < 6)
+    {
+      myDroppedValues[i] = value;
+      myDroppedMask |= 1 << i;
+    }
+  }
 
   // Update last cycle counter to the current cycle
   myLastRegisterSetCycle = cycle;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 SoundSDL2::writeDelay(const RegWrite& info)
+{
+  if(myResyncWrites)
+  {
+    myLastProcessedCycle = info.cycle;
+    myPlayedClocks = 0;
+    myResyncWrites = false;
+  }
 
-  SDL_UnlockAudio();
+  // Register writes take effect with the next audio clock
+  const uInt64 clock = info.cycle / TIASound::CYCLES_PER_CLOCK,
+               last  = myLastProcessedCycle / TIASound::CYCLES_PER_CLOCK + myPlayedClocks;
+
+  return clock > last ? uInt32(std::min(clock - last, uInt64(0xffffffff))) : 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL2::processFragment(Int16* stream, uInt32 length)
+void SoundSDL2::applyWrite(const RegWrite& info)
 {
-  uInt32 channels = myHardwareSpec.channels;
-  length = length / channels;
+  myTIASound.set(info.addr, info.value);
+  myLastProcessedCycle = info.cycle;
+  myPlayedClocks = 0;
+  myRegWriteQueue.dequeue();
+}
 
-  // If there are excessive items on the queue then we'll remove some
-  if(myRegWriteQueue.duration() > myFragmentSizeLogDiv1)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::adjustPlaybackRate()
+{
+  const RegWrite* info = myRegWriteQueue.front();
+  if(info == nullptr)
+    return;
+
+  const uInt64 lastClock = myRegWriteQueue.back().cycle / TIASound::CYCLES_PER_CLOCK;
+  double backlog = writeDelay(*info) +
+      double(lastClock - info->cycle / TIASound::CYCLES_PER_CLOCK);
+
+  // If far too much is queued (e.g. after the audio thread was stalled),
+  // apply the oldest writes immediately, instead of slowly catching up
+  if(backlog > myTargetBacklog * 4)
   {
-    double removed = 0.0;
-    while(removed < myFragmentSizeLogDiv2)
+    while(info && lastClock - info->cycle / TIASound::CYCLES_PER_CLOCK > myTargetBacklog)
     {
-      RegWrite& info = myRegWriteQueue.front();
-      removed += info.delta;
-      myTIASound.set(info.addr, info.value);
-      myRegWriteQueue.dequeue();
+      applyWrite(*info);
+      info = myRegWriteQueue.front();
     }
+    backlog = myAverageBacklog = myTargetBacklog;
   }
 
-  double position = 0.0;
-  double remaining = length;
+  // Play up to 0.5% faster or slower, depending on the average backlog;
+  // this isn't audible, but compensates for the emulation running at a
+  // slightly different speed than the sound device
+  myAverageBacklog = myAverageBacklog * 0.95 + backlog * 0.05;
+  const double error = BSPF::clamp((myAverageBacklog - myTargetBacklog) / myTargetBacklog,
+                                   -1.0, 1.0);
+  myTIASound.playbackRate(1.0 + error * 0.005);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundSDL2::processFragment(Int16* stream, uInt32 length)
+{
+  BenchmarkTimer::Scope timer(BenchmarkTimer::Audio);
+
+  uInt32 channels = myHardwareSpec.channels;
+  length = length / channels;
 
-  while(remaining > 0.0)
+  adjustPlaybackRate();
+
+  while(length > 0)
   {
-    if(myRegWriteQueue.size() == 0)
+    // Run the sound emulation up to the point of the next register update;
+    // if there are none pending, the current settings are used to finish
+    // filling the sound fragment
+    const RegWrite* info = myRegWriteQueue.front();
+    const uInt32 delay = info ? writeDelay(*info) : ~0u;
+    uInt32 clocks = delay;
+
+    const uInt32 generated = myTIASound.process(stream, length, clocks);
+    stream += generated * channels;
+    length -= generated;
+
+    if(info == nullptr)
     {
-      // There are no more pending TIA sound register updates so we'll
-      // use the current settings to finish filling the sound fragment
-      myTIASound.process(stream + (uInt32(position) * channels),
-          length - uInt32(position));
-
-      // Since we had to fill the fragment we'll reset the cycle counter
-      // to zero.  NOTE: This isn't 100% correct, however, it'll do for
-      // now.  We should really remember the overrun and remove it from
-      // the delta of the next write.
-      myLastRegisterSetCycle = 0;
+      // Since we ran out of register updates, the next one is applied as
+      // soon as it arrives.  NOTE: This isn't 100% correct, however, it'll
+      // do for now.  We should really remember the overrun and remove it
+      // from the delay of the next write.
+      myResyncWrites = true;
       break;
     }
-    else
-    {
-      // There are pending TIA sound register updates so we need to
-      // update the sound buffer to the point of the next register update
-      RegWrite& info = myRegWriteQueue.front();
-
-      // How long will the remaining samples in the fragment take to play
-      double duration = remaining / myHardwareSpec.freq;
-
-      // Does the register update occur before the end of the fragment?
-      if(info.delta <= duration)
-      {
-        // If the register update time hasn't already passed then
-        // process samples upto the point where it should occur
-        if(info.delta > 0.0)
-        {
-          // Process the fragment upto the next TIA register write.  We
-          // round the count passed to process up if needed.
-          double samples = (myHardwareSpec.freq * info.delta);
-          myTIASound.process(stream + (uInt32(position) * channels),
-              uInt32(samples) + uInt32(position + samples) -
-              (uInt32(position) + uInt32(samples)));
-
-          position += samples;
-          remaining -= samples;
-        }
-        myTIASound.set(info.addr, info.value);
-        myRegWriteQueue.dequeue();
-      }
-      else
-      {
-        // The next register update occurs in the next fragment so finish
-        // this fragment with the current TIA settings and reduce the register
-        // update delay by the corresponding amount of time
-        myTIASound.process(stream + (uInt32(position) * channels),
-            length - uInt32(position));
-        info.delta -= duration;
-        break;
-      }
-    }
+
+    // Either the register update is due now, or it occurs in the next
+    // fragment, and the corresponding amount of time has already passed
+    myPlayedClocks += delay - clocks;
+    if(clocks == 0)
+      applyWrite(*info);
   }
 }
 
@@ -405,6 +444,8 @@ bool SoundSDL2::load(Serializer& in)
     {
       SDL_PauseAudio(1);
       myRegWriteQueue.clear();
+      myDroppedMask = 0;
+      myResyncWrites = true;
       myTIASound.set(TIARegister::AUDC0, in.getByte());
       myTIASound.set(TIARegister::AUDC1, in.getByte());
       myTIASound.set(TIARegister::AUDF0, in.getByte());
@@ -429,83 +470,71 @@ bool SoundSDL2::load(Serializer& in)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-SoundSDL2::RegWriteQueue::RegWriteQueue(uInt32 capacity)
-  : myBuffer(make_unique<RegWrite[]>(capacity)),
-    myCapacity(capacity),
-    mySize(0),
-    myHead(0),
-    myTail(0)
+SoundSDL2::RegWriteQueue::RegWriteQueue()
+  : myHead(0),
+    myTail(0),
+    myOverflows(0)
 {
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL2::RegWriteQueue::clear()
 {
-  myHead = myTail = mySize = 0;
+  myHead.store(0);
+  myTail.store(0);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SoundSDL2::RegWriteQueue::dequeue()
 {
-  if(mySize > 0)
-  {
-    myHead = (myHead + 1) % myCapacity;
-    --mySize;
-  }
+  const uInt32 head = myHead.load(std::memory_order_relaxed);
+  if(head != myTail.load(std::memory_order_acquire))
+    myHead.store(head + 1, std::memory_order_release);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-double SoundSDL2::RegWriteQueue::duration() const
+bool SoundSDL2::RegWriteQueue::enqueue(uInt16 addr, uInt8 value, uInt64 cycle)
 {
-  double duration = 0.0;
-  for(uInt32 i = 0; i < mySize; ++i)
+  const uInt32 tail = myTail.load(std::memory_order_relaxed);
+  if(tail - myHead.load(std::memory_order_acquire) == CAPACITY)
   {
-    duration += myBuffer[(myHead + i) % myCapacity].delta;
+    ++myOverflows;
+    return false;
   }
-  return duration;
-}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL2::RegWriteQueue::enqueue(uInt16 addr, uInt8 value, double delta)
-{
-  // If an attempt is made to enqueue more than the queue can hold then
-  // we'll enlarge the queue's capacity.
-  if(mySize == myCapacity)
-    grow();
-
-  RegWrite& reg = myBuffer[myTail];
+  // The slot is only made visible to the audio thread after it is filled
+  RegWrite& reg = myBuffer[tail & (CAPACITY - 1)];
+  reg.cycle = cycle;
   reg.addr  = addr;
   reg.value = value;
-  reg.delta = delta;
-  myTail = (myTail + 1) % myCapacity;
-  ++mySize;
+  myTail.store(tail + 1, std::memory_order_release);
+
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-SoundSDL2::RegWrite& SoundSDL2::RegWriteQueue::front() const
+const SoundSDL2::RegWrite* SoundSDL2::RegWriteQueue::front() const
 {
-  assert(mySize != 0);
-  return myBuffer[myHead];
+  const uInt32 head = myHead.load(std::memory_order_relaxed);
+  if(head == myTail.load(std::memory_order_acquire))
+    return nullptr;
+
+  return &myBuffer[head & (CAPACITY - 1)];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-uInt32 SoundSDL2::RegWriteQueue::size() const
+const SoundSDL2::RegWrite& SoundSDL2::RegWriteQueue::back() const
 {
-  return mySize;
+  const uInt32 tail = myTail.load(std::memory_order_acquire);
+  assert(tail != myHead.load(std::memory_order_relaxed));
+  return myBuffer[(tail - 1) & (CAPACITY - 1)];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void SoundSDL2::RegWriteQueue::grow()
+uInt32 SoundSDL2::RegWriteQueue::size() const
 {
-  unique_ptr<RegWrite[]> buffer = make_unique<RegWrite[]>(myCapacity*2);
-  for(uInt32 i = 0; i < mySize; ++i)
-    buffer[i] = myBuffer[(myHead + i) % myCapacity];
-
-  myHead = 0;
-  myTail = mySize;
-  myCapacity *= 2;
-
-  myBuffer = std::move(buffer);
+  return myTail.load(std::memory_order_acquire) -
+         myHead.load(std::memory_order_acquire);
 }
 
 #endif  // SOUND_SUPPORT
@@ -24,6 +24,8 @@ class OSystem;
 
 #include "SDL_lib.hxx"
 
+#include <atomic>
+
 #include "bspf.hxx"
 #include "TIASnd.hxx"
 #include "Sound.hxx"
@@ -163,55 +165,60 @@ class SoundSDL2 : public Sound
     // Struct to hold information regarding a TIA sound register write
     struct RegWrite
     {
+      uInt64 cycle;
       uInt16 addr;
       uInt8 value;
-      double delta;
-
-      RegWrite(uInt16 a = 0, uInt8 v = 0, double d = 0.0)
-        : addr(a), value(v), delta(d) { }
     };
 
     /**
-      A queue class used to hold TIA sound register writes before being
-      processed while creating a sound fragment.
+      A fixed-size ring buffer used to hold TIA sound register writes before
+      being processed while creating a sound fragment.
+
+      Writes are added by the emulation thread only, and removed by the
+      SDL audio thread only.  Since each side only ever modifies its own
+      index, no locking is required.  The indices are kept in separate
+      cache lines, so the threads don't slow each other down.
+
+      If the queue is full, writes are rejected and counted as overflows;
+      it is never resized, since that would require allocating memory while
+      the audio thread may access the queue.
     */
     class RegWriteQueue
     {
       public:
-        /**
-          Create a new queue instance with the specified initial
-          capacity.  If the queue ever reaches its capacity then it will
-          automatically increase its size.
-        */
-        RegWriteQueue(uInt32 capacity = 512);
+        RegWriteQueue();
 
       public:
         /**
-          Clear any items stored in the queue.
+          Clear any items stored in the queue.  This must only be called
+          while the audio thread is paused.
         */
         void clear();
 
         /**
-          Dequeue the first object in the queue.
+          Dequeue the first object in the queue (audio thread only).
         */
         void dequeue();
 
         /**
-          Return the duration of all the items in the queue.
+          Enqueue the specified object (emulation thread only).
+
+          @return  False if the queue was full and the write was dropped
         */
-        double duration() const;
+        bool enqueue(uInt16 addr, uInt8 value, uInt64 cycle);
 
         /**
-          Enqueue the specified object.
+          Return the item at the front of the queue (audio thread only).
+
+          @return  The item at the front of the queue, or nullptr if empty
         */
-        void enqueue(uInt16 addr, uInt8 value, double delta);
+        const RegWrite* front() const;
 
         /**
-          Return the item at the front on the queue.
-
-          @return  The item at the front of the queue.
+          Return the item most recently added to the queue (audio thread
+          only).  The queue must not be empty.
         */
-        RegWrite& front() const;
+        const RegWrite& back() const;
 
         /**
           Answers the number of items currently in the queue.
@@ -220,16 +227,28 @@ class SoundSDL2 : public Sound
         */
         uInt32 size() const;
 
-      private:
-        // Increase the size of the queue
-        void grow();
+        /**
+          Answers the number of writes which had to be dropped, since the
+          queue was full.
+        */
+        uInt32 overflows() const { return myOverflows; }
 
       private:
-        unique_ptr<RegWrite[]> myBuffer;
-        uInt32 myCapacity;
-        uInt32 mySize;
-        uInt32 myHead;
-        uInt32 myTail;
+        // Must be a power of two
+        static constexpr uInt32 CAPACITY = 4096;
+        static constexpr uInt32 CACHE_LINE = 64;
+
+        RegWrite myBuffer[CAPACITY];
+
+        // Index of the next item to dequeue; only modified by the audio thread
+        char myPad1[CACHE_LINE];
+        std::atomic<uInt32> myHead;
+
+        // Index of the next item to enqueue; only modified by the emulation thread
+        char myPad2[CACHE_LINE - sizeof(std::atomic<uInt32>)];
+        std::atomic<uInt32> myTail;
+        uInt32 myOverflows;
+        char myPad3[CACHE_LINE - sizeof(std::atomic<uInt32>) - sizeof(uInt32)];
 
       private:
         // Following constructors and assignment operators not supported
@@ -239,6 +258,27 @@ class SoundSDL2 : public Sound
         RegWriteQueue& operator=(RegWriteQueue&&) = delete;
     };
 
+    /**
+      Answers the number of audio clocks until the given write, which must
+      be at the front of the queue, is to be applied.  Only used by the
+      audio thread.
+    */
+    uInt32 writeDelay(const RegWrite& info);
+
+    /**
+      Apply the given write, which must be at the front of the queue, to the
+      sound emulation, and remove it from the queue.  Only used by the
+      audio thread.
+    */
+    void applyWrite(const RegWrite& info);
+
+    /**
+      Adjust the playback rate according to the number of queued audio
+      clocks, so that the audio thread neither runs out of register writes
+      nor falls behind the emulation.  Only used by the audio thread.
+    */
+    void adjustPlaybackRate();
+
   private:
     // TIASound emulation object
     TIASound myTIASound;
@@ -252,17 +292,26 @@ class SoundSDL2 : public Sound
     // Indicates the cycle when a sound register was last set
     uInt64 myLastRegisterSetCycle;
 
+    // Writes which didn't fit into the queue; these are retried with the
+    // next write, so the sound registers end up with the correct values
+    uInt8 myDroppedValues[6];
+    uInt8 myDroppedMask;
+
+    // The cycle of the last write applied by the audio thread, and the
+    // number of audio clocks of the next write's delay already played
+    uInt64 myLastProcessedCycle;
+    uInt32 myPlayedClocks;
+
+    // Set when the queue ran empty; the next write is then applied
+    // immediately, instead of waiting for its delay to pass
+    bool myResyncWrites;
+
     // Indicates the number of channels (mono or stereo)
     uInt32 myNumChannels;
 
-    // Log base 2 of the selected fragment size
-    double myFragmentSizeLogBase2;
-
-    // The myFragmentSizeLogBase2 variable is used in only two places,
-    // both of which involve an expensive division in the sound
-    // processing callback
-    // These are pre-computed to speed up the callback as much as possible
-    double myFragmentSizeLogDiv1, myFragmentSizeLogDiv2;
+    // The number of audio clocks which should be queued when a fragment
+    // is requested, and the (smoothed) number actually queued
+    double myTargetBacklog, myAverageBacklog;
 
     // Indicates if the sound is currently muted
     bool myIsMuted;
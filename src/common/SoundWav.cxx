@@ -0,0 +1,220 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "OSystem.hxx"
+#include "Serializer.hxx"
+#include "Settings.hxx"
+#include "TIAConstants.hxx"
+#include "SoundWav.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundWav::SoundWav(OSystem& osystem)
+  : Sound(osystem),
+    myLastClock(0),
+    myNumChannels(1),
+    myFrequency(osystem.settings().getInt("freq")),
+    myDataSize(0)
+{
+  myTIASound.outputFrequency(myFrequency);
+  open();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SoundWav::~SoundWav()
+{
+  if(myFile.is_open())
+    closeFile(myLastClock * TIASound::CYCLES_PER_CLOCK);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundWav::openFile(const string& filename, uInt64 cycle)
+{
+  if(myFile.is_open())
+    closeFile(myLastClock * TIASound::CYCLES_PER_CLOCK);
+
+  myFile.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!myFile.is_open())
+    return false;
+
+  // The header is written again with the correct sizes once the file
+  // is complete
+  myDataSize = 0;
+  writeHeader();
+  myLastClock = cycle / TIASound::CYCLES_PER_CLOCK;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWav::closeFile(uInt64 cycle)
+{
+  if(!myFile.is_open())
+    return;
+
+  render(cycle);
+  writeHeader();
+  myFile.close();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWav::setChannels(uInt32 channels)
+{
+  if(channels == 1 || channels == 2)
+    myNumChannels = channels;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWav::open()
+{
+  // The file has as many channels as the ROM uses
+  myTIASound.channels(myNumChannels, myNumChannels == 2);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWav::reset()
+{
+  myTIASound.reset();
+
+  // This is called from System::reset(), which restarts the system cycles
+  // at zero; otherwise nothing would be rendered until they caught up
+  myLastClock = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWav::set(uInt16 addr, uInt8 value, uInt64 cycle)
+{
+  render(cycle);
+  myTIASound.set(addr, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWav::render(uInt64 cycle)
+{
+  const uInt64 clock = cycle / TIASound::CYCLES_PER_CLOCK;
+  if(clock <= myLastClock)
+    return;
+
+  uInt64 clocks = clock - myLastClock;
+  myLastClock = clock;
+  if(!myFile.is_open())
+    return;
+
+  while(clocks > 0)
+  {
+    uInt32 step = uInt32(std::min(clocks, uInt64(0x10000)));
+    clocks -= step;
+
+    while(step > 0)
+    {
+      const uInt32 samples = myTIASound.process(myBuffer, BUFFER_SAMPLES, step);
+      const uInt32 values = samples * myNumChannels;
+
+      // WAV files are always little-endian
+      for(uInt32 i = 0; i < values; ++i)
+      {
+        myBytes[i * 2]     = uInt8(myBuffer[i]);
+        myBytes[i * 2 + 1] = uInt8(uInt16(myBuffer[i]) >> 8);
+      }
+      myFile.write(reinterpret_cast<const char*>(myBytes), values * 2);
+      myDataSize += values * 2;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundWav::writeHeader()
+{
+  uInt8 header[44];
+  const auto put32 = [&header](uInt32 pos, uInt32 value) {
+    for(uInt32 i = 0; i < 4; ++i)
+      header[pos + i] = uInt8(value >> (i * 8));
+  };
+  const auto put16 = [&header](uInt32 pos, uInt16 value) {
+    header[pos]     = uInt8(value);
+    header[pos + 1] = uInt8(value >> 8);
+  };
+
+  memcpy(header, "RIFF", 4);
+  put32(4, 36 + myDataSize);
+  memcpy(header + 8, "WAVEfmt ", 8);
+  put32(16, 16);                                // size of format chunk
+  put16(20, 1);                                 // PCM
+  put16(22, myNumChannels);
+  put32(24, myFrequency);
+  put32(28, myFrequency * myNumChannels * 2);   // bytes per second
+  put16(32, myNumChannels * 2);                 // bytes per sample
+  put16(34, 16);                                // bits per value
+  memcpy(header + 36, "data", 4);
+  put32(40, myDataSize);
+
+  const std::streampos pos = myFile.tellp();
+  myFile.seekp(0);
+  myFile.write(reinterpret_cast<const char*>(header), 44);
+  if(pos > 44)
+    myFile.seekp(pos);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundWav::save(Serializer& out) const
+{
+  try
+  {
+    out.putString(name());
+
+    out.putByte(myTIASound.get(TIARegister::AUDC0));
+    out.putByte(myTIASound.get(TIARegister::AUDC1));
+    out.putByte(myTIASound.get(TIARegister::AUDF0));
+    out.putByte(myTIASound.get(TIARegister::AUDF1));
+    out.putByte(myTIASound.get(TIARegister::AUDV0));
+    out.putByte(myTIASound.get(TIARegister::AUDV1));
+
+    out.putLong(myLastClock * TIASound::CYCLES_PER_CLOCK);
+  }
+  catch(...)
+  {
+    myOSystem.logMessage("ERROR: SoundWav::save", 0);
+    return false;
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundWav::load(Serializer& in)
+{
+  try
+  {
+    if(in.getString() != name())
+      return false;
+
+    myTIASound.set(TIARegister::AUDC0, in.getByte());
+    myTIASound.set(TIARegister::AUDC1, in.getByte());
+    myTIASound.set(TIARegister::AUDF0, in.getByte());
+    myTIASound.set(TIARegister::AUDF1, in.getByte());
+    myTIASound.set(TIARegister::AUDV0, in.getByte());
+    myTIASound.set(TIARegister::AUDV1, in.getByte());
+
+    myLastClock = in.getLong() / TIASound::CYCLES_PER_CLOCK;
+  }
+  catch(...)
+  {
+    myOSystem.logMessage("ERROR: SoundWav::load", 0);
+    return false;
+  }
+
+  return true;
+}
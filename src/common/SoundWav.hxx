@@ -0,0 +1,163 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef SOUND_WAV_HXX
+#define SOUND_WAV_HXX
+
+class OSystem;
+
+#include <fstream>
+
+#include "bspf.hxx"
+#include "TIASnd.hxx"
+#include "Sound.hxx"
+
+/**
+  This class implements a sound object which renders the TIA sound output
+  into WAV files instead of playing it.  The sound emulation is driven
+  entirely by the cycle at which each register write happens, so the
+  output is produced as fast as the emulation runs, and is identical for
+  every run of a ROM.
+
+  It is used in headless mode, where the sound of each ROM can be recorded
+  for regression testing.
+
+  @author Stephen Anthony
+*/
+class SoundWav : public Sound
+{
+  public:
+    /**
+      Create a new sound object.  No file is written until 'openFile'
+      is called.
+    */
+    SoundWav(OSystem& osystem);
+    virtual ~SoundWav();
+
+  public:
+    /**
+      Start writing the sound output to the given file, beginning at the
+      given system cycle.  Any previously opened file is closed first.
+
+      @param filename  The name of the WAV file to create
+      @param cycle     The current system cycle
+
+      @return  False if the file couldn't be created
+    */
+    bool openFile(const string& filename, uInt64 cycle);
+
+    /**
+      Render the sound output up to the given system cycle, and complete
+      the current WAV file.
+
+      @param cycle  The current system cycle
+    */
+    void closeFile(uInt64 cycle);
+
+  public:
+    // Volume, muting and the frame rate don't apply when writing to a file
+    void setEnabled(bool state) override { }
+    void setChannels(uInt32 channels) override;
+    void setFrameRate(float framerate) override { }
+    void open() override;
+    void close() override { }
+    void mute(bool state) override { }
+    void reset() override;
+
+    /**
+      Sets the sound register to a given value, after rendering the sound
+      output up to the given cycle.
+
+      @param addr   The register address
+      @param value  The value to save into the register
+      @param cycle  The system cycle at which the register is being updated
+    */
+    void set(uInt16 addr, uInt8 value, uInt64 cycle) override;
+
+    void setVolume(Int32 percent) override { }
+    void adjustVolume(Int8 direction) override { }
+
+  public:
+    /**
+      Saves the current state of this device to the given Serializer.
+
+      @param out  The serializer device to save to.
+      @return  The result of the save.  True on success, false on failure.
+    */
+    bool save(Serializer& out) const override;
+
+    /**
+      Loads the current state of this device from the given Serializer.
+
+      @param in  The Serializer device to load from.
+      @return  The result of the load.  True on success, false on failure.
+    */
+    bool load(Serializer& in) override;
+
+    /**
+      Get a descriptor for this console class (used in error checking).
+
+      @return  The name of the object
+    */
+    string name() const override { return "TIASound"; }
+
+  private:
+    /**
+      Run the sound emulation up to the given cycle, and write the
+      resulting samples to the file (if one is open).
+    */
+    void render(uInt64 cycle);
+
+    /**
+      Write the WAV header, with sizes according to the data written so far.
+    */
+    void writeHeader();
+
+  private:
+    // TIASound emulation object
+    TIASound myTIASound;
+
+    // The file currently written to
+    std::ofstream myFile;
+
+    // The last audio clock the sound output was rendered up to
+    uInt64 myLastClock;
+
+    // Indicates the number of channels (mono or stereo)
+    uInt32 myNumChannels;
+
+    // The output frequency, taken from the 'freq' setting
+    uInt32 myFrequency;
+
+    // The number of bytes of sample data written to the current file
+    uInt32 myDataSize;
+
+    // Buffer for rendered samples, before they are written to the file
+    static constexpr uInt32 BUFFER_SAMPLES = 4096;
+    Int16 myBuffer[BUFFER_SAMPLES * 2];
+    uInt8 myBytes[BUFFER_SAMPLES * 4];
+
+  private:
+    // Following constructors and assignment operators not supported
+    SoundWav() = delete;
+    SoundWav(const SoundWav&) = delete;
+    SoundWav(SoundWav&&) = delete;
+    SoundWav& operator=(const SoundWav&) = delete;
+    SoundWav& operator=(SoundWav&&) = delete;
+};
+
+#endif
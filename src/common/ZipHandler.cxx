@@ -19,22 +19,17 @@
 #include <cstdlib>
 #include <zlib.h>
 
-#include "ZipHandler.hxx"
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ZipHandler::ZipHandler()
-  : myZip(nullptr)
-{
-  for(int cachenum = 0; cachenum < ZIP_CACHE_SIZE; ++cachenum)
-    myZipCache[cachenum] = nullptr;
-}
+#if defined(BSPF_UNIX) || defined(BSPF_MAC_OSX)
+  #include <fcntl.h>
+  #include <unistd.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+#elif defined(BSPF_WINDOWS)
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+#endif
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ZipHandler::~ZipHandler()
-{
-  zip_file_cache_clear();
-  free_zip_file(myZip);
-}
+#include "ZipHandler.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ZipHandler::open(const string& filename)
@@ -44,7 +39,7 @@ void ZipHandler::open(const string& filename)
     zip_file_close(myZip);
 
   // And open a new one
-  zip_file_open(filename.c_str(), &myZip);
+  zip_file_open(filename, myZip);
   reset();
 }
 
@@ -59,31 +54,36 @@ void ZipHandler::reset()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ZipHandler::hasNext()
 {
-  return myZip && (myZip->cd_pos < myZip->ecd.cd_size);
+  return myZip && (myZip->cd_pos < myZip->headers.size());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string ZipHandler::next()
 {
-  if(myZip)
+  if(hasNext())
   {
-    bool valid = false;
-    const zip_file_header* header = nullptr;
-    do {
-      header = zip_file_next_file(myZip);
-
-      // Ignore zero-length files and '__MACOSX' virtual directories
-      valid = header && (header->uncompressed_length > 0) &&
-              !BSPF::startsWithIgnoreCase(header->filename, "__MACOSX");
-    }
-    while(!valid && myZip->cd_pos < myZip->ecd.cd_size);
-
-    return valid ? header->filename : EmptyString;
+    myZip->header = &myZip->headers[myZip->cd_pos++];
+    return myZip->header->filename;
   }
   else
     return EmptyString;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ZipHandler::find(const string& filename)
+{
+  if(myZip)
+  {
+    const auto& iter = myZip->index.find(filename);
+    if(iter != myZip->index.end())
+    {
+      myZip->header = &myZip->headers[iter->second];
+      return true;
+    }
+  }
+  return false;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 ZipHandler::decompress(BytePtr& image)
 {
@@ -99,12 +99,12 @@ uInt32 ZipHandler::decompress(BytePtr& image)
     "ZIPERR_BUFFER_TOO_SMALL"
   };
 
-  if(myZip)
+  if(myZip && myZip->header)
   {
-    uInt32 length = myZip->header.uncompressed_length;
+    uInt32 length = myZip->header->uncompressed_length;
     image = make_unique<uInt8[]>(length);
 
-    ZipHandler::zip_error err = zip_file_decompress(myZip, image.get(), length);
+    ZipHandler::zip_error err = zip_file_decompress(myZip.get(), image.get(), length);
     if(err == ZIPERR_NONE)
       return length;
     else
@@ -119,55 +119,125 @@ uInt32 ZipHandler::decompress(BytePtr& image)
     file access functions
 -------------------------------------------------*/
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ZipHandler::stream_open(const char* filename, fstream** stream,
-                             uInt64& length)
+bool ZipHandler::file_stats(const string& filename, uInt64& length,
+                            uInt64& modtime)
 {
-  fstream* in = new fstream(filename, fstream::in | fstream::binary);
-  if(!in || !in->is_open())
-  {
-    *stream = nullptr;
-    length = 0;
+#if defined(BSPF_UNIX) || defined(BSPF_MAC_OSX)
+  struct stat st;
+  if(stat(filename.c_str(), &st) != 0)
     return false;
-  }
-  else
-  {
-    in->exceptions( std::ios_base::failbit | std::ios_base::badbit | std::ios_base::eofbit );
-    *stream = in;
-    in->seekg(0, std::ios::end);
-    length = in->tellg();
-    in->seekg(0, std::ios::beg);
-    return true;
-  }
+
+  length = st.st_size;
+  modtime = st.st_mtime;
+  return true;
+#elif defined(BSPF_WINDOWS)
+  WIN32_FILE_ATTRIBUTE_DATA attr;
+  if(!GetFileAttributesExA(filename.c_str(), GetFileExInfoStandard, &attr))
+    return false;
+
+  length  = (uInt64(attr.nFileSizeHigh) << 32) | attr.nFileSizeLow;
+  modtime = (uInt64(attr.ftLastWriteTime.dwHighDateTime) << 32) |
+            attr.ftLastWriteTime.dwLowDateTime;
+  return true;
+#else
+  ifstream in(filename, std::ios::binary | std::ios::ate);
+  if(!in.is_open())
+    return false;
+
+  length = in.tellg();
+  modtime = 0;
+  return true;
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ZipHandler::stream_close(fstream** stream)
+bool ZipHandler::map_file(zip_file& zip)
 {
-  if(*stream)
+#if defined(BSPF_UNIX) || defined(BSPF_MAC_OSX)
+  int fd = ::open(zip.filename.c_str(), O_RDONLY);
+  if(fd < 0)
+    return false;
+
+  // The mapping stays valid after the file is closed
+  struct stat st;
+  void* data = MAP_FAILED;
+  if(fstat(fd, &st) == 0 && st.st_size > 0)
   {
-    if((*stream)->is_open())
-      (*stream)->close();
-    delete *stream;
-    *stream = nullptr;
+    zip.length = st.st_size;
+    zip.modtime = st.st_mtime;
+    data = mmap(nullptr, zip.length, PROT_READ, MAP_PRIVATE, fd, 0);
   }
-}
+  close(fd);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool ZipHandler::stream_read(fstream* stream, void* buffer, uInt64 offset,
-                             uInt32 length, uInt32& actual)
-{
-  try
-  {
-    stream->seekg(offset);
-    stream->read((char*)buffer, length);
+  if(data == MAP_FAILED)
+    return false;
 
-    actual = (uInt32)stream->gcount();
-    return true;
-  }
-  catch(...)
-  {
+  zip.data = static_cast<const uInt8*>(data);
+  return true;
+#elif defined(BSPF_WINDOWS)
+  HANDLE file = CreateFileA(zip.filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if(file == INVALID_HANDLE_VALUE)
     return false;
+
+  // The view keeps the mapping (and the file) open after the handles
+  // are closed
+  LARGE_INTEGER size;
+  FILETIME modtime;
+  HANDLE mapping = nullptr;
+  if(GetFileSizeEx(file, &size) && GetFileTime(file, nullptr, nullptr, &modtime) &&
+     size.QuadPart > 0)
+  {
+    zip.length = size.QuadPart;
+    zip.modtime = (uInt64(modtime.dwHighDateTime) << 32) | modtime.dwLowDateTime;
+    mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
   }
+  CloseHandle(file);
+  if(mapping == nullptr)
+    return false;
+
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mapping);
+  if(data == nullptr)
+    return false;
+
+  zip.data = static_cast<const uInt8*>(data);
+  return true;
+#else
+  // Without memory-mapping, read the whole file at once
+  ifstream in(zip.filename, std::ios::binary | std::ios::ate);
+  if(!in.is_open())
+    return false;
+
+  zip.length = in.tellg();
+  zip.modtime = 0;
+  if(zip.length == 0)
+    return false;
+
+  zip.buffer = make_unique<uInt8[]>(zip.length);
+  in.seekg(0, std::ios::beg);
+  if(!in.read(reinterpret_cast<char*>(zip.buffer.get()), zip.length))
+    return false;
+
+  zip.data = zip.buffer.get();
+  return true;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ZipHandler::unmap_file(zip_file& zip)
+{
+  if(zip.data == nullptr)
+    return;
+
+#if defined(BSPF_UNIX) || defined(BSPF_MAC_OSX)
+  munmap(const_cast<uInt8*>(zip.data), zip.length);
+#elif defined(BSPF_WINDOWS)
+  UnmapViewOfFile(zip.data);
+#else
+  zip.buffer.reset();
+#endif
+  zip.data = nullptr;
 }
 
 
@@ -176,104 +246,61 @@ bool ZipHandler::stream_read(fstream* stream, void* buffer, uInt64 offset,
 /*-------------------------------------------------
     zip_file_open - opens a ZIP file for reading
 -------------------------------------------------*/
-ZipHandler::zip_error ZipHandler::zip_file_open(const char* filename, zip_file** zip)
+ZipHandler::zip_error ZipHandler::zip_file_open(const string& filename,
+                                                unique_ptr<zip_file>& zip)
 {
   zip_error ziperr = ZIPERR_NONE;
-  uInt32 read_length;
-  zip_file* newzip;
-  char* string;
-  int cachenum;
-  bool success;
+  uInt64 length, modtime;
 
   // Ensure we start with a NULL result
-  *zip = nullptr;
+  zip.reset();
+
+  if(!file_stats(filename, length, modtime))
+    return ZIPERR_FILE_ERROR;
 
   // See if we are in the cache, and reopen if so
-  for(cachenum = 0; cachenum < ZIP_CACHE_SIZE; ++cachenum)
+  for(int cachenum = 0; cachenum < ZIP_CACHE_SIZE; ++cachenum)
   {
-    zip_file* cached = myZipCache[cachenum];
+    unique_ptr<zip_file>& cached = myZipCache[cachenum];
 
     // If we have a valid entry and it matches our filename, use it and remove
-    // from the cache
-    if(cached != nullptr && cached->filename != nullptr &&
-       strcmp(filename, cached->filename) == 0)
+    // from the cache; if the file has changed since, the entry is useless
+    if(cached && cached->filename == filename)
     {
-      *zip = cached;
-      myZipCache[cachenum] = nullptr;
-      return ZIPERR_NONE;
+      if(cached->length == length && cached->modtime == modtime)
+      {
+        zip = std::move(cached);
+        return ZIPERR_NONE;
+      }
+      cached.reset();
+      break;
     }
   }
 
-  // Allocate memory for the zip_file structure
-  newzip = (zip_file*)malloc(sizeof(*newzip));
-  if (newzip == nullptr)
-    return ZIPERR_OUT_OF_MEMORY;
-  memset(newzip, 0, sizeof(*newzip));
+  unique_ptr<zip_file> newzip = make_unique<zip_file>();
+  newzip->filename = filename;
 
-  // Open the file
-  if(!stream_open(filename, &newzip->file, newzip->length))
-  {
-    ziperr = ZIPERR_FILE_ERROR;
-    goto error;
-  }
+  // Map the file into memory
+  if(!map_file(*newzip))
+    return ZIPERR_FILE_ERROR;
 
   // Read ecd data
-  ziperr = read_ecd(newzip);
+  ziperr = read_ecd(newzip.get());
   if(ziperr != ZIPERR_NONE)
-    goto error;
+    return ziperr;
 
   // Verify that we can work with this zipfile (no disk spanning allowed)
   if (newzip->ecd.disk_number != newzip->ecd.cd_start_disk_number ||
       newzip->ecd.cd_disk_entries != newzip->ecd.cd_total_entries)
-  {
-    ziperr = ZIPERR_UNSUPPORTED;
-    goto error;
-  }
-
-  // Allocate memory for the central directory
-  newzip->cd = (uInt8*)malloc(newzip->ecd.cd_size + 1);
-  if(newzip->cd == nullptr)
-  {
-    ziperr = ZIPERR_OUT_OF_MEMORY;
-    goto error;
-  }
-
-  // Read the central directory
-  success = stream_read(newzip->file, newzip->cd, newzip->ecd.cd_start_disk_offset,
-                        newzip->ecd.cd_size, read_length);
-  if(!success || read_length != newzip->ecd.cd_size)
-  {
-    ziperr = success ? ZIPERR_FILE_TRUNCATED : ZIPERR_FILE_ERROR;
-    goto error;
-  }
-
-  // Make a copy of the filename for caching purposes
-  string = (char*)malloc(strlen(filename) + 1);
-  if (string == nullptr)
-  {
-    ziperr = ZIPERR_OUT_OF_MEMORY;
-    goto error;
-  }
-
-  strcpy(string, filename);
-  newzip->filename = string;
-  *zip = newzip;
+    return ZIPERR_UNSUPPORTED;
 
-  // Count ROM files (we do it at this level so it will be cached)
-  while(hasNext())
-  {
-    const std::string& file = next();
-    if(BSPF::endsWithIgnoreCase(file, ".a26") ||
-       BSPF::endsWithIgnoreCase(file, ".bin") ||
-       BSPF::endsWithIgnoreCase(file, ".rom"))
-      (*zip)->romfiles++;
-  }
+  // Parse the central directory (only once, since the results are cached)
+  ziperr = read_cd(newzip.get());
+  if(ziperr != ZIPERR_NONE)
+    return ziperr;
 
+  zip = std::move(newzip);
   return ZIPERR_NONE;
-
-error:
-  free_zip_file(newzip);
-  return ziperr;
 }
 
 
@@ -281,14 +308,10 @@ error:
     zip_file_close - close a ZIP file and add it
     to the cache
 -------------------------------------------------*/
-void ZipHandler::zip_file_close(zip_file* zip)
+void ZipHandler::zip_file_close(unique_ptr<zip_file>& zip)
 {
   int cachenum;
 
-  // Close the open files
-  if(zip->file)
-    stream_close(&zip->file);
-
   // Find the first NULL entry in the cache
   for(cachenum = 0; cachenum < ZIP_CACHE_SIZE; ++cachenum)
     if(myZipCache[cachenum] == nullptr)
@@ -296,30 +319,12 @@ void ZipHandler::zip_file_close(zip_file* zip)
 
   // If no room left in the cache, free the bottommost entry
   if(cachenum == ZIP_CACHE_SIZE)
-    free_zip_file(myZipCache[--cachenum]);
+    myZipCache[--cachenum].reset();
 
   // Move everyone else down and place us at the top
-  if(cachenum != 0)
-    memmove(&myZipCache[1], &myZipCache[0], cachenum * sizeof(myZipCache[0]));
-  myZipCache[0] = zip;
-}
-
-
-/*-------------------------------------------------
-    zip_file_cache_clear - clear the ZIP file
-    cache and free all memory
--------------------------------------------------*/
-void ZipHandler::zip_file_cache_clear()
-{
-  // Clear call cache entries
-  for(int cachenum = 0; cachenum < ZIP_CACHE_SIZE; ++cachenum)
-  {
-    if(myZipCache[cachenum] != nullptr)
-    {
-      free_zip_file(myZipCache[cachenum]);
-      myZipCache[cachenum] = nullptr;
-    }
-  }
+  for(; cachenum > 0; --cachenum)
+    myZipCache[cachenum] = std::move(myZipCache[cachenum - 1]);
+  myZipCache[0] = std::move(zip);
 }
 
 
@@ -327,62 +332,6 @@ void ZipHandler::zip_file_cache_clear()
     CONTAINED FILE ACCESS
 ***************************************************************************/
 
-/*-------------------------------------------------
-    zip_file_next_entry - return the next entry
-    in the ZIP
--------------------------------------------------*/
-const ZipHandler::zip_file_header* ZipHandler::zip_file_next_file(zip_file* zip)
-{
-  // Fix up any modified data
-  if(zip->header.raw != nullptr)
-  {
-    zip->header.raw[ZIPCFN + zip->header.filename_length] = zip->header.saved;
-    zip->header.raw = nullptr;
-  }
-
-  // If we're at or past the end, we're done
-  if(zip->cd_pos >= zip->ecd.cd_size)
-    return nullptr;
-
-  // Extract file header info
-  zip->header.raw                 = zip->cd + zip->cd_pos;
-  zip->header.rawlength           = ZIPCFN;
-  zip->header.signature           = read_dword(zip->header.raw + ZIPCENSIG);
-  zip->header.version_created     = read_word (zip->header.raw + ZIPCVER);
-  zip->header.version_needed      = read_word (zip->header.raw + ZIPCVXT);
-  zip->header.bit_flag            = read_word (zip->header.raw + ZIPCFLG);
-  zip->header.compression         = read_word (zip->header.raw + ZIPCMTHD);
-  zip->header.file_time           = read_word (zip->header.raw + ZIPCTIM);
-  zip->header.file_date           = read_word (zip->header.raw + ZIPCDAT);
-  zip->header.crc                 = read_dword(zip->header.raw + ZIPCCRC);
-  zip->header.compressed_length   = read_dword(zip->header.raw + ZIPCSIZ);
-  zip->header.uncompressed_length = read_dword(zip->header.raw + ZIPCUNC);
-  zip->header.filename_length     = read_word (zip->header.raw + ZIPCFNL);
-  zip->header.extra_field_length  = read_word (zip->header.raw + ZIPCXTL);
-  zip->header.file_comment_length = read_word (zip->header.raw + ZIPCCML);
-  zip->header.start_disk_number   = read_word (zip->header.raw + ZIPDSK);
-  zip->header.internal_attributes = read_word (zip->header.raw + ZIPINT);
-  zip->header.external_attributes = read_dword(zip->header.raw + ZIPEXT);
-  zip->header.local_header_offset = read_dword(zip->header.raw + ZIPOFST);
-  zip->header.filename            = (char*)zip->header.raw + ZIPCFN;
-
-  // Make sure we have enough data
-  zip->header.rawlength += zip->header.filename_length;
-  zip->header.rawlength += zip->header.extra_field_length;
-  zip->header.rawlength += zip->header.file_comment_length;
-  if(zip->cd_pos + zip->header.rawlength > zip->ecd.cd_size)
-    return nullptr;
-
-  // NULL terminate the filename
-  uInt32 size = ZIPCFN + zip->header.filename_length;
-  zip->header.saved = zip->header.raw[size];
-  zip->header.raw[size] = 0;
-
-  // Advance the position
-  zip->cd_pos += zip->header.rawlength;
-  return &zip->header;
-}
-
 /*-------------------------------------------------
     zip_file_decompress - decompress a file
     from a ZIP into the target buffer
@@ -394,11 +343,11 @@ ZipHandler::zip_error
   uInt64 offset;
 
   // If we don't have enough buffer, error
-  if(length < zip->header.uncompressed_length)
+  if(length < zip->header->uncompressed_length)
     return ZIPERR_BUFFER_TOO_SMALL;
 
   // Make sure the info in the header aligns with what we know
-  if(zip->header.start_disk_number != zip->ecd.disk_number)
+  if(zip->header->start_disk_number != zip->ecd.disk_number)
     return ZIPERR_UNSUPPORTED;
 
   // Get the compressed data offset
@@ -407,7 +356,7 @@ ZipHandler::zip_error
     return ziperr;
 
   // Handle compression types
-  switch(zip->header.compression)
+  switch(zip->header->compression)
   {
     case 0:
       ziperr = decompress_data_type_0(zip, offset, buffer, length);
@@ -425,104 +374,113 @@ ZipHandler::zip_error
 }
 
 /***************************************************************************
-    CACHE MANAGEMENT
+    ZIP FILE PARSING
 ***************************************************************************/
 
 /*-------------------------------------------------
-    free_zip_file - free all the data for a
-    zip_file
+    read_ecd - read the ECD data
 -------------------------------------------------*/
-void ZipHandler::free_zip_file(zip_file* zip)
+
+ZipHandler::zip_error ZipHandler::read_ecd(zip_file* zip)
 {
-  if(zip != nullptr)
+  // The ECD is at the very end of the file, followed only by the comment
+  // (which is at most 64K long)
+  if(zip->length < ZIPECOM)
+    return ZIPERR_BAD_SIGNATURE;
+
+  uInt32 buflen = uInt32(std::min(zip->length, uInt64(0xffff + ZIPECOM)));
+  const uInt8* buffer = zip->data + (zip->length - buflen);
+
+  // Find the ECD signature
+  for(Int32 offset = buflen - ZIPECOM; offset >= 0; offset--)
   {
-    if(zip->file)
-      stream_close(&zip->file);
-    if(zip->filename != nullptr)
-      free((void*)zip->filename);
-    if(zip->ecd.raw != nullptr)
-      free(zip->ecd.raw);
-    if(zip->cd != nullptr)
-      free(zip->cd);
-    free(zip);
+    if(buffer[offset + 0] == 'P' && buffer[offset + 1] == 'K' &&
+       buffer[offset + 2] == 0x05 && buffer[offset + 3] == 0x06)
+    {
+      const uInt8* raw = buffer + offset;
+
+      // Extract ecd info
+      zip->ecd.signature            = read_dword(raw + ZIPESIG);
+      zip->ecd.disk_number          = read_word (raw + ZIPEDSK);
+      zip->ecd.cd_start_disk_number = read_word (raw + ZIPECEN);
+      zip->ecd.cd_disk_entries      = read_word (raw + ZIPENUM);
+      zip->ecd.cd_total_entries     = read_word (raw + ZIPECENN);
+      zip->ecd.cd_size              = read_dword(raw + ZIPECSZ);
+      zip->ecd.cd_start_disk_offset = read_dword(raw + ZIPEOFST);
+      zip->ecd.comment_length       = read_word (raw + ZIPECOML);
+      return ZIPERR_NONE;
+    }
   }
+  return ZIPERR_BAD_SIGNATURE;
 }
 
-/***************************************************************************
-    ZIP FILE PARSING
-***************************************************************************/
-
 /*-------------------------------------------------
-    read_ecd - read the ECD data
+    read_cd - parse the central directory into a
+    list of files, and an index by filename
 -------------------------------------------------*/
-
-ZipHandler::zip_error ZipHandler::read_ecd(zip_file* zip)
+ZipHandler::zip_error ZipHandler::read_cd(zip_file* zip)
 {
-  uInt32 buflen = 1024;
-  uInt8* buffer;
+  // Make sure the central directory is actually present
+  if(uInt64(zip->ecd.cd_start_disk_offset) + zip->ecd.cd_size > zip->length)
+    return ZIPERR_FILE_TRUNCATED;
+
+  const uInt8* cd = zip->data + zip->ecd.cd_start_disk_offset;
+  uInt32 cd_pos = 0;
 
-  // We may need multiple tries
-  while(buflen < 65536)
+  zip->headers.reserve(zip->ecd.cd_total_entries);
+  zip->index.reserve(zip->ecd.cd_total_entries);
+  while(cd_pos + ZIPCFN <= zip->ecd.cd_size)
   {
-    uInt32 read_length;
-    Int32 offset;
-
-    // Max out the buffer length at the size of the file
-    if(buflen > zip->length)
-      buflen = (uInt32)zip->length;
-
-    // Allocate buffer
-    buffer = (uInt8*)malloc(buflen + 1);
-    if(buffer == nullptr)
-      return ZIPERR_OUT_OF_MEMORY;
-
-    // Read in one buffers' worth of data
-    bool success = stream_read(zip->file, buffer, zip->length - buflen,
-                               buflen, read_length);
-    if(!success || read_length != buflen)
-    {
-      free(buffer);
-      return ZIPERR_FILE_ERROR;
-    }
+    // Extract file header info
+    const uInt8* raw = cd + cd_pos;
+    zip_file_header header;
+    header.signature           = read_dword(raw + ZIPCENSIG);
+    header.version_created     = read_word (raw + ZIPCVER);
+    header.version_needed      = read_word (raw + ZIPCVXT);
+    header.bit_flag            = read_word (raw + ZIPCFLG);
+    header.compression         = read_word (raw + ZIPCMTHD);
+    header.file_time           = read_word (raw + ZIPCTIM);
+    header.file_date           = read_word (raw + ZIPCDAT);
+    header.crc                 = read_dword(raw + ZIPCCRC);
+    header.compressed_length   = read_dword(raw + ZIPCSIZ);
+    header.uncompressed_length = read_dword(raw + ZIPCUNC);
+    header.filename_length     = read_word (raw + ZIPCFNL);
+    header.extra_field_length  = read_word (raw + ZIPCXTL);
+    header.file_comment_length = read_word (raw + ZIPCCML);
+    header.start_disk_number   = read_word (raw + ZIPDSK);
+    header.internal_attributes = read_word (raw + ZIPINT);
+    header.external_attributes = read_dword(raw + ZIPEXT);
+    header.local_header_offset = read_dword(raw + ZIPOFST);
+
+    // Make sure we have enough data
+    uInt32 rawlength = ZIPCFN + header.filename_length +
+        header.extra_field_length + header.file_comment_length;
+    if(cd_pos + rawlength > zip->ecd.cd_size)
+      break;
 
-    // Find the ECD signature
-    for(offset = buflen - 22; offset >= 0; offset--)
-      if(buffer[offset + 0] == 'P' && buffer[offset + 1] == 'K' &&
-         buffer[offset + 2] == 0x05 && buffer[offset + 3] == 0x06)
-        break;
+    header.filename.assign(reinterpret_cast<const char*>(raw + ZIPCFN),
+                           header.filename_length);
 
-    // If we found it, fill out the data
-    if(offset >= 0)
-    {
-      // Reuse the buffer as our ECD buffer
-      zip->ecd.raw = buffer;
-      zip->ecd.rawlength = buflen - offset;
+    // Advance the position
+    cd_pos += rawlength;
 
-      // Append a NULL terminator to the comment
-      memmove(&buffer[0], &buffer[offset], zip->ecd.rawlength);
-      zip->ecd.raw[zip->ecd.rawlength] = 0;
+    // Ignore zero-length files and '__MACOSX' virtual directories
+    if(header.uncompressed_length == 0 ||
+       BSPF::startsWithIgnoreCase(header.filename, "__MACOSX"))
+      continue;
 
-      // Extract ecd info
-      zip->ecd.signature            = read_dword(zip->ecd.raw + ZIPESIG);
-      zip->ecd.disk_number          = read_word (zip->ecd.raw + ZIPEDSK);
-      zip->ecd.cd_start_disk_number = read_word (zip->ecd.raw + ZIPECEN);
-      zip->ecd.cd_disk_entries      = read_word (zip->ecd.raw + ZIPENUM);
-      zip->ecd.cd_total_entries     = read_word (zip->ecd.raw + ZIPECENN);
-      zip->ecd.cd_size              = read_dword(zip->ecd.raw + ZIPECSZ);
-      zip->ecd.cd_start_disk_offset = read_dword(zip->ecd.raw + ZIPEOFST);
-      zip->ecd.comment_length       = read_word (zip->ecd.raw + ZIPECOML);
-      zip->ecd.comment              = (const char *)(zip->ecd.raw + ZIPECOM);
-      return ZIPERR_NONE;
-    }
+    // Count ROM files (we do it at this level so it will be cached)
+    if(BSPF::endsWithIgnoreCase(header.filename, ".a26") ||
+       BSPF::endsWithIgnoreCase(header.filename, ".bin") ||
+       BSPF::endsWithIgnoreCase(header.filename, ".rom"))
+      zip->romfiles++;
 
-    // Didn't find it; free this buffer and expand our search
-    free(buffer);
-    if(buflen < zip->length)
-      buflen *= 2;
-    else
-      return ZIPERR_BAD_SIGNATURE;
+    // If a filename appears more than once, the first entry is used
+    zip->index.emplace(header.filename, uInt32(zip->headers.size()));
+    zip->headers.push_back(std::move(header));
   }
-  return ZIPERR_OUT_OF_MEMORY;
+
+  return ZIPERR_NONE;
 }
 
 /*-------------------------------------------------
@@ -532,22 +490,21 @@ ZipHandler::zip_error ZipHandler::read_ecd(zip_file* zip)
 ZipHandler::zip_error
     ZipHandler::get_compressed_data_offset(zip_file* zip, uInt64& offset)
 {
-  uInt32 read_length;
-
-  // Make sure the file handle is open
-  if(zip->file == nullptr && !stream_open(zip->filename, &zip->file, zip->length))
-    return ZIPERR_FILE_ERROR;
-
   // Now go read the fixed-sized part of the local file header
-  bool success = stream_read(zip->file, zip->buffer, zip->header.local_header_offset,
-                             ZIPNAME, read_length);
-  if(!success || read_length != ZIPNAME)
-    return success ? ZIPERR_FILE_TRUNCATED : ZIPERR_FILE_ERROR;
+  const uInt64 local_header_offset = zip->header->local_header_offset;
+  if(local_header_offset + ZIPNAME > zip->length)
+    return ZIPERR_FILE_TRUNCATED;
+
+  const uInt8* local = zip->data + local_header_offset;
 
   // Compute the final offset
-  offset = zip->header.local_header_offset + ZIPNAME;
-  offset += read_word(zip->buffer + ZIPFNLN);
-  offset += read_word(zip->buffer + ZIPXTRALN);
+  offset = local_header_offset + ZIPNAME;
+  offset += read_word(local + ZIPFNLN);
+  offset += read_word(local + ZIPXTRALN);
+
+  // Make sure all the compressed data is present
+  if(offset + zip->header->compressed_length > zip->length)
+    return ZIPERR_FILE_TRUNCATED;
 
   return ZIPERR_NONE;
 }
@@ -564,17 +521,12 @@ ZipHandler::zip_error
     ZipHandler::decompress_data_type_0(zip_file* zip, uInt64 offset,
                                        void* buffer, uInt32 length)
 {
-  uInt32 read_length;
+  // The data is uncompressed; just copy it out of the mapped file
+  if(zip->header->compressed_length != zip->header->uncompressed_length)
+    return ZIPERR_FILE_CORRUPT;
 
-  // The data is uncompressed; just read it
-  bool success = stream_read(zip->file, buffer, offset,
-                             zip->header.compressed_length, read_length);
-  if(!success)
-    return ZIPERR_FILE_ERROR;
-  else if(read_length != zip->header.compressed_length)
-    return ZIPERR_FILE_TRUNCATED;
-  else
-    return ZIPERR_NONE;
+  memcpy(buffer, zip->data + offset, zip->header->compressed_length);
+  return ZIPERR_NONE;
 }
 
 /*-------------------------------------------------
@@ -585,8 +537,6 @@ ZipHandler::zip_error
     ZipHandler::decompress_data_type_8(zip_file* zip, uInt64 offset,
                                        void* buffer, uInt32 length)
 {
-  uInt32 input_remaining = zip->header.compressed_length;
-  uInt32 read_length;
   z_stream stream;
   int zerr;
 
@@ -594,7 +544,7 @@ ZipHandler::zip_error
   // TODO - check newer versions of ZIP, and determine why this specific
   //        version (0x14) is important
   // Make sure we don't need a newer mechanism
-  if (zip->header.version_needed > 0x14)
+  if (zip->header->version_needed > 0x14)
     return ZIPERR_UNSUPPORTED;
 #endif
 
@@ -603,50 +553,26 @@ ZipHandler::zip_error
   stream.next_out = (Bytef *)buffer;
   stream.avail_out = length;
 
+  // The compressed data is taken directly from the mapped file
+  stream.next_in = (Bytef *)(zip->data + offset);
+  stream.avail_in = zip->header->compressed_length;
+
+  // Add a dummy byte at end of compressed data (the central directory
+  // always follows it, so this is still inside the file)
+  if(offset + stream.avail_in < zip->length)
+    stream.avail_in++;
+
   // Initialize the decompressor
   zerr = inflateInit2(&stream, -MAX_WBITS);
   if(zerr != Z_OK)
     return ZIPERR_DECOMPRESS_ERROR;
 
-  // Loop until we're done
-  for(;;)
+  // All the input is available at once, so this is done in a single step
+  zerr = inflate(&stream, Z_FINISH);
+  if(zerr != Z_STREAM_END)
   {
-    // Read in the next chunk of data
-    bool success = stream_read(zip->file, zip->buffer, offset,
-                      std::min(input_remaining, (uInt32)sizeof(zip->buffer)),
-                      read_length);
-    if(!success)
-    {
-      inflateEnd(&stream);
-      return ZIPERR_FILE_ERROR;
-    }
-    offset += read_length;
-
-    // If we read nothing, but still have data left, the file is truncated
-    if(read_length == 0 && input_remaining > 0)
-    {
-      inflateEnd(&stream);
-      return ZIPERR_FILE_TRUNCATED;
-    }
-
-    // Fill out the input data
-    stream.next_in = zip->buffer;
-    stream.avail_in = read_length;
-    input_remaining -= read_length;
-
-    // Add a dummy byte at end of compressed data
-    if(input_remaining == 0)
-      stream.avail_in++;
-
-    // Now inflate
-    zerr = inflate(&stream, Z_NO_FLUSH);
-    if(zerr == Z_STREAM_END)
-      break;
-    if(zerr != Z_OK)
-    {
-      inflateEnd(&stream);
-      return ZIPERR_DECOMPRESS_ERROR;
-    }
+    inflateEnd(&stream);
+    return ZIPERR_DECOMPRESS_ERROR;
   }
 
   // Finish decompression
@@ -655,7 +581,7 @@ ZipHandler::zip_error
     return ZIPERR_DECOMPRESS_ERROR;
 
   // If anything looks funny, report an error
-  if(stream.avail_out > 0 || input_remaining > 0)
+  if(stream.avail_out > 0)
     return ZIPERR_DECOMPRESS_ERROR;
 
   return ZIPERR_NONE;
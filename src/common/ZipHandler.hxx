@@ -18,6 +18,8 @@
 #ifndef ZIP_HANDLER_HXX
 #define ZIP_HANDLER_HXX
 
+#include <unordered_map>
+
 #include "bspf.hxx"
 
 /***************************************************************************
@@ -53,20 +55,22 @@
 
 ***************************************************************************/
 
-#define ZIP_DECOMPRESS_BUFSIZE  16384
-
 /**
   This class implements a thin wrapper around the zip file management code
   from the MAME project.
 
+  Each archive is mapped into memory when it's opened, and its central
+  directory is parsed only once; the results stay cached for as long as
+  the archive doesn't change on disk.
+
   @author  Wrapper class by Stephen Anthony, with main functionality
            by Aaron Giles
 */
 class ZipHandler
 {
   public:
-    ZipHandler();
-    ~ZipHandler();
+    ZipHandler() = default;
+    ~ZipHandler() = default;
 
     // Open ZIP file for processing
     void open(const string& filename);
@@ -76,6 +80,10 @@ class ZipHandler
     bool hasNext();   // Answer whether there are more files present
     string next();    // Get next file
 
+    // Select the file with the given name (as returned by 'next'),
+    // without iterating over the other files
+    bool find(const string& filename);
+
     // Decompress the currently selected file and return its length
     // An exception will be thrown on any errors
     uInt32 decompress(BytePtr& image);
@@ -85,12 +93,6 @@ class ZipHandler
     uInt16 romFiles() const { return myZip ? myZip->romfiles : 0; }
 
   private:
-    // Replaces functionaity of various osd_xxxx functions
-    static bool stream_open(const char* filename, fstream** stream, uInt64& length);
-    static void stream_close(fstream** stream);
-    static bool stream_read(fstream* stream, void* buffer, uInt64 offset,
-                            uInt32 length, uInt32& actual);
-
     /* Error types */
     enum zip_error
     {
@@ -125,11 +127,7 @@ class ZipHandler
       uInt16      internal_attributes;  /* internal file attributes */
       uInt32      external_attributes;  /* external file attributes */
       uInt32      local_header_offset;  /* relative offset of local header */
-      const char* filename;     /* filename */
-
-      uInt8*      raw;          /* pointer to the raw data */
-      uInt32      rawlength;    /* length of the raw data */
-      uInt8       saved;        /* saved byte from after filename */
+      string      filename;             /* filename */
     };
 
     /* contains extracted end of central directory information */
@@ -143,27 +141,29 @@ class ZipHandler
       uInt32      cd_size;              /* size of the central directory */
       uInt32      cd_start_disk_offset; /* offset of start of central directory with respect to the starting disk number */
       uInt16      comment_length;       /* .ZIP file comment length */
-      const char* comment;              /* .ZIP file comment */
-
-      uInt8*      raw;              /* pointer to the raw data */
-      uInt32      rawlength;        /* length of the raw data */
     };
 
     /* describes an open ZIP file */
     struct zip_file
     {
-      const char*     filename;   /* copy of ZIP filename (for caching) */
-      fstream*        file;       /* C++ fstream file handle */
+      string          filename;   /* copy of ZIP filename (for caching) */
       uInt64          length;     /* length of zip file */
+      uInt64          modtime;    /* modification time of zip file (for caching) */
       uInt16          romfiles;   /* number of ROM files in central directory */
 
+      const uInt8*    data;       /* contents of zip file (mapped into memory) */
+      BytePtr         buffer;     /* contents of zip file, when it can't be mapped */
+
       zip_ecd         ecd;        /* end of central directory */
 
-      uInt8*          cd;         /* central directory raw data */
-      uInt32          cd_pos;     /* position in central directory */
-      zip_file_header header;     /* current file header */
+      vector<zip_file_header> headers;  /* all files in central directory */
+      std::unordered_map<string, uInt32> index; /* filename -> headers entry */
+      uInt32          cd_pos;     /* position in 'headers' */
+      const zip_file_header* header; /* current file header */
 
-      uInt8 buffer[ZIP_DECOMPRESS_BUFSIZE]; /* buffer for decompression */
+      zip_file() : length(0), modtime(0), romfiles(0), data(nullptr),
+                   cd_pos(0), header(nullptr) { }
+      ~zip_file() { unmap_file(*this); }
     };
 
     enum {
@@ -222,39 +222,36 @@ class ZipHandler
     /* ----- ZIP file access ----- */
 
     /* open a ZIP file and parse its central directory */
-    zip_error zip_file_open(const char* filename, zip_file** zip);
+    zip_error zip_file_open(const string& filename, unique_ptr<zip_file>& zip);
 
     /* close a ZIP file (may actually be left open due to caching) */
-    void zip_file_close(zip_file* zip);
-
-    /* clear out all open ZIP files from the cache */
-    void zip_file_cache_clear();
+    void zip_file_close(unique_ptr<zip_file>& zip);
 
 
     /* ----- contained file access ----- */
 
-    /* find the next file in the ZIP */
-    const zip_file_header* zip_file_next_file(zip_file* zip);
-
     /* decompress the most recently found file in the ZIP */
     zip_error zip_file_decompress(zip_file* zip, void* buffer, uInt32 length);
 
-    inline static uInt16 read_word(uInt8* buf)
+    inline static uInt16 read_word(const uInt8* buf)
     {
       uInt16 p0 = uInt16(buf[0]), p1 = uInt16(buf[1]);
       return (p1 << 8) | p0;
     }
 
-    inline static uInt32 read_dword(uInt8* buf)
+    inline static uInt32 read_dword(const uInt8* buf)
     {
       return (buf[3] << 24) | (buf[2] << 16) | (buf[1] << 8) | buf[0];
     }
 
-    /* cache management */
-    static void free_zip_file(zip_file* zip);
+    /* replaces functionality of various osd_xxxx functions */
+    static bool file_stats(const string& filename, uInt64& length, uInt64& modtime);
+    static bool map_file(zip_file& zip);
+    static void unmap_file(zip_file& zip);
 
     /* ZIP file parsing */
     static zip_error read_ecd(zip_file* zip);
+    static zip_error read_cd(zip_file* zip);
     static zip_error get_compressed_data_offset(zip_file* zip, uInt64& offset);
 
     /* decompression interfaces */
@@ -264,8 +261,8 @@ class ZipHandler
                                             void* buffer, uInt32 length);
 
   private:
-    zip_file* myZip;
-    zip_file* myZipCache[ZIP_CACHE_SIZE];
+    unique_ptr<zip_file> myZip;
+    unique_ptr<zip_file> myZipCache[ZIP_CACHE_SIZE];
 
   private:
     // Following constructors and assignment operators not supported
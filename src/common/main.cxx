@@ -29,6 +29,8 @@
 #include "FSNode.hxx"
 #include "OSystem.hxx"
 #include "System.hxx"
+#include "HeadlessRunner.hxx"
+#include "Benchmark.hxx"
 
 #ifdef DEBUGGER_SUPPORT
   #include "Debugger.hxx"
@@ -101,6 +103,39 @@ int main(int argc, char* argv[])
     theOSystem->settings().usage();
     return Cleanup();
   }
+  else if(theOSystem->settings().getBool("benchmark"))
+  {
+    theOSystem->logMessage("Running benchmark ...", 2);
+    FilesystemNode romnode(romfile);
+    if(romfile == "" || !romnode.exists())
+    {
+      theOSystem->logMessage("ERROR: No valid ROM or directory specified", 0);
+      return Cleanup();
+    }
+    Benchmark benchmark(*theOSystem);
+    benchmark.runAll(romnode, theOSystem->settings().getInt("frames"), cout);
+    return Cleanup();
+  }
+  else if(theOSystem->settings().getBool("ntscbenchmark"))
+  {
+    theOSystem->logMessage("Running NTSC filter benchmark ...", 2);
+    Benchmark::runNTSC(theOSystem->settings().getInt("frames"), cout);
+    return Cleanup();
+  }
+  else if(theOSystem->settings().getBool("headless"))
+  {
+    theOSystem->logMessage("Running headless emulation ...", 2);
+    FilesystemNode romnode(romfile);
+    if(romfile == "" || !romnode.exists())
+    {
+      theOSystem->logMessage("ERROR: No valid ROM or directory specified", 0);
+      return Cleanup();
+    }
+    HeadlessRunner runner(*theOSystem);
+    runner.runAll(romnode, theOSystem->settings().getInt("frames"),
+                  theOSystem->settings().getInt("jobs"), cout);
+    return Cleanup();
+  }
 
   //// Main loop ////
   // First we check if a ROM is specified on the commandline.  If so, and if
@@ -7,7 +7,10 @@ MODULE_OBJS := \
 	src/common/FrameBufferSDL2.o \
 	src/common/FBSurfaceSDL2.o \
 	src/common/SoundSDL2.o \
+	src/common/SoundWav.o \
 	src/common/FSNodeZIP.o \
+	src/common/HeadlessRunner.o \
+	src/common/Benchmark.o \
 	src/common/PNGLibrary.o \
 	src/common/MouseControl.o \
 	src/common/RewindManager.o \
@@ -18,6 +18,21 @@
 #include <thread>
 #include "AtariNTSC.hxx"
 
+// The vectorized kernels; SSE2 and NEON are selected at compile-time (they
+// are always available on x64 and ARM64), while AVX2 is only used when
+// the CPU running the code supports it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define ATARI_NTSC_SSE2
+  #include <emmintrin.h>
+  #if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define ATARI_NTSC_AVX2
+    #include <immintrin.h>
+  #endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+  #define ATARI_NTSC_NEON
+  #include <arm_neon.h>
+#endif
+
 // blitter related
 #ifndef restrict
   #if defined (__GNUC__)
@@ -30,6 +45,23 @@
   #endif
 #endif
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AtariNTSC::AtariNTSC()
+  : myKernel(Kernel::Scalar),
+    myRenderLine(&AtariNTSC::renderLine),
+    myWorkerThreads(0),
+    myFrameCount(0),
+    myPendingWorkers(0),
+    myQuitWorkers(false)
+{
+  enableThreading(false);
+
+  // Use the fastest kernel available
+  // The NEON kernel hasn't been verified on ARM hardware yet, so it's only
+  // used when explicitly selected (see 'setKernel')
+  setKernel(Kernel::AVX2) || setKernel(Kernel::SSE2);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::initialize(const Setup& setup, const uInt8* palette)
 {
@@ -69,6 +101,9 @@ void AtariNTSC::initializePalette(const uInt8* palette)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AtariNTSC::enableThreading(bool enable)
 {
+  // Any previous threads are replaced by a new set
+  stopThreads();
+
   uInt32 systemThreads = enable ? std::thread::hardware_concurrency() : 0;
   if(systemThreads <= 1)
   {
@@ -82,34 +117,139 @@ void AtariNTSC::enableThreading(bool enable)
     myWorkerThreads = systemThreads - 1;
     myTotalThreads  = systemThreads;
 
+    // The threads keep running, and wait for a new frame to be rendered
     myThreads = make_unique<std::thread[]>(myWorkerThreads);
+    for(uInt32 i = 0; i < myWorkerThreads; ++i)
+      myThreads[i] = std::thread(&AtariNTSC::workerThread, this, i+1, myFrameCount);
   }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width, const uInt32 in_height,
-  void* rgb_out, const uInt32 out_pitch, uInt32* rgb_in)
+bool AtariNTSC::setKernel(Kernel kernel)
 {
-  // Spawn the threads...
+  if(!isKernelSupported(kernel))
+    return false;
+
+  switch(kernel)
+  {
+  #ifdef ATARI_NTSC_SSE2
+    case Kernel::SSE2:  myRenderLine = &AtariNTSC::renderLineSSE2;  break;
+  #endif
+  #ifdef ATARI_NTSC_AVX2
+    case Kernel::AVX2:  myRenderLine = &AtariNTSC::renderLineAVX2;  break;
+  #endif
+  #ifdef ATARI_NTSC_NEON
+    case Kernel::NEON:  myRenderLine = &AtariNTSC::renderLineNEON;  break;
+  #endif
+    default:            myRenderLine = &AtariNTSC::renderLine;      break;
+  }
+  myKernel = kernel;
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool AtariNTSC::isKernelSupported(Kernel kernel)
+{
+  switch(kernel)
+  {
+    case Kernel::Scalar:  return true;
+  #ifdef ATARI_NTSC_SSE2
+    case Kernel::SSE2:    return true;
+  #endif
+  #ifdef ATARI_NTSC_AVX2
+    case Kernel::AVX2:    return __builtin_cpu_supports("avx2");
+  #endif
+  #ifdef ATARI_NTSC_NEON
+    case Kernel::NEON:    return true;
+  #endif
+    default:              return false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+string AtariNTSC::kernelName(Kernel kernel)
+{
+  switch(kernel)
+  {
+    case Kernel::Scalar:  return "Scalar";
+    case Kernel::SSE2:    return "SSE2";
+    case Kernel::AVX2:    return "AVX2";
+    case Kernel::NEON:    return "NEON";
+  }
+  return "";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::stopThreads()
+{
+  if(myWorkerThreads == 0)
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQuitWorkers = true;
+  }
+  myWorkAvailable.notify_all();
   for(uInt32 i = 0; i < myWorkerThreads; ++i)
+    myThreads[i].join();
+
+  myThreads.reset();
+  myWorkerThreads = 0;
+  myQuitWorkers = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::workerThread(const uInt32 threadNum, uInt32 frameCount)
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+  for(;;)
   {
-    myThreads[i] = std::thread([=] {
-    rgb_in == nullptr ?
-      renderThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_out, out_pitch) :
-      renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, i+1, rgb_in, rgb_out, out_pitch);
+    myWorkAvailable.wait(lock, [&] {
+      return myQuitWorkers || myFrameCount != frameCount;
     });
+    if(myQuitWorkers)
+      break;
+
+    frameCount = myFrameCount;
+    const RenderJob job = myJob;
+    lock.unlock();
+
+    job.rgb_in == nullptr ?
+      renderThread(job.atari_in, job.in_width, job.in_height, myTotalThreads, threadNum, job.rgb_out, job.out_pitch) :
+      renderWithPhosphorThread(job.atari_in, job.in_width, job.in_height, myTotalThreads, threadNum, job.rgb_in, job.rgb_out, job.out_pitch);
+
+    lock.lock();
+    if(--myPendingWorkers == 0)
+      myWorkDone.notify_one();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::render(const uInt8* atari_in, const uInt32 in_width, const uInt32 in_height,
+  void* rgb_out, const uInt32 out_pitch, uInt32* rgb_in)
+{
+  // Hand the frame to the worker threads...
+  if(myWorkerThreads > 0)
+  {
+    {
+      std::lock_guard<std::mutex> lock(myMutex);
+      myJob = { atari_in, in_width, in_height, rgb_out, out_pitch, rgb_in };
+      myPendingWorkers = myWorkerThreads;
+      ++myFrameCount;
+    }
+    myWorkAvailable.notify_all();
   }
   // Make the main thread busy too
   rgb_in == nullptr ?
     renderThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_out, out_pitch) :
     renderWithPhosphorThread(atari_in, in_width, in_height, myTotalThreads, 0, rgb_in, rgb_out, out_pitch);
-  // ...and make them join again
-  for(uInt32 i = 0; i < myWorkerThreads; ++i)
-    myThreads[i].join();
-
-  // Copy phosphor values into out buffer
-  if(rgb_in != nullptr)
-    memcpy(rgb_out, rgb_in, in_height * out_pitch);
+  // ...and wait for them to finish
+  if(myWorkerThreads > 0)
+  {
+    std::unique_lock<std::mutex> lock(myMutex);
+    myWorkDone.wait(lock, [this] { return myPendingWorkers == 0; });
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -127,56 +267,7 @@ void AtariNTSC::renderThread(const uInt8* atari_in, const uInt32 in_width,
 
   for(uInt32 y = yStart; y < yEnd; ++y)
   {
-    const uInt8* line_in = atari_in;
-    ATARI_NTSC_BEGIN_ROW(NTSC_black, line_in[0]);
-    uInt32* restrict line_out = static_cast<uInt32*>(rgb_out);
-    ++line_in;
-
-    for(uInt32 n = chunk_count; n; --n)
-    {
-      // order of input and output pixels must not be altered
-      ATARI_NTSC_COLOR_IN(0, line_in[0]);
-      ATARI_NTSC_RGB_OUT_8888(0, line_out[0]);
-      ATARI_NTSC_RGB_OUT_8888(1, line_out[1]);
-      ATARI_NTSC_RGB_OUT_8888(2, line_out[2]);
-      ATARI_NTSC_RGB_OUT_8888(3, line_out[3]);
-
-      ATARI_NTSC_COLOR_IN(1, line_in[1]);
-      ATARI_NTSC_RGB_OUT_8888(4, line_out[4]);
-      ATARI_NTSC_RGB_OUT_8888(5, line_out[5]);
-      ATARI_NTSC_RGB_OUT_8888(6, line_out[6]);
-
-      line_in += 2;
-      line_out += 7;
-    }
-
-    // finish final pixels
-    ATARI_NTSC_COLOR_IN(0, line_in[0]);
-    ATARI_NTSC_RGB_OUT_8888(0, line_out[0]);
-    ATARI_NTSC_RGB_OUT_8888(1, line_out[1]);
-    ATARI_NTSC_RGB_OUT_8888(2, line_out[2]);
-    ATARI_NTSC_RGB_OUT_8888(3, line_out[3]);
-
-    ATARI_NTSC_COLOR_IN(1, NTSC_black);
-    ATARI_NTSC_RGB_OUT_8888(4, line_out[4]);
-    ATARI_NTSC_RGB_OUT_8888(5, line_out[5]);
-    ATARI_NTSC_RGB_OUT_8888(6, line_out[6]);
-
-    line_in += 2;
-    line_out += 7;
-
-    ATARI_NTSC_COLOR_IN(0, NTSC_black);
-    ATARI_NTSC_RGB_OUT_8888(0, line_out[0]);
-    ATARI_NTSC_RGB_OUT_8888(1, line_out[1]);
-    ATARI_NTSC_RGB_OUT_8888(2, line_out[2]);
-    ATARI_NTSC_RGB_OUT_8888(3, line_out[3]);
-
-    ATARI_NTSC_COLOR_IN(1, NTSC_black);
-    ATARI_NTSC_RGB_OUT_8888(4, line_out[4]);
-#if 0
-    ATARI_NTSC_RGB_OUT_8888(5, line_out[5]);
-    ATARI_NTSC_RGB_OUT_8888(6, line_out[6]);
-#endif
+    (this->*myRenderLine)(atari_in, chunk_count, static_cast<uInt32*>(rgb_out));
 
     atari_in += in_width;
     rgb_out = static_cast<char*>(rgb_out) + out_pitch;
@@ -200,94 +291,46 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
 
   for(uInt32 y = yStart; y < yEnd; ++y)
   {
-    const uInt8* line_in = atari_in;
-    ATARI_NTSC_BEGIN_ROW(NTSC_black, line_in[0]);
-    uInt32* restrict line_out = static_cast<uInt32*>(rgb_out);
-    ++line_in;
-
-    for(uInt32 n = chunk_count; n; --n)
-    {
-      // order of input and output pixels must not be altered
-      ATARI_NTSC_COLOR_IN(0, line_in[0]);
-      ATARI_NTSC_RGB_OUT_8888(0, line_out[0]);
-      ATARI_NTSC_RGB_OUT_8888(1, line_out[1]);
-      ATARI_NTSC_RGB_OUT_8888(2, line_out[2]);
-      ATARI_NTSC_RGB_OUT_8888(3, line_out[3]);
-
-      ATARI_NTSC_COLOR_IN(1, line_in[1]);
-      ATARI_NTSC_RGB_OUT_8888(4, line_out[4]);
-      ATARI_NTSC_RGB_OUT_8888(5, line_out[5]);
-      ATARI_NTSC_RGB_OUT_8888(6, line_out[6]);
-
-      line_in += 2;
-      line_out += 7;
-    }
-
-    // finish final pixels
-    ATARI_NTSC_COLOR_IN(0, line_in[0]);
-    ATARI_NTSC_RGB_OUT_8888(0, line_out[0]);
-    ATARI_NTSC_RGB_OUT_8888(1, line_out[1]);
-    ATARI_NTSC_RGB_OUT_8888(2, line_out[2]);
-    ATARI_NTSC_RGB_OUT_8888(3, line_out[3]);
-
-    ATARI_NTSC_COLOR_IN(1, NTSC_black);
-    ATARI_NTSC_RGB_OUT_8888(4, line_out[4]);
-    ATARI_NTSC_RGB_OUT_8888(5, line_out[5]);
-    ATARI_NTSC_RGB_OUT_8888(6, line_out[6]);
-
-    line_in += 2;
-    line_out += 7;
-
-    ATARI_NTSC_COLOR_IN(0, NTSC_black);
-    ATARI_NTSC_RGB_OUT_8888(0, line_out[0]);
-    ATARI_NTSC_RGB_OUT_8888(1, line_out[1]);
-    ATARI_NTSC_RGB_OUT_8888(2, line_out[2]);
-    ATARI_NTSC_RGB_OUT_8888(3, line_out[3]);
-
-    ATARI_NTSC_COLOR_IN(1, NTSC_black);
-    ATARI_NTSC_RGB_OUT_8888(4, line_out[4]);
-#if 0
-    ATARI_NTSC_RGB_OUT_8888(5, line_out[5]);
-    ATARI_NTSC_RGB_OUT_8888(6, line_out[6]);
-#endif
+    (this->*myRenderLine)(atari_in, chunk_count, static_cast<uInt32*>(rgb_out));
 
     // Do phosphor mode (blend the resulting frames)
+    // The blended pixels are stored both in the displayed frame buffer and
+    // in the phosphor buffer (for the next frame)
     // Note: The code assumes that AtariNTSC::outWidth(kTIAW) == outPitch == 565
     for (uInt32 x = AtariNTSC::outWidth(in_width) / 8; x; --x)
     {
-      // Store back into displayed frame buffer (for next frame)
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+      out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
       bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+      out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
       bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+      out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
       bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+      out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
       bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+      out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
       bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+      out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
       bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+      out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
       bufofs++;
-      rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+      out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
       bufofs++;
     }
     // finish final pixels
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+    out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
     bufofs++;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+    out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
     bufofs++;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+    out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
     bufofs++;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+    out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
     bufofs++;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+    out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
     bufofs++;
 #if 0
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+    out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
     bufofs++;
-    rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
+    out[bufofs] = rgb_in[bufofs] = getRGBPhosphor(out[bufofs], rgb_in[bufofs]);
     bufofs++;
 #endif
 
@@ -296,6 +339,222 @@ void AtariNTSC::renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::renderLine(const uInt8* line_in, const uInt32 chunk_count,
+  uInt32* restrict line_out) const
+{
+  ATARI_NTSC_BEGIN_ROW(NTSC_black, line_in[0]);
+  ++line_in;
+
+  for(uInt32 n = chunk_count; n; --n)
+  {
+    // order of input and output pixels must not be altered
+    ATARI_NTSC_COLOR_IN(0, line_in[0]);
+    ATARI_NTSC_RGB_OUT_8888(0, line_out[0]);
+    ATARI_NTSC_RGB_OUT_8888(1, line_out[1]);
+    ATARI_NTSC_RGB_OUT_8888(2, line_out[2]);
+    ATARI_NTSC_RGB_OUT_8888(3, line_out[3]);
+
+    ATARI_NTSC_COLOR_IN(1, line_in[1]);
+    ATARI_NTSC_RGB_OUT_8888(4, line_out[4]);
+    ATARI_NTSC_RGB_OUT_8888(5, line_out[5]);
+    ATARI_NTSC_RGB_OUT_8888(6, line_out[6]);
+
+    line_in += 2;
+    line_out += 7;
+  }
+
+  // finish final pixels
+  ATARI_NTSC_END_ROW(line_in, line_out);
+}
+
+// The vectorized kernels compute four (or eight) output pixels at once,
+// exactly the same way as ATARI_NTSC_RGB_OUT_8888 does.  For each group of
+// output pixels, the kernel entries to be summed are contiguous.
+// Since each chunk generates seven pixels, the last lane of the second
+// group is junk; it is overwritten by the first pixel of the next chunk
+// (or by ATARI_NTSC_END_ROW), so nothing is written past the row.
+
+#ifdef ATARI_NTSC_SSE2
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static inline __m128i clampAndPackSSE2(__m128i raw, const __m128i mask, const __m128i add)
+{
+  // ATARI_NTSC_CLAMP_
+  const __m128i sub = _mm_and_si128(_mm_srli_epi32(raw, 9), mask);
+  __m128i clamp = _mm_sub_epi32(add, sub);
+  raw = _mm_or_si128(raw, clamp);
+  clamp = _mm_sub_epi32(clamp, sub);
+  raw = _mm_and_si128(raw, clamp);
+
+  // Convert to 8888 format
+  return _mm_or_si128(_mm_or_si128(
+      _mm_and_si128(_mm_srli_epi32(raw, 5), _mm_set1_epi32(0x00FF0000)),
+      _mm_and_si128(_mm_srli_epi32(raw, 3), _mm_set1_epi32(0x0000FF00))),
+      _mm_and_si128(_mm_srli_epi32(raw, 1), _mm_set1_epi32(0x000000FF)));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static inline __m128i sumSSE2(const uInt32* k0, const uInt32* k1,
+                              const uInt32* kx0, const uInt32* kx1)
+{
+  #define LOAD(k) _mm_loadu_si128(reinterpret_cast<const __m128i*>(k))
+  return _mm_add_epi32(_mm_add_epi32(LOAD(k0), LOAD(k1)),
+                       _mm_add_epi32(LOAD(kx0), LOAD(kx1)));
+  #undef LOAD
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::renderLineSSE2(const uInt8* line_in, const uInt32 chunk_count,
+  uInt32* restrict line_out) const
+{
+  const __m128i mask = _mm_set1_epi32(atari_ntsc_clamp_mask);
+  const __m128i add  = _mm_set1_epi32(atari_ntsc_clamp_add);
+
+  ATARI_NTSC_BEGIN_ROW(NTSC_black, line_in[0]);
+  ++line_in;
+
+  for(uInt32 n = chunk_count; n; --n)
+  {
+    __m128i* out = reinterpret_cast<__m128i*>(line_out);
+
+    ATARI_NTSC_COLOR_IN(0, line_in[0]);
+    _mm_storeu_si128(out, clampAndPackSSE2(
+        sumSSE2(kernel0, kernel1 + 17, kernelx0 + 7, kernelx1 + 24),
+        mask, add));
+
+    ATARI_NTSC_COLOR_IN(1, line_in[1]);
+    _mm_storeu_si128(out + 1, clampAndPackSSE2(
+        sumSSE2(kernel0 + 4, kernel1 + 14, kernelx0 + 11, kernelx1 + 21),
+        mask, add));
+
+    line_in += 2;
+    line_out += 7;
+  }
+
+  // finish final pixels
+  ATARI_NTSC_END_ROW(line_in, line_out);
+}
+#endif
+
+#ifdef ATARI_NTSC_AVX2
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+__attribute__((target("avx2")))
+static inline __m256i clampAndPackAVX2(__m256i raw, const __m256i mask, const __m256i add)
+{
+  // ATARI_NTSC_CLAMP_
+  const __m256i sub = _mm256_and_si256(_mm256_srli_epi32(raw, 9), mask);
+  __m256i clamp = _mm256_sub_epi32(add, sub);
+  raw = _mm256_or_si256(raw, clamp);
+  clamp = _mm256_sub_epi32(clamp, sub);
+  raw = _mm256_and_si256(raw, clamp);
+
+  // Convert to 8888 format
+  return _mm256_or_si256(_mm256_or_si256(
+      _mm256_and_si256(_mm256_srli_epi32(raw, 5), _mm256_set1_epi32(0x00FF0000)),
+      _mm256_and_si256(_mm256_srli_epi32(raw, 3), _mm256_set1_epi32(0x0000FF00))),
+      _mm256_and_si256(_mm256_srli_epi32(raw, 1), _mm256_set1_epi32(0x000000FF)));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+__attribute__((target("avx2")))
+void AtariNTSC::renderLineAVX2(const uInt8* line_in, const uInt32 chunk_count,
+  uInt32* restrict line_out) const
+{
+  const __m256i mask = _mm256_set1_epi32(atari_ntsc_clamp_mask);
+  const __m256i add  = _mm256_set1_epi32(atari_ntsc_clamp_add);
+
+  #define LOAD128(k) _mm_loadu_si128(reinterpret_cast<const __m128i*>(k))
+  #define LOAD256(k) _mm256_loadu_si256(reinterpret_cast<const __m256i*>(k))
+  #define LOAD2x128(lo, hi) \
+    _mm256_inserti128_si256(_mm256_castsi128_si256(LOAD128(lo)), LOAD128(hi), 1)
+
+  ATARI_NTSC_BEGIN_ROW(NTSC_black, line_in[0]);
+  ++line_in;
+
+  for(uInt32 n = chunk_count; n; --n)
+  {
+    // All seven pixels of the chunk are generated at once; the entries of
+    // 'kernel0' and 'kernelx0' are contiguous for both groups of pixels
+    ATARI_NTSC_COLOR_IN(0, line_in[0]);
+    uInt32 const* const kernel1_ = kernel1;
+    uInt32 const* const kernelx1_ = kernelx1;
+    ATARI_NTSC_COLOR_IN(1, line_in[1]);
+
+    const __m256i raw = _mm256_add_epi32(
+        _mm256_add_epi32(LOAD256(kernel0), LOAD2x128(kernel1_ + 17, kernel1 + 14)),
+        _mm256_add_epi32(LOAD256(kernelx0 + 7), LOAD2x128(kernelx1_ + 24, kernelx1 + 21)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(line_out), clampAndPackAVX2(raw, mask, add));
+
+    line_in += 2;
+    line_out += 7;
+  }
+
+  // finish final pixels
+  ATARI_NTSC_END_ROW(line_in, line_out);
+
+  #undef LOAD128
+  #undef LOAD256
+  #undef LOAD2x128
+}
+#endif
+
+#ifdef ATARI_NTSC_NEON
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static inline uint32x4_t clampAndPackNEON(uint32x4_t raw, const uint32x4_t mask, const uint32x4_t add)
+{
+  // ATARI_NTSC_CLAMP_
+  const uint32x4_t sub = vandq_u32(vshrq_n_u32(raw, 9), mask);
+  uint32x4_t clamp = vsubq_u32(add, sub);
+  raw = vorrq_u32(raw, clamp);
+  clamp = vsubq_u32(clamp, sub);
+  raw = vandq_u32(raw, clamp);
+
+  // Convert to 8888 format
+  return vorrq_u32(vorrq_u32(
+      vandq_u32(vshrq_n_u32(raw, 5), vdupq_n_u32(0x00FF0000)),
+      vandq_u32(vshrq_n_u32(raw, 3), vdupq_n_u32(0x0000FF00))),
+      vandq_u32(vshrq_n_u32(raw, 1), vdupq_n_u32(0x000000FF)));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static inline uint32x4_t sumNEON(const uInt32* k0, const uInt32* k1,
+                                 const uInt32* kx0, const uInt32* kx1)
+{
+  return vaddq_u32(vaddq_u32(vld1q_u32(k0), vld1q_u32(k1)),
+                   vaddq_u32(vld1q_u32(kx0), vld1q_u32(kx1)));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AtariNTSC::renderLineNEON(const uInt8* line_in, const uInt32 chunk_count,
+  uInt32* restrict line_out) const
+{
+  const uint32x4_t mask = vdupq_n_u32(atari_ntsc_clamp_mask);
+  const uint32x4_t add  = vdupq_n_u32(atari_ntsc_clamp_add);
+
+  ATARI_NTSC_BEGIN_ROW(NTSC_black, line_in[0]);
+  ++line_in;
+
+  for(uInt32 n = chunk_count; n; --n)
+  {
+    ATARI_NTSC_COLOR_IN(0, line_in[0]);
+    vst1q_u32(line_out, clampAndPackNEON(
+        sumNEON(kernel0, kernel1 + 17, kernelx0 + 7, kernelx1 + 24),
+        mask, add));
+
+    ATARI_NTSC_COLOR_IN(1, line_in[1]);
+    vst1q_u32(line_out + 4, clampAndPackNEON(
+        sumNEON(kernel0 + 4, kernel1 + 14, kernelx0 + 11, kernelx1 + 21),
+        mask, add));
+
+    line_in += 2;
+    line_out += 7;
+  }
+
+  // finish final pixels
+  ATARI_NTSC_END_ROW(line_in, line_out);
+}
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline uInt32 AtariNTSC::getRGBPhosphor(const uInt32 c, const uInt32 p) const
 {
@@ -41,6 +41,8 @@
 #define ATARI_NTSC_HXX
 
 #include <cmath>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 
 #include "bspf.hxx"
@@ -53,8 +55,14 @@ class AtariNTSC
       entry_size = 2 * 14,
     };
 
-    // By default, threading is turned off
-    AtariNTSC() { enableThreading(false); }
+    // Implementations of the filter kernel; they all produce exactly the
+    // same output, but the vectorized ones are (much) faster
+    enum class Kernel { Scalar, SSE2, AVX2, NEON };
+
+    // By default, threading is turned off, and the fastest kernel supported
+    // by the CPU is used
+    AtariNTSC();
+    ~AtariNTSC() { stopThreads(); }
 
     // Image parameters, ranging from -1.0 to 1.0. Actual internal values shown
     // in parenthesis and should remain fairly stable in future versions.
@@ -88,6 +96,15 @@ class AtariNTSC
     // Set up threading
     void enableThreading(bool enable);
 
+    // Select the kernel used for rendering
+    // Returns false (and keeps the current kernel) if it isn't supported
+    bool setKernel(Kernel kernel);
+    Kernel kernel() const { return myKernel; }
+
+    // Whether the given kernel is compiled in and supported by the CPU
+    static bool isKernelSupported(Kernel kernel);
+    static string kernelName(Kernel kernel);
+
     // Set phosphor palette, for use in Blargg + phosphor mode
     void setPhosphorPalette(uInt8 palette[256][256]) {
       memcpy(myPhosphorPalette, palette, 256 * 256);
@@ -115,12 +132,24 @@ class AtariNTSC
     }
 
   private:
+    // Worker thread handling; the threads are kept running between frames
+    void workerThread(const uInt32 threadNum, uInt32 frameCount);
+    void stopThreads();
+
     // Threaded rendering
     void renderThread(const uInt8* atari_in, const uInt32 in_width,
       const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, void* rgb_out, const uInt32 out_pitch);
     void renderWithPhosphorThread(const uInt8* atari_in, const uInt32 in_width,
       const uInt32 in_height, const uInt32 numThreads, const uInt32 threadNum, uInt32* rgb_in, void* rgb_out, const uInt32 out_pitch);
 
+    // Filter a single row of pixels, one method per kernel
+    // Only the kernels supported by the compiler are actually defined
+    using RenderLine = void (AtariNTSC::*)(const uInt8*, const uInt32, uInt32*) const;
+    void renderLine(const uInt8* line_in, const uInt32 chunk_count, uInt32* line_out) const;
+    void renderLineSSE2(const uInt8* line_in, const uInt32 chunk_count, uInt32* line_out) const;
+    void renderLineAVX2(const uInt8* line_in, const uInt32 chunk_count, uInt32* line_out) const;
+    void renderLineNEON(const uInt8* line_in, const uInt32 chunk_count, uInt32* line_out) const;
+
     /**
       Used to calculate an averaged color for the 'phosphor' effect.
 
@@ -170,11 +199,33 @@ class AtariNTSC
     uInt32 myColorTable[palette_size][entry_size];
     uInt8 myPhosphorPalette[256][256];
 
+    // The kernel currently used, and the method implementing it
+    Kernel myKernel;
+    RenderLine myRenderLine;
+
     // Rendering threads
     unique_ptr<std::thread[]> myThreads;
     // Number of rendering and total threads
     uInt32 myWorkerThreads, myTotalThreads;
 
+    // The frame the worker threads should currently render
+    struct RenderJob
+    {
+      const uInt8* atari_in;
+      uInt32 in_width, in_height;
+      void* rgb_out;
+      uInt32 out_pitch;
+      uInt32* rgb_in;
+    };
+    RenderJob myJob;
+
+    // Each new frame increments the frame count, which wakes up the
+    // worker threads; the last one to finish wakes up the main thread
+    std::mutex myMutex;
+    std::condition_variable myWorkAvailable, myWorkDone;
+    uInt32 myFrameCount, myPendingWorkers;
+    bool myQuitWorkers;
+
     struct init_t
     {
       float to_rgb [burst_count * 6];
@@ -230,6 +281,26 @@ class AtariNTSC
       rgb_out = (raw_>>5 & 0x00FF0000)|(raw_>>3 & 0x0000FF00)|(raw_>>1 & 0x000000FF);\
     }
 
+    // Finishes the row, after all input pixels have been read
+    #define ATARI_NTSC_END_ROW( line_in, line_out ) {\
+      ATARI_NTSC_COLOR_IN(0, line_in[0]);\
+      ATARI_NTSC_RGB_OUT_8888(0, line_out[0]);\
+      ATARI_NTSC_RGB_OUT_8888(1, line_out[1]);\
+      ATARI_NTSC_RGB_OUT_8888(2, line_out[2]);\
+      ATARI_NTSC_RGB_OUT_8888(3, line_out[3]);\
+      ATARI_NTSC_COLOR_IN(1, NTSC_black);\
+      ATARI_NTSC_RGB_OUT_8888(4, line_out[4]);\
+      ATARI_NTSC_RGB_OUT_8888(5, line_out[5]);\
+      ATARI_NTSC_RGB_OUT_8888(6, line_out[6]);\
+      ATARI_NTSC_COLOR_IN(0, NTSC_black);\
+      ATARI_NTSC_RGB_OUT_8888(0, line_out[7]);\
+      ATARI_NTSC_RGB_OUT_8888(1, line_out[8]);\
+      ATARI_NTSC_RGB_OUT_8888(2, line_out[9]);\
+      ATARI_NTSC_RGB_OUT_8888(3, line_out[10]);\
+      ATARI_NTSC_COLOR_IN(1, NTSC_black);\
+      ATARI_NTSC_RGB_OUT_8888(4, line_out[11]);\
+    }
+
     // Common ntsc macros
     #define atari_ntsc_clamp_mask     (rgb_builder * 3 / 2)
     #define atari_ntsc_clamp_add      (rgb_builder * 0x101)
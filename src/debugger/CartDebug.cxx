@@ -48,6 +48,7 @@ CartDebug::CartDebug(Debugger& dbg, Console& console, const OSystem& osystem)
     myOSystem(osystem),
     myDebugWidget(nullptr),
     myAddrToLineIsROM(true),
+    myDisassemblyBank(-1),
     myRWPortAddress(0),
     myLabelLength(8)   // longest pre-defined label
 {
@@ -85,6 +86,7 @@ CartDebug::CartDebug(Debugger& dbg, Console& console, const OSystem& osystem)
 
   info.size = 128;  // ZP RAM
   myBankInfo.push_back(info);
+  myDisassemblyCache.resize(myBankInfo.size());
 
   // We know the address for the startup bank right now
   myBankInfo[myConsole.cartridge().startBank()].addressList.push_front(
@@ -269,8 +271,8 @@ bool CartDebug::disassemble(bool force)
   if(changed)
   {
     // Are we disassembling from ROM or ZP RAM?
-    BankInfo& info = (PC & 0x1000) ? myBankInfo[getBank()] :
-        myBankInfo[myBankInfo.size()-1];
+    const int bank = (PC & 0x1000) ? getBank() : int(myBankInfo.size())-1;
+    BankInfo& info = myBankInfo[bank];
 
     // If the offset has changed, all old addresses must be 'converted'
     // For example, if the list contains any $fxxx and the address space is now
@@ -280,6 +282,28 @@ bool CartDebug::disassemble(bool force)
     for(auto& i: addresses)
       i = (i & 0xFFF) + offset;
 
+    // Forcing a disassembly means that something other than the banks
+    // themselves (labels, directives, settings) may have changed, so none
+    // of the previous results can be used anymore
+    // Otherwise, the results for this bank can be reused when its contents
+    // haven't changed since (ie, when stepping into another bank and back)
+    // In this case, the PC is already part of the disassembled code, so
+    // there's no need to add it as a new starting point
+    if(force)
+    {
+      for(auto& cache: myDisassemblyCache)
+        cache.reset();
+    }
+    else if(isCachedDisassemblyValid(bank, PC))
+    {
+      // Nothing changed when these results are already being used
+      if(bank == myDisassemblyBank)
+        return false;
+
+      loadCachedDisassembly(bank);
+      return true;
+    }
+
     // Only add addresses when absolutely necessary, to cut down on the
     // work that Distella has to do
     if(bankChanged || !pcfound)
@@ -305,6 +329,8 @@ bool CartDebug::disassemble(bool force)
       fillDisassemblyList(info, PC);
       DiStella::settings.resolveCode = true;
     }
+    if(info.addressList.size() > 0)
+      saveCachedDisassembly(bank);
   }
 
   return changed;
@@ -346,6 +372,79 @@ bool CartDebug::fillDisassemblyList(BankInfo& info, uInt16 search)
   return found;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartDebug::getBankImage(const BankInfo& info, ByteArray& image) const
+{
+  // These are the addresses Distella looks at (and in the same way)
+  const uInt32 start = info.offset + info.start, end = info.offset + info.end;
+
+  image.clear();
+  image.reserve((end - start + 1) * 2);
+  for(uInt32 address = start; address <= end; ++address)
+    image.push_back(mySystem.peek(address));
+  for(uInt32 address = start; address <= end; ++address)
+    image.push_back(mySystem.getAccessFlags(address));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CartDebug::isCachedDisassemblyValid(int bank, uInt16 search) const
+{
+  const CachedDisassembly* cache = myDisassemblyCache[bank].get();
+  if(cache == nullptr)
+    return false;
+
+  // Distella would disassemble from exactly the same addresses...
+  const BankInfo& info = myBankInfo[bank];
+  if(info.addressList != cache->addressList)
+    return false;
+
+  // ...and find the same code (and not the search address in a data area)
+  const auto& iter = cache->addrToLineList.find(search & 0xFFF);
+  if(iter == cache->addrToLineList.end() ||
+     cache->disassembly.list[iter->second].disasm[0] == '.')
+    return false;
+
+  // Checking the contents is the most expensive part, so do it last
+  ByteArray image;
+  getBankImage(info, image);
+
+  return image == cache->image;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartDebug::saveCachedDisassembly(int bank)
+{
+  unique_ptr<CachedDisassembly>& cache = myDisassemblyCache[bank];
+  if(!cache)
+    cache = make_unique<CachedDisassembly>();
+
+  // Distella may change the address list and access flags itself, so they
+  // must be stored as they are *after* the disassembly
+  const BankInfo& info = myBankInfo[bank];
+  getBankImage(info, cache->image);
+  cache->addressList = info.addressList;
+  cache->disassembly = myDisassembly;
+  cache->addrToLineList = myAddrToLineList;
+  memcpy(cache->labels, myDisLabels, sizeof(myDisLabels));
+  memcpy(cache->directives, myDisDirectives, sizeof(myDisDirectives));
+
+  myDisassemblyBank = bank;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartDebug::loadCachedDisassembly(int bank)
+{
+  const CachedDisassembly& cache = *myDisassemblyCache[bank];
+
+  myDisassembly = cache.disassembly;
+  myAddrToLineList = cache.addrToLineList;
+  myAddrToLineIsROM = myBankInfo[bank].offset & 0x1000;
+  memcpy(myDisLabels, cache.labels, sizeof(myDisLabels));
+  memcpy(myDisDirectives, cache.directives, sizeof(myDisDirectives));
+
+  myDisassemblyBank = bank;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int CartDebug::addressToLine(uInt16 address) const
 {
@@ -999,34 +1098,69 @@ string CartDebug::saveDisassembly()
   if(!out.is_open())
     return "Unable to save disassembly to " + node.getShortPath();
 
+  writeDisassembly(out, myOSystem.romFile(), false);
+
+  stringstream retVal;
+  if(myConsole.cartridge().bankCount() > 1)
+    retVal << DebuggerParser::red("disassembly for multi-bank ROM not fully supported, only currently enabled banks disassembled\n");
+  retVal << "saved " << node.getShortPath() << " OK";
+  return retVal.str();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartDebug::writeDisassembly(ostream& out, const FilesystemNode& rom,
+                                 bool switchBanks)
+{
 #define ALIGN(x) setfill(' ') << left << setw(x)
 
   // We can't print the header to the disassembly until it's actually
   // been processed; therefore buffer output to a string first
   ostringstream buf;
-  buf << "\n\n;***********************************************************\n"
-      << ";      Bank " << myConsole.cartridge().getBank();
-  if (myConsole.cartridge().bankCount() > 1)
-    buf << " / 0.." << myConsole.cartridge().bankCount() - 1;
-  buf << "\n;***********************************************************\n\n";
+  if(!switchBanks)
+  {
+    buf << "\n\n;***********************************************************\n"
+        << ";      Bank " << myConsole.cartridge().getBank();
+    if (myConsole.cartridge().bankCount() > 1)
+      buf << " / 0.." << myConsole.cartridge().bankCount() - 1;
+    buf << "\n;***********************************************************\n\n";
+  }
 
   // Use specific settings for disassembly output
   // This will most likely differ from what you see in the debugger
+  // These are taken from the settings instead of DiStella::settings (which
+  // always mirrors them), since the latter is shared by all consoles
   DiStella::Settings settings;
-  settings.gfxFormat = DiStella::settings.gfxFormat;
+  settings.gfxFormat =
+    myOSystem.settings().getInt("dis.gfxformat") == 16 ? Base::F_16 : Base::F_2;
   settings.resolveCode = true;
   settings.showAddresses = false;
   settings.aFlag = false; // Otherwise DASM gets confused
-  settings.fFlag = DiStella::settings.fFlag;
-  settings.rFlag = DiStella::settings.rFlag;
+  settings.fFlag = true;  // Not currently configurable
+  settings.rFlag = myOSystem.settings().getBool("dis.relocate");
   settings.bytesWidth = 8+1;  // same as Stella debugger
-  settings.bFlag = DiStella::settings.bFlag;; // process break routine (TODO)
+  settings.bFlag = true;  // process break routine (TODO)
 
   Disassembly disasm;
   disasm.list.reserve(2048);
+  const int currentBank = getBank();
   for(int bank = 0; bank < myConsole.cartridge().bankCount(); ++bank)
   {
     BankInfo& info = myBankInfo[bank];
+    if(switchBanks)
+    {
+      switchBank(bank);
+
+      // Unless this bank has been disassembled before, its reset vector
+      // is the only entry point we know of; the code executed so far
+      // (if any) is found by DiStella using the access flags
+      uInt16 start = myDebugger.dpeek(0xfffc);
+      if(info.addressList.size() == 0 && (start & 0x1000))
+        info.addressList.push_back(start);
+
+      buf << "\n\n;***********************************************************\n"
+          << ";      Bank " << bank << " / 0.." << myConsole.cartridge().bankCount() - 1
+          << "\n;***********************************************************\n\n";
+    }
     // An empty address list means that DiStella can't do a disassembly
     if(info.addressList.size() == 0)
       continue;
@@ -1098,12 +1232,23 @@ string CartDebug::saveDisassembly()
       buf << "\n";
     }
   }
+  if(switchBanks)
+    switchBank(currentBank);
 
   // Some boilerplate, similar to what DiStella adds
+  // The time is formatted like ctime() does, which isn't reentrant
   time_t currtime;
   time(&currtime);
-  out << "; Disassembly of " << myOSystem.romFile().getShortPath() << "\n"
-      << "; Disassembled " << ctime(&currtime)
+  struct tm timeinfo;
+#if defined(BSPF_WINDOWS)
+  localtime_s(&timeinfo, &currtime);
+#else
+  localtime_r(&currtime, &timeinfo);
+#endif
+  char timebuf[32];
+  strftime(timebuf, sizeof(timebuf), "%a %b %e %H:%M:%S %Y\n", &timeinfo);
+  out << "; Disassembly of " << rom.getShortPath() << "\n"
+      << "; Disassembled " << timebuf
       << "; Using Stella " << STELLA_VERSION << "\n;\n"
       << "; ROM properties name : " << myConsole.properties().get(Cartridge_Name) << "\n"
       << "; ROM properties MD5  : " << myConsole.properties().get(Cartridge_MD5) << "\n"
@@ -1226,12 +1371,36 @@ string CartDebug::saveDisassembly()
 
   // And finally, output the disassembly
   out << buf.str();
+}
 
-  stringstream retVal;
-  if(myConsole.cartridge().bankCount() > 1)
-    retVal << DebuggerParser::red("disassembly for multi-bank ROM not fully supported, only currently enabled banks disassembled\n");
-  retVal << "saved " << node.getShortPath() << " OK";
-  return retVal.str();
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartDebug::writeConfigFile(ostream& out, bool switchBanks)
+{
+  const string& name = myConsole.properties().get(Cartridge_Name);
+  const string& md5 = myConsole.properties().get(Cartridge_MD5);
+
+  // Store all bank information
+  out << "//Stella.pro: \"" << name << "\"" << endl
+      << "//MD5: " << md5 << endl
+      << endl;
+  const int currentBank = getBank();
+  for(uInt32 b = 0; b < myConsole.cartridge().bankCount(); ++b)
+  {
+    if(switchBanks)
+      switchBank(b);
+    out << "[" << b << "]" << endl;
+    getBankDirectives(out, myBankInfo[b]);
+  }
+  if(switchBanks)
+    switchBank(currentBank);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartDebug::switchBank(int bank)
+{
+  myDebugger.unlockBankswitchState();
+  myConsole.cartridge().bank(bank);
+  myDebugger.lockBankswitchState();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -20,6 +20,7 @@
 
 class Settings;
 class CartDebugWidget;
+class FilesystemNode;
 
 // Function type for CartDebug instance methods
 class CartDebug;
@@ -241,6 +242,22 @@ class CartDebug : public DebuggerSystem
     string saveDisassembly();
     string saveRom();
 
+    /**
+      Write the disassembly / the Distella directives of all banks to the
+      given stream, in the same format as 'saveDisassembly' and
+      'saveConfigFile'.
+
+      @param rom          The ROM file (only mentioned in the header)
+      @param switchBanks  Switch each bank into the cart address space
+                          before processing it; otherwise every bank is
+                          processed using the current one.  The
+                          bankswitch state must be locked; the current
+                          bank is restored afterwards.
+    */
+    void writeDisassembly(ostream& out, const FilesystemNode& rom,
+                          bool switchBanks);
+    void writeConfigFile(ostream& out, bool switchBanks);
+
     /**
       Show Distella directives (both set by the user and determined by Distella)
       for the given bank (or all banks, if no bank is specified).
@@ -304,6 +321,33 @@ class CartDebug : public DebuggerSystem
     // Return whether the search address was actually in the list
     bool fillDisassemblyList(BankInfo& bankinfo, uInt16 search);
 
+    // The results of the most recent disassembly of a bank, along with
+    // everything Distella used to generate them
+    // As long as the contents and access flags of the bank don't change,
+    // the results can be reused without running Distella again
+    struct CachedDisassembly {
+      ByteArray image;           // contents, followed by access flags
+      AddressList addressList;
+      Disassembly disassembly;
+      std::map<uInt16, int> addrToLineList;
+      uInt8 labels[0x1000], directives[0x1000];
+    };
+
+    // Get the current contents and access flags of the given bank
+    void getBankImage(const BankInfo& info, ByteArray& image) const;
+
+    // Answer whether the cached results for the given bank are still
+    // valid, and contain the search address
+    bool isCachedDisassemblyValid(int bank, uInt16 search) const;
+
+    // Store/use the results of the current disassembly for the given bank
+    void saveCachedDisassembly(int bank);
+    void loadCachedDisassembly(int bank);
+
+    // Switch the given bank into the cart address space, while keeping
+    // the bankswitch state locked
+    void switchBank(int bank);
+
     // Analyze of bank of ROM, generating a list of Distella directives
     // based on its disassembly
     void getBankDirectives(ostream& buf, BankInfo& info) const;
@@ -335,6 +379,11 @@ class CartDebug : public DebuggerSystem
     std::map<uInt16, int> myAddrToLineList;
     bool myAddrToLineIsROM;
 
+    // The most recent disassembly of each bank (created when first needed),
+    // and the bank the current disassembly belongs to (-1 if unknown)
+    vector<unique_ptr<CachedDisassembly>> myDisassemblyCache;
+    int myDisassemblyBank;
+
     // Mappings from label to address (and vice versa) for items
     // defined by the user (either through a DASM symbol file or manually
     // from the commandline in the debugger)
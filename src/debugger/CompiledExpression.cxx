@@ -0,0 +1,280 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Debugger.hxx"
+#include "CompiledExpression.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Expression::compile(CompiledExpression& c) const
+{
+  // Expressions without a compiled form are evaluated through the tree
+  c.emitEvaluate(*this);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+CompiledExpression::CompiledExpression(Expression* tree)
+  : Expression(tree),
+    myDepth(0),
+    myMaxDepth(0)
+{
+  myLHS->compile(*this);
+  myStack.resize(myMaxDepth);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 CompiledExpression::evaluate() const
+{
+  Debugger& debugger = Debugger::debugger();
+  Int32* sp = myStack.data();  // points past the top of the stack
+
+  for(uInt32 pc = 0; pc < myProgram.size(); ++pc)
+  {
+    const Operation& operation = myProgram[pc];
+
+    switch(operation.op)
+    {
+      case Op::Const:
+        *sp++ = operation.value;
+        break;
+
+      case Op::Evaluate:
+        *sp++ = operation.expression->evaluate();
+        break;
+
+      case Op::CpuMethod:
+        *sp++ = (debugger.cpuDebug().*operation.cpuMethod)();
+        break;
+
+      case Op::TiaMethod:
+        *sp++ = (debugger.tiaDebug().*operation.tiaMethod)();
+        break;
+
+      case Op::CartMethod:
+        *sp++ = (debugger.cartDebug().*operation.cartMethod)();
+        break;
+
+      case Op::ByteDeref:
+        sp[-1] = debugger.peek(sp[-1]);
+        break;
+
+      case Op::WordDeref:
+        sp[-1] = debugger.dpeekAsInt(sp[-1]);
+        break;
+
+      case Op::Neg:
+      case Op::BinNot:
+      case Op::LogNot:
+      case Op::HiByte:
+      case Op::LoByte:
+      case Op::Bool:
+        sp[-1] = apply(operation.op, sp[-1]);
+        break;
+
+      case Op::ByteDerefOffset:
+        --sp;
+        sp[-1] = debugger.peek(sp[-1] + sp[0]);
+        break;
+
+      case Op::LogAndJump:
+        if(sp[-1] == 0)  // result is 0, already on the stack
+          pc = operation.value - 1;
+        else
+          --sp;
+        break;
+
+      case Op::LogOrJump:
+        if(sp[-1] != 0)  // result is 1
+        {
+          sp[-1] = 1;
+          pc = operation.value - 1;
+        }
+        else
+          --sp;
+        break;
+
+      default:  // binary operators
+        --sp;
+        sp[-1] = apply(operation.op, sp[-1], sp[0]);
+        break;
+    }
+  }
+
+  return myStack[0];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Int32 CompiledExpression::apply(Op op, Int32 lhs, Int32 rhs)
+{
+  switch(op)
+  {
+    case Op::Neg:           return -lhs;
+    case Op::BinNot:        return ~lhs;
+    case Op::LogNot:        return !lhs;
+    case Op::HiByte:        return 0xff & (lhs >> 8);
+    case Op::LoByte:        return 0xff & lhs;
+    case Op::Bool:          return lhs != 0;
+    case Op::Add:           return lhs + rhs;
+    case Op::Sub:           return lhs - rhs;
+    case Op::Mul:           return lhs * rhs;
+    case Op::Div:           return rhs == 0 ? 0 : lhs / rhs;
+    case Op::Mod:           return rhs == 0 ? 0 : lhs % rhs;
+    case Op::BinAnd:        return lhs & rhs;
+    case Op::BinOr:         return lhs | rhs;
+    case Op::BinXor:        return lhs ^ rhs;
+    case Op::ShiftLeft:     return lhs << rhs;
+    case Op::ShiftRight:    return lhs >> rhs;
+    case Op::Equals:        return lhs == rhs;
+    case Op::NotEquals:     return lhs != rhs;
+    case Op::Less:          return lhs < rhs;
+    case Op::LessEquals:    return lhs <= rhs;
+    case Op::Greater:       return lhs > rhs;
+    case Op::GreaterEquals: return lhs >= rhs;
+    default:                return 0;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emit(Op op, Int32 value)
+{
+  Operation operation;
+  operation.op = op;
+  operation.value = value;
+  operation.expression = nullptr;
+  myProgram.push_back(operation);
+
+  // Track the stack depth needed for evaluation
+  switch(op)
+  {
+    case Op::Const:
+    case Op::Evaluate:
+    case Op::CpuMethod:
+    case Op::TiaMethod:
+    case Op::CartMethod:
+      myMaxDepth = std::max(myMaxDepth, ++myDepth);
+      break;
+
+    case Op::ByteDeref:
+    case Op::WordDeref:
+    case Op::Neg:
+    case Op::BinNot:
+    case Op::LogNot:
+    case Op::HiByte:
+    case Op::LoByte:
+    case Op::Bool:
+      break;
+
+    default:  // binary operators, and jumps (which drop the left operand)
+      --myDepth;
+      break;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitConst(Int32 value)
+{
+  emit(Op::Const, value);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitEvaluate(const Expression& expression)
+{
+  emit(Op::Evaluate);
+  myProgram.back().expression = &expression;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitMethod(CpuMethod method)
+{
+  emit(Op::CpuMethod);
+  myProgram.back().cpuMethod = method;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitMethod(TiaMethod method)
+{
+  emit(Op::TiaMethod);
+  myProgram.back().tiaMethod = method;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitMethod(CartMethod method)
+{
+  emit(Op::CartMethod);
+  myProgram.back().cartMethod = method;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitUnary(Op op, const Expression& operand)
+{
+  const uInt32 start = uInt32(myProgram.size());
+  operand.compile(*this);
+
+  if(isFoldable(op) && isConst(start))
+    myProgram.back().value = apply(op, myProgram.back().value);
+  else
+    emit(op);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitBinary(Op op, const Expression& lhs, const Expression& rhs)
+{
+  const uInt32 start = uInt32(myProgram.size());
+  lhs.compile(*this);
+  const bool lhsConst = isConst(start);
+  const uInt32 middle = uInt32(myProgram.size());
+  rhs.compile(*this);
+
+  if(isFoldable(op) && lhsConst && isConst(middle))
+  {
+    const Int32 value = apply(op, myProgram[start].value, myProgram[middle].value);
+    myProgram.pop_back();
+    --myDepth;
+    myProgram.back().value = value;
+  }
+  else
+    emit(op);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompiledExpression::emitLogical(Op op, const Expression& lhs, const Expression& rhs)
+{
+  const uInt32 start = uInt32(myProgram.size());
+  lhs.compile(*this);
+
+  if(isConst(start))
+  {
+    // The left operand either determines the result, or the result is
+    // the right operand (as a boolean)
+    const Int32 value = myProgram.back().value;
+    myProgram.pop_back();
+    --myDepth;
+
+    if(op == Op::LogAndJump && value == 0)
+      emitConst(0);
+    else if(op == Op::LogOrJump && value != 0)
+      emitConst(1);
+    else
+      emitUnary(Op::Bool, rhs);
+  }
+  else
+  {
+    const uInt32 jump = uInt32(myProgram.size());
+    emit(op);
+    emitUnary(Op::Bool, rhs);
+    myProgram[jump].value = Int32(myProgram.size());
+  }
+}
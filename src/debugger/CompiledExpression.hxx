@@ -0,0 +1,123 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef COMPILED_EXPRESSION_HXX
+#define COMPILED_EXPRESSION_HXX
+
+#include "bspf.hxx"
+#include "CartDebug.hxx"
+#include "CpuDebug.hxx"
+#include "TIADebug.hxx"
+#include "Expression.hxx"
+
+/**
+  This class wraps an expression tree, and evaluates it from a flat list
+  of operations (executed on a small value stack) instead of walking the
+  tree through virtual calls.  Constant subexpressions are folded when
+  the expression is compiled.
+
+  It is used for expressions which are evaluated very often, like the
+  conditions of 'breakif', 'savestateif' and 'trapif', which are checked
+  for each executed instruction.
+
+  @author  Stephen Anthony
+*/
+class CompiledExpression : public Expression
+{
+  public:
+    /**
+      The supported operations; those taking operands pop them from the
+      stack, and all of them push their result.
+    */
+    enum class Op: uInt8 {
+      // Leaf values
+      Const, Evaluate, CpuMethod, TiaMethod, CartMethod,
+      // Unary operators
+      ByteDeref, WordDeref, Neg, BinNot, LogNot, HiByte, LoByte, Bool,
+      // Binary operators
+      ByteDerefOffset, Add, Sub, Mul, Div, Mod, BinAnd, BinOr, BinXor, ShiftLeft, ShiftRight,
+      Equals, NotEquals, Less, LessEquals, Greater, GreaterEquals,
+      // Short-circuit logical operators; jump to the given target if the
+      // operand already determines the result
+      LogAndJump, LogOrJump
+    };
+
+  public:
+    /**
+      Compile the given expression tree (which is owned by this object).
+    */
+    explicit CompiledExpression(Expression* tree);
+    virtual ~CompiledExpression() = default;
+
+    Int32 evaluate() const override;
+
+    /**
+      Methods used by Expression::compile() to emit the operations for
+      an expression node.
+    */
+    void emitConst(Int32 value);
+    void emitEvaluate(const Expression& expression);
+    void emitMethod(CpuMethod method);
+    void emitMethod(TiaMethod method);
+    void emitMethod(CartMethod method);
+    void emitUnary(Op op, const Expression& operand);
+    void emitBinary(Op op, const Expression& lhs, const Expression& rhs);
+    void emitLogical(Op op, const Expression& lhs, const Expression& rhs);
+
+  private:
+    struct Operation {
+      Op op;
+      Int32 value;  // Constant value or jump target
+      union {
+        const Expression* expression;
+        CpuMethod cpuMethod;
+        TiaMethod tiaMethod;
+        CartMethod cartMethod;
+      };
+    };
+
+    // Compute the result of a unary or binary operator; dereferencing
+    // operators are never folded, so they aren't handled here
+    static Int32 apply(Op op, Int32 lhs, Int32 rhs = 0);
+    static bool isFoldable(Op op) {
+      return op != Op::ByteDeref && op != Op::WordDeref && op != Op::ByteDerefOffset;
+    }
+
+    // Answer whether the operations starting at 'start' are just a constant
+    bool isConst(uInt32 start) const {
+      return myProgram.size() == start + 1 && myProgram[start].op == Op::Const;
+    }
+
+    void emit(Op op, Int32 value = 0);
+
+  private:
+    vector<Operation> myProgram;
+
+    // Stack for evaluation, and its current and maximum depth during compile
+    mutable vector<Int32> myStack;
+    uInt32 myDepth, myMaxDepth;
+
+  private:
+    // Following constructors and assignment operators not supported
+    CompiledExpression() = delete;
+    CompiledExpression(const CompiledExpression&) = delete;
+    CompiledExpression(CompiledExpression&&) = delete;
+    CompiledExpression& operator=(const CompiledExpression&) = delete;
+    CompiledExpression& operator=(CompiledExpression&&) = delete;
+};
+
+#endif
@@ -49,6 +49,7 @@
 
 #include "RomWidget.hxx"
 #include "Expression.hxx"
+#include "CompiledExpression.hxx"
 #include "PackedBitArray.hxx"
 #include "YaccParser.hxx"
 
@@ -85,6 +86,9 @@ Debugger::Debugger(OSystem& osystem, Console& console)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Debugger::~Debugger()
 {
+  // Don't leave a dangling pointer behind
+  if(myStaticDebugger == this)
+    myStaticDebugger = nullptr;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -646,7 +650,7 @@ void Debugger::setQuitState()
 bool Debugger::addFunction(const string& name, const string& definition,
                            Expression* exp, bool builtin)
 {
-  myFunctions.emplace(name, unique_ptr<Expression>(exp));
+  myFunctions.emplace(name, make_unique<CompiledExpression>(exp));
   myFunctionDefs.emplace(name, definition);
 
   return true;
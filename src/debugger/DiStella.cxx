@@ -167,7 +167,7 @@ FIX_LAST:
         mark(myPC + myOffset, CartDebug::VALID_ENTRY);
 
       // get opcode
-      opcode = Debugger::debugger().peek(myPC + myOffset);
+      opcode = myDbg.myDebugger.peek(myPC + myOffset);
       // get address mode for opcode
       addrMode = ourLookup[opcode].addr_mode;
 
@@ -192,7 +192,7 @@ FIX_LAST:
           // the opcode's operand address matches a label address
           if (pass == 3) {
             // output the byte of the opcode incl. cycles
-            Uint8 nextOpcode = Debugger::debugger().peek(myPC + myOffset);
+            Uint8 nextOpcode = myDbg.myDebugger.peek(myPC + myOffset);
 
             cycles += int(ourLookup[opcode].cycles) - int(ourLookup[nextOpcode].cycles);
             nextLine << ".byte   $" << Base::HEX2 << int(opcode) << " ;";
@@ -252,7 +252,7 @@ FIX_LAST:
                 else
                   myDisasmBuf << Base::HEX4 << myPC + myOffset << "'     '";
 
-                opcode = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+                opcode = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
                 myDisasmBuf << ".byte $" << Base::HEX2 << int(opcode) << "              $"
                   << Base::HEX4 << myPC + myOffset << "'"
                   << Base::HEX2 << int(opcode);
@@ -300,7 +300,7 @@ FIX_LAST:
 
         case ABSOLUTE:
         {
-          ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+          ad = myDbg.myDebugger.dpeek(myPC + myOffset);  myPC += 2;
           labelFound = mark(ad, CartDebug::REFERENCED);
           if (pass == 3) {
             if (ad < 0x100 && mySettings.fFlag)
@@ -330,7 +330,7 @@ FIX_LAST:
 
         case ZERO_PAGE:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
           labelFound = mark(d1, CartDebug::REFERENCED);
           if (pass == 3) {
             nextLine << "     ";
@@ -342,7 +342,7 @@ FIX_LAST:
 
         case IMMEDIATE:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
           if (pass == 3) {
             nextLine << "     #$" << Base::HEX2 << int(d1) << " ";
             nextLineBytes << Base::HEX2 << int(d1);
@@ -352,7 +352,7 @@ FIX_LAST:
 
         case ABSOLUTE_X:
         {
-          ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+          ad = myDbg.myDebugger.dpeek(myPC + myOffset);  myPC += 2;
           labelFound = mark(ad, CartDebug::REFERENCED);
           if (pass == 2 && !checkBit(ad & myAppData.end, CartDebug::CODE)) {
             // Since we can't know what address is being accessed unless we also
@@ -391,7 +391,7 @@ FIX_LAST:
 
         case ABSOLUTE_Y:
         {
-          ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+          ad = myDbg.myDebugger.dpeek(myPC + myOffset);  myPC += 2;
           labelFound = mark(ad, CartDebug::REFERENCED);
           if (pass == 2 && !checkBit(ad & myAppData.end, CartDebug::CODE)) {
             // Since we can't know what address is being accessed unless we also
@@ -430,7 +430,7 @@ FIX_LAST:
 
         case INDIRECT_X:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
           if (pass == 3) {
             labelFound = mark(d1, 0);  // dummy call to get address type
             nextLine << "     (";
@@ -443,7 +443,7 @@ FIX_LAST:
 
         case INDIRECT_Y:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
           if (pass == 3) {
             labelFound = mark(d1, 0);  // dummy call to get address type
             nextLine << "     (";
@@ -456,7 +456,7 @@ FIX_LAST:
 
         case ZERO_PAGE_X:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
           labelFound = mark(d1, CartDebug::REFERENCED);
           if (pass == 3) {
             nextLine << "     ";
@@ -469,7 +469,7 @@ FIX_LAST:
 
         case ZERO_PAGE_Y:
         {
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
           labelFound = mark(d1, CartDebug::REFERENCED);
           if (pass == 3) {
             nextLine << "     ";
@@ -485,7 +485,7 @@ FIX_LAST:
           // SA - 04-06-2010: there seemed to be a bug in distella,
           // where wraparound occurred on a 32-bit int, and subsequent
           // indexing into the labels array caused a crash
-          d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+          d1 = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
           ad = ((myPC + Int8(d1)) & 0xfff) + myOffset;
 
           labelFound = mark(ad, CartDebug::REFERENCED);
@@ -503,7 +503,7 @@ FIX_LAST:
 
         case ABS_INDIRECT:
         {
-          ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+          ad = myDbg.myDebugger.dpeek(myPC + myOffset);  myPC += 2;
           labelFound = mark(ad, CartDebug::REFERENCED);
           if (pass == 2 && !checkBit(ad & myAppData.end, CartDebug::CODE)) {
             // Since we can't know what address is being accessed unless we also
@@ -610,10 +610,10 @@ void DiStella::disasmPass1(CartDebug::AddressList& debuggerAddresses)
       for (uInt32 k = pcBeg; k <= myPCEnd; k++) {
         if (checkBits(k, CartDebug::CartDebug::DATA | CartDebug::GFX | CartDebug::PGFX,
                       CartDebug::CODE)) {
-          //if (Debugger::debugger().getAccessFlags(k) &
+          //if (myDbg.myDebugger.getAccessFlags(k) &
           //    (CartDebug::DATA | CartDebug::GFX | CartDebug::PGFX)) {
           // TODO: this should never happen, remove when we are sure
-          // TODO: NOT USED: uInt8 flags = Debugger::debugger().getAccessFlags(k);
+          // TODO: NOT USED: uInt8 flags = myDbg.myDebugger.getAccessFlags(k);
           myPCEnd = k - 1;
           break;
         }
@@ -649,7 +649,7 @@ void DiStella::disasmPass1(CartDebug::AddressList& debuggerAddresses)
     // Stella itself can provide hints on whether an address has ever
     // been referenced as CODE
     while (myAddressQueue.empty() && codeAccessPoint <= myAppData.end) {
-      if ((Debugger::debugger().getAccessFlags(codeAccessPoint + myOffset) & CartDebug::CODE)
+      if ((myDbg.myDebugger.getAccessFlags(codeAccessPoint + myOffset) & CartDebug::CODE)
           && !(myLabels[codeAccessPoint & myAppData.end] & CartDebug::CODE)) {
         myAddressQueue.push(codeAccessPoint + myOffset);
         ++codeAccessPoint;
@@ -663,9 +663,9 @@ void DiStella::disasmPass1(CartDebug::AddressList& debuggerAddresses)
   for (int k = 0; k <= myAppData.end; k++) {
     // Let the emulation core know about tentative code
     if (checkBit(k, CartDebug::CODE) &&
-      !(Debugger::debugger().getAccessFlags(k + myOffset) & CartDebug::CODE)
+      !(myDbg.myDebugger.getAccessFlags(k + myOffset) & CartDebug::CODE)
       && myOffset != 0) {
-      Debugger::debugger().setAccessFlags(k + myOffset, CartDebug::TCODE);
+      myDbg.myDebugger.setAccessFlags(k + myOffset, CartDebug::TCODE);
     }
 
     // Must be ROW / unused bytes
@@ -694,7 +694,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
 
     // so this should be code now...
     // get opcode
-    opcode = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+    opcode = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
     // get address mode for opcode
     addrMode = ourLookup[opcode].addr_mode;
 
@@ -730,7 +730,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
     // Add operand(s)
     switch (addrMode) {
       case ABSOLUTE:
-        ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+        ad = myDbg.myDebugger.dpeek(myPC + myOffset);  myPC += 2;
         mark(ad, CartDebug::REFERENCED);
         // handle JMP/JSR
         if (ourLookup[opcode].source == M_ADDR) {
@@ -745,7 +745,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
         break;
 
       case ZERO_PAGE:
-        d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+        d1 = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
         mark(d1, CartDebug::REFERENCED);
         break;
 
@@ -754,12 +754,12 @@ void DiStella::disasmFromAddress(uInt32 distart)
         break;
 
       case ABSOLUTE_X:
-        ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+        ad = myDbg.myDebugger.dpeek(myPC + myOffset);  myPC += 2;
         mark(ad, CartDebug::REFERENCED);
         break;
 
       case ABSOLUTE_Y:
-        ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+        ad = myDbg.myDebugger.dpeek(myPC + myOffset);  myPC += 2;
         mark(ad, CartDebug::REFERENCED);
         break;
 
@@ -772,12 +772,12 @@ void DiStella::disasmFromAddress(uInt32 distart)
         break;
 
       case ZERO_PAGE_X:
-        d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+        d1 = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
         mark(d1, CartDebug::REFERENCED);
         break;
 
       case ZERO_PAGE_Y:
-        d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+        d1 = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
         mark(d1, CartDebug::REFERENCED);
         break;
 
@@ -785,7 +785,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
         // SA - 04-06-2010: there seemed to be a bug in distella,
         // where wraparound occurred on a 32-bit int, and subsequent
         // indexing into the labels array caused a crash
-        d1 = Debugger::debugger().peek(myPC + myOffset);  myPC++;
+        d1 = myDbg.myDebugger.peek(myPC + myOffset);  myPC++;
         ad = ((myPC + Int8(d1)) & 0xfff) + myOffset;
         mark(ad, CartDebug::REFERENCED);
         // do NOT use flags set by debugger, else known CODE will not analyzed statically.
@@ -796,7 +796,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
         break;
 
       case ABS_INDIRECT:
-        ad = Debugger::debugger().dpeek(myPC + myOffset);  myPC += 2;
+        ad = myDbg.myDebugger.dpeek(myPC + myOffset);  myPC += 2;
         mark(ad, CartDebug::REFERENCED);
         break;
 
@@ -806,7 +806,7 @@ void DiStella::disasmFromAddress(uInt32 distart)
 
     // mark BRK vector
     if (opcode == 0x00) {
-      ad = Debugger::debugger().dpeek(0xfffe, CartDebug::DATA);
+      ad = myDbg.myDebugger.dpeek(0xfffe, CartDebug::DATA);
       if (!myReserved.breakFound) {
         myAddressQueue.push(ad);
         mark(ad, CartDebug::CODE);
@@ -907,7 +907,7 @@ bool DiStella::checkBit(uInt16 address, uInt8 mask, bool useDebugger) const
   uInt8 label = myLabels[address & myAppData.end],
     lastbits = label & 0x03,
     directive = myDirectives[address & myAppData.end] & 0xFC,
-    debugger = Debugger::debugger().getAccessFlags(address | myOffset) & 0xFC;
+    debugger = myDbg.myDebugger.getAccessFlags(address | myOffset) & 0xFC;
 
   // Any address marked by a manual directive always takes priority
   if (directive)
@@ -995,10 +995,10 @@ void DiStella::addEntry(CartDebug::DisasmType type)
       // but it could also indicate that code will *never* be accessed
       // Since it is impossible to tell the difference, marking the address
       // in the disassembly at least tells the user about it
-      if (!(Debugger::debugger().getAccessFlags(tag.address) & CartDebug::CODE)
+      if (!(myDbg.myDebugger.getAccessFlags(tag.address) & CartDebug::CODE)
           && myOffset != 0) {
         tag.ccount += " *";
-        Debugger::debugger().setAccessFlags(tag.address, CartDebug::TCODE);
+        myDbg.myDebugger.setAccessFlags(tag.address, CartDebug::TCODE);
       }
       break;
     case CartDebug::GFX:
@@ -1030,7 +1030,7 @@ void DiStella::outputGraphics()
 {
   bool isPGfx = checkBit(myPC, CartDebug::PGFX);
   const string& bitString = isPGfx ? "\x1f" : "\x1e";
-  uInt8 byte = Debugger::debugger().peek(myPC + myOffset);
+  uInt8 byte = myDbg.myDebugger.peek(myPC + myOffset);
 
   // add extra spacing line when switching from non-graphics to graphics
   if (mySegType != CartDebug::GFX && mySegType != CartDebug::NONE) {
@@ -1078,14 +1078,14 @@ void DiStella::outputBytes(CartDebug::DisasmType type)
 
       myDisasmBuf << Base::HEX4 << myPC + myOffset << "'L" << Base::HEX4
         << myPC + myOffset << "'.byte " << "$" << Base::HEX2
-        << int(Debugger::debugger().peek(myPC + myOffset));
+        << int(myDbg.myDebugger.peek(myPC + myOffset));
       myPC++;
       numBytes = 1;
       lineEmpty = false;
     } else if (lineEmpty) {
       // start a new line without a label
       myDisasmBuf << Base::HEX4 << myPC + myOffset << "'     '"
-        << ".byte $" << Base::HEX2 << int(Debugger::debugger().peek(myPC + myOffset));
+        << ".byte $" << Base::HEX2 << int(myDbg.myDebugger.peek(myPC + myOffset));
       myPC++;
       numBytes = 1;
       lineEmpty = false;
@@ -1095,7 +1095,7 @@ void DiStella::outputBytes(CartDebug::DisasmType type)
       addEntry(type);
       lineEmpty = true;
     } else {
-      myDisasmBuf << ",$" << Base::HEX2 << int(Debugger::debugger().peek(myPC + myOffset));
+      myDisasmBuf << ",$" << Base::HEX2 << int(myDbg.myDebugger.peek(myPC + myOffset));
       myPC++;
     }
     isType = checkBits(myPC, type,
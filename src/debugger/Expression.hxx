@@ -20,6 +20,8 @@
 
 #include "bspf.hxx"
 
+class CompiledExpression;
+
 /**
   This class provides an implementation of an expression node, which
   is a construct that is given two other expressions and evaluates and
@@ -37,6 +39,13 @@ class Expression
 
     virtual Int32 evaluate() const { return 0; }
 
+    /**
+      Append the operations computing this expression to the given
+      compiled expression (see CompiledExpression).  By default, the
+      expression is evaluated as a whole.
+    */
+    virtual void compile(CompiledExpression& c) const;
+
   protected:
     unique_ptr<Expression> myLHS, myRHS;
 
@@ -0,0 +1,152 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Base.hxx"
+#include "Console.hxx"
+#include "FSNode.hxx"
+#include "Font.hxx"
+#include "OSystem.hxx"
+#include "Props.hxx"
+#include "StringListWidget.hxx"
+#include "Thumbulator.hxx"
+#include "Widget.hxx"
+#include "ArmProfileWidget.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ArmProfileWidget::ArmProfileWidget(
+      GuiObject* boss, const GUI::Font& lfont, const GUI::Font& nfont,
+      int x, int y, int w, int h, Thumbulator& arm)
+  : Widget(boss, lfont, x, y, w, h),
+    CommandSender(boss),
+    myArm(arm)
+{
+  const int fontWidth  = lfont.getMaxCharWidth(),
+            fontHeight = lfont.getFontHeight(),
+            lineHeight = lfont.getLineHeight(),
+            buttonWidth = lfont.getStringWidth("Reset") + 20,
+            buttonHeight = lineHeight + 4;
+  int xpos = 2, ypos = 5;
+
+  myEnable = new CheckboxWidget(boss, lfont, xpos, ypos + 2,
+                                "Collect ARM profile", kProfileCmd);
+  myEnable->setTarget(this);
+  addFocusWidget(myEnable);
+  xpos += myEnable->getWidth() + fontWidth * 2;
+
+  myReset = new ButtonWidget(boss, lfont, xpos, ypos, buttonWidth, buttonHeight,
+                             "Reset", kResetCmd);
+  myReset->setTarget(this);
+  addFocusWidget(myReset);
+  xpos += buttonWidth + 8;
+
+  mySave = new ButtonWidget(boss, lfont, xpos, ypos, buttonWidth, buttonHeight,
+                            "Save", kSaveCmd);
+  mySave->setTarget(this);
+  addFocusWidget(mySave);
+  ypos += buttonHeight + 6;
+
+  mySummary = new StaticTextWidget(boss, lfont, 2, ypos, w - 4, fontHeight,
+                                   "", TextAlign::Left);
+  ypos += lineHeight + 4;
+
+  new StaticTextWidget(boss, nfont, 2, ypos, w - 4, fontHeight,
+                       " Function     Calls  Instructions        Cycles      %",
+                       TextAlign::Left);
+  ypos += lineHeight;
+
+  myFunctions = new StringListWidget(boss, nfont, 2, ypos, w - 4, h - ypos - 4,
+                                     false);
+  myFunctions->setEditable(false);
+  addFocusWidget(myFunctions);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ArmProfileWidget::loadConfig()
+{
+  using std::setw;
+
+  const bool enabled = myArm.isProfiling();
+  myEnable->setState(enabled);
+  myReset->setEnabled(enabled);
+  mySave->setEnabled(enabled);
+
+  const Thumbulator::FunctionProfileList& functions = myArm.functionProfile();
+  uInt64 instructions = 0, cycles = 0;
+  for(const auto& f: functions)
+  {
+    instructions += f.instructions;
+    cycles += f.cycles;
+  }
+
+  StringList rows;
+  for(const auto& f: functions)
+  {
+    ostringstream buf;
+    buf << " " << Common::Base::HEX8 << f.address << std::dec << std::setfill(' ')
+        << setw(10) << f.calls << setw(14) << f.instructions
+        << setw(14) << f.cycles << setw(7) << std::fixed << std::setprecision(1)
+        << (cycles ? 100.0 * f.cycles / cycles : 0.0);
+    rows.push_back(buf.str());
+  }
+  myFunctions->setList(rows);
+
+  ostringstream buf;
+  if(enabled)
+    buf << functions.size() << " functions, " << instructions
+        << " instructions, " << cycles << " cycles (estimated)";
+  else
+    buf << "Profiling is disabled";
+  mySummary->setLabel(buf.str());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ArmProfileWidget::handleCommand(CommandSender* sender, int cmd, int data, int id)
+{
+  switch(cmd)
+  {
+    case kProfileCmd:
+      myArm.enableProfiling(myEnable->getState());
+      loadConfig();
+      break;
+
+    case kResetCmd:
+      myArm.resetProfile();
+      loadConfig();
+      break;
+
+    case kSaveCmd:
+      saveProfile();
+      break;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ArmProfileWidget::saveProfile()
+{
+  const string& name =
+    instance().console().properties().get(Cartridge_Name) + ".armprofile.txt";
+  FilesystemNode node(instance().defaultSaveDir() + name);
+
+  ofstream out(node.getPath());
+  if(out.is_open())
+  {
+    myArm.dumpProfile(out);
+    mySummary->setLabel("Saved profile to " + node.getShortPath());
+  }
+  else
+    mySummary->setLabel("Unable to save profile to " + node.getShortPath());
+}
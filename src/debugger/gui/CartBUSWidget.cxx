@@ -459,3 +459,9 @@ uInt8 CartridgeBUSWidget::internalRamGetValue(int addr)
 {
   return myCart.myBUSRAM[addr];
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Thumbulator* CartridgeBUSWidget::thumbEmulator()
+{
+  return myCart.myThumbEmulator.get();
+}
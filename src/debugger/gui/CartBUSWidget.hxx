@@ -88,6 +88,8 @@ class CartridgeBUSWidget : public CartDebugWidget
     uInt8 internalRamGetValue(int addr) override;
     // end of functions for Cartridge RAM tab
 
+    Thumbulator* thumbEmulator() override;
+
     // Following constructors and assignment operators not supported
     CartridgeBUSWidget() = delete;
     CartridgeBUSWidget(const CartridgeBUSWidget&) = delete;
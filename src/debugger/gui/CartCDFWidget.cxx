@@ -422,3 +422,9 @@ uInt8 CartridgeCDFWidget::internalRamGetValue(int addr)
 {
   return myCart.myCDFRAM[addr];
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Thumbulator* CartridgeCDFWidget::thumbEmulator()
+{
+  return myCart.myThumbEmulator.get();
+}
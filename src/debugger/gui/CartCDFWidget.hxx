@@ -89,6 +89,8 @@ class CartridgeCDFWidget : public CartDebugWidget
     uInt8 internalRamGetValue(int addr) override;
     // end of functions for Cartridge RAM tab
 
+    Thumbulator* thumbEmulator() override;
+
     // Following constructors and assignment operators not supported
     CartridgeCDFWidget() = delete;
     CartridgeCDFWidget(const CartridgeCDFWidget&) = delete;
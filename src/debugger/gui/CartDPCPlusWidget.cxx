@@ -390,3 +390,9 @@ uInt8 CartridgeDPCPlusWidget::internalRamGetValue(int addr)
 {
   return myCart.myDisplayImage[addr];
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Thumbulator* CartridgeDPCPlusWidget::thumbEmulator()
+{
+  return myCart.myThumbEmulator.get();
+}
@@ -88,6 +88,8 @@ class CartridgeDPCPlusWidget : public CartDebugWidget
     uInt8 internalRamGetValue(int addr) override;
     // end of functions for Cartridge RAM tab
 
+    Thumbulator* thumbEmulator() override;
+
     // Following constructors and assignment operators not supported
     CartridgeDPCPlusWidget() = delete;
     CartridgeDPCPlusWidget(const CartridgeDPCPlusWidget&) = delete;
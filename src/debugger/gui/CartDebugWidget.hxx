@@ -21,6 +21,7 @@
 class GuiObject;
 class ButtonWidget;
 class StringListWidget;
+class Thumbulator;
 
 namespace GUI {
   class Font;
@@ -68,6 +69,10 @@ class CartDebugWidget : public Widget, public CommandSender
     virtual uInt8 internalRamGetValue(int addr) { return 0; }
     virtual string internalRamLabel(int addr) { return "Not available/applicable"; }
 
+    // To make the ARM profile show up in the debugger, return the
+    // ARM emulator of cartridges which have one
+    virtual Thumbulator* thumbEmulator() { return nullptr; }
+
   protected:
     // Arrays used to hold current and previous internal RAM values
     ByteArray myRamOld, myRamCurrent;
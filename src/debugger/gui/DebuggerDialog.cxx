@@ -34,6 +34,7 @@
 #include "TiaWidget.hxx"
 #include "CartDebugWidget.hxx"
 #include "CartRamWidget.hxx"
+#include "ArmProfileWidget.hxx"
 #include "DataGridOpsWidget.hxx"
 #include "EditTextWidget.hxx"
 #include "MessageBox.hxx"
@@ -555,6 +556,18 @@ void DebuggerDialog::addRomArea()
         myCartRam->setOpsWidget(ops);
       }
     }
+
+    // The ARM profile tab
+    Thumbulator* arm = myCartDebug->thumbEmulator();
+    if(arm)
+    {
+      tabID = myRomTab->addTab(" ARM Profile ");
+      ArmProfileWidget* profile =
+        new ArmProfileWidget(myRomTab, *myLFont, *myNFont, 2, 2, tabWidth - 1,
+                tabHeight - myRomTab->getTabHeight() - 2, *arm);
+      myRomTab->setParentWidget(tabID, profile);
+      addToFocusList(profile->getFocusList(), myRomTab, tabID);
+    }
   }
 
   myRomTab->setActiveTab(0);
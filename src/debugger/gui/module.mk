@@ -2,6 +2,7 @@ MODULE := src/debugger/gui
 
 MODULE_OBJS := \
 	src/debugger/gui/AmigaMouseWidget.o \
+	src/debugger/gui/ArmProfileWidget.o \
 	src/debugger/gui/AtariMouseWidget.o \
 	src/debugger/gui/AtariVoxWidget.o \
 	src/debugger/gui/AudioWidget.o \
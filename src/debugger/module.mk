@@ -4,6 +4,7 @@ MODULE_OBJS := \
 	src/debugger/Debugger.o \
 	src/debugger/DebuggerParser.o \
 	src/debugger/CartDebug.o \
+	src/debugger/CompiledExpression.o \
 	src/debugger/CpuDebug.o \
 	src/debugger/DiStella.o \
 	src/debugger/RiotDebug.o \
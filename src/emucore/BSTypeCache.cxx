@@ -0,0 +1,92 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "Version.hxx"
+#include "BSTypeCache.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BSTypeCache::BSTypeCache(const string& cachefile)
+  : myChanged(false)
+{
+  load(cachefile);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BSTypeCache::load(const string& filename)
+{
+  ifstream in(filename);
+
+  // Entries from other versions may no longer be valid
+  string line;
+  if(!getline(in, line) || line != "Stella " STELLA_VERSION)
+    return;
+
+  string md5, name;
+  while(in >> md5 >> name)
+  {
+    BSType type = Bankswitch::nameToType(name);
+    if(type != BSType::_AUTO)
+      myTypes[md5] = type;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BSTypeCache::save(const string& filename)
+{
+  if(!myChanged)
+    return true;
+
+  ofstream out(filename);
+  if(!out)
+    return false;
+
+  out << "Stella " STELLA_VERSION << endl;
+  for(const auto& i: myTypes)
+    out << i.first << " " << Bankswitch::typeToName(i.second) << endl;
+
+  myChanged = false;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BSTypeCache::get(const string& md5, BSType& type) const
+{
+  auto i = myTypes.find(md5);
+  if(i == myTypes.end())
+    return false;
+
+  type = i->second;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BSTypeCache::set(const string& md5, BSType type)
+{
+  BSType& entry = myTypes[md5];
+  if(entry != type)
+  {
+    entry = type;
+    myChanged = true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BSTypeCache::merge(const BSTypeCache& other)
+{
+  for(const auto& i: other.myTypes)
+    set(i.first, i.second);
+}
@@ -0,0 +1,103 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef BSTYPE_CACHE_HXX
+#define BSTYPE_CACHE_HXX
+
+#include <map>
+
+#include "bspf.hxx"
+#include "BSType.hxx"
+
+/**
+  This class remembers the bankswitch type autodetected for each ROM,
+  keyed by the ROM md5.  It's saved to disk between runs, so that
+  autodetection only has to be done once for any given ROM.
+
+  The file is tagged with the Stella version that created it, and is
+  discarded when read by a different version, since the detection
+  heuristics may have changed in the meantime.
+*/
+class BSTypeCache
+{
+  public:
+    /**
+      Create a cache object from the specified cache file.
+    */
+    BSTypeCache(const string& cachefile);
+
+  public:
+    /**
+      Load cache entries from the specified file.
+
+      @param filename  Full pathname of input file to use
+    */
+    void load(const string& filename);
+
+    /**
+      Save cache entries to the specified file, if any were added since
+      it was loaded.
+
+      @param filename  Full pathname of output file to use
+
+      @return  True on success, false on failure
+               Failure occurs if file couldn't be opened for writing
+    */
+    bool save(const string& filename);
+
+    /**
+      Get the detected bankswitch type for the given md5.
+
+      @param md5   The md5 of the ROM
+      @param type  The detected type of the ROM, if found
+
+      @return  True if the md5 was found, else false
+    */
+    bool get(const string& md5, BSType& type) const;
+
+    /**
+      Remember the detected bankswitch type for the given md5.
+
+      @param md5   The md5 of the ROM
+      @param type  The detected type of the ROM
+    */
+    void set(const string& md5, BSType type);
+
+    /**
+      Add all entries from another cache (ie, one filled by another
+      OSystem running in a separate thread) to this one.
+
+      @param other  The cache to take entries from
+    */
+    void merge(const BSTypeCache& other);
+
+  private:
+    std::map<string, BSType> myTypes;
+
+    // Indicates whether the cache must be written back to disk
+    bool myChanged;
+
+  private:
+    // Following constructors and assignment operators not supported
+    BSTypeCache() = delete;
+    BSTypeCache(const BSTypeCache&) = delete;
+    BSTypeCache(BSTypeCache&&) = delete;
+    BSTypeCache& operator=(const BSTypeCache&) = delete;
+    BSTypeCache& operator=(BSTypeCache&&) = delete;
+};
+
+#endif
@@ -32,6 +32,9 @@ Cartridge::Cartridge(const Settings& settings)
     myCodeAccessBase(nullptr),
     myBankLocked(false)
 {
+#ifdef DEBUGGER_SUPPORT
+  myDebugger = nullptr;
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -72,9 +75,25 @@ bool Cartridge::bankChanged()
 void Cartridge::triggerReadFromWritePort(uInt16 address)
 {
 #ifdef DEBUGGER_SUPPORT
-  if(!mySystem->autodetectMode())
-    Debugger::debugger().cartDebug().triggerReadFromWritePort(address);
+  if(myDebugger && !mySystem->autodetectMode())
+    myDebugger->cartDebug().triggerReadFromWritePort(address);
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Cartridge::triggerFatalError(const string& message)
+{
+  if(mySystem->autodetectMode())
+    return;
+
+#ifdef DEBUGGER_SUPPORT
+  if(myDebugger)
+  {
+    myDebugger->startWithFatalError(message);
+    return;
+  }
 #endif
+  cout << message << endl;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -23,6 +23,9 @@ class Properties;
 class CartDebugWidget;
 class CartRamWidget;
 class GuiObject;
+#ifdef DEBUGGER_SUPPORT
+  class Debugger;
+#endif
 
 #include "bspf.hxx"
 #include "Device.hxx"
@@ -169,6 +172,17 @@ class Cartridge : public Device
     virtual CartDebugWidget* debugWidget(GuiObject* boss, const GUI::Font& lfont,
         const GUI::Font& nfont, int x, int y, int w, int h) { return nullptr; }
 
+#ifdef DEBUGGER_SUPPORT
+    /**
+      Attach the debugger, which is then informed about illegal accesses
+      and fatal errors.  A cart without a debugger (ie, in headless mode)
+      simply logs fatal errors and ignores everything else.
+
+      @param debugger  The debugger for the console using this cart
+    */
+    void attach(Debugger& debugger) { myDebugger = &debugger; }
+#endif
+
   protected:
     /**
       Indicate that an illegal read from a write port has occurred.
@@ -177,6 +191,13 @@ class Cartridge : public Device
     */
     void triggerReadFromWritePort(uInt16 address);
 
+    /**
+      Indicate that a fatal error has occurred (ie, in the ARM emulation).
+
+      @param message  A description of the error
+    */
+    void triggerFatalError(const string& message);
+
     /**
       Create an array that holds code-access information for every byte
       of the ROM (indicated by 'size').  Note that this is only used by
@@ -234,6 +255,11 @@ class Cartridge : public Device
     // by the debugger, when disassembling/dumping ROM.
     bool myBankLocked;
 
+#ifdef DEBUGGER_SUPPORT
+    // The debugger attached to this cart (if any)
+    Debugger* myDebugger;
+#endif
+
     // Contains various info about this cartridge
     // This needs to be stored separately from child classes, since
     // sometimes the information in both do not match
@@ -17,9 +17,6 @@
 
 #include <cstring>
 
-#ifdef DEBUGGER_SUPPORT
-  #include "Debugger.hxx"
-#endif
 #include "System.hxx"
 #include "M6532.hxx"
 #include "TIA.hxx"
@@ -163,14 +160,7 @@ inline void CartridgeBUS::callFunction(uInt8 value)
         myThumbEmulator->run(cycles);
       }
       catch(const runtime_error& e) {
-        if(!mySystem->autodetectMode())
-        {
-      #ifdef DEBUGGER_SUPPORT
-          Debugger::debugger().startWithFatalError(e.what());
-      #else
-          cout << e.what() << endl;
-      #endif
-        }
+        triggerFatalError(e.what());
       }
       break;
   }
@@ -466,6 +456,7 @@ bool CartridgeBUS::patch(uInt16 address, uInt8 value)
   if(address >= 0x0040)
   {
     myProgramImage[myBankOffset + (address & 0x0FFF)] = value;
+    myThumbEmulator->invalidateROMCache();
     return myBankChanged = true;
   }
   else
@@ -17,10 +17,6 @@
 
 #include <cstring>
 
-#ifdef DEBUGGER_SUPPORT
-  #include "Debugger.hxx"
-#endif
-
 #include "System.hxx"
 #include "Thumbulator.hxx"
 #include "CartCDF.hxx"
@@ -162,14 +158,7 @@ inline void CartridgeCDF::callFunction(uInt8 value)
         myThumbEmulator->run(cycles);
       }
       catch(const runtime_error& e) {
-        if(!mySystem->autodetectMode())
-        {
-#ifdef DEBUGGER_SUPPORT
-          Debugger::debugger().startWithFatalError(e.what());
-#else
-          cout << e.what() << endl;
-#endif
-        }
+        triggerFatalError(e.what());
       }
       break;
   }
@@ -427,6 +416,7 @@ bool CartridgeCDF::patch(uInt16 address, uInt8 value)
   if(address >= 0x0040)
   {
     myProgramImage[myBankOffset + (address & 0x0FFF)] = value;
+    myThumbEmulator->invalidateROMCache();
     return myBankChanged = true;
   }
   else
@@ -15,9 +15,6 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
-#ifdef DEBUGGER_SUPPORT
-  #include "Debugger.hxx"
-#endif
 #include "System.hxx"
 #include "Thumbulator.hxx"
 #include "CartDPCPlus.hxx"
@@ -185,14 +182,7 @@ inline void CartridgeDPCPlus::callFunction(uInt8 value)
         myThumbEmulator->run(cycles);
       }
       catch(const runtime_error& e) {
-        if(!mySystem->autodetectMode())
-        {
-      #ifdef DEBUGGER_SUPPORT
-          Debugger::debugger().startWithFatalError(e.what());
-      #else
-          cout << e.what() << endl;
-      #endif
-        }
+        triggerFatalError(e.what());
       }
       break;
     // reserved
@@ -611,6 +601,7 @@ bool CartridgeDPCPlus::patch(uInt16 address, uInt8 value)
   if(address >= 0x0080)
   {
     myProgramImage[myBankOffset + (address & 0x0FFF)] = value;
+    myThumbEmulator->invalidateROMCache();
     return myBankChanged = true;
   }
   else
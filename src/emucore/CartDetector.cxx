@@ -62,6 +62,7 @@
 #include "MD5.hxx"
 #include "Props.hxx"
 #include "Settings.hxx"
+#include "BSTypeCache.hxx"
 
 #include "CartDetector.hxx"
 
@@ -79,9 +80,15 @@ unique_ptr<Cartridge> CartDetector::create(const BytePtr& image, uInt32 size,
 
   // See if we should try to auto-detect the cartridge type
   // If we ask for extended info, always do an autodetect
+  // Since the result depends only on the ROM contents, it's cached by md5
   if(type == BSType::_AUTO || osystem.settings().getBool("rominfo"))
   {
-    detectedType = autodetectType(image, size);
+    BSTypeCache& cache = osystem.bsTypeCache();
+    if(!cache.get(md5, detectedType))
+    {
+      detectedType = autodetectType(image, size);
+      cache.set(md5, detectedType);
+    }
     if(type != BSType::_AUTO && type != detectedType)
       cerr << "Auto-detection not consistent: "
            << Bankswitch::typeToName(type) << ", "
@@ -333,6 +340,11 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   // Guess type based on size
   BSType type = BSType::_AUTO;
 
+  // Most of the checks below look for signatures across the whole image;
+  // these are all gathered at once here, in a single pass over the image
+  SignatureHits hits;
+  countSignatures(image.get(), size, hits);
+
   if(isProbablyCVPlus(image,size))
   {
     type = BSType::_CVP;
@@ -348,11 +360,11 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   else if((size == 2048) ||
           (size == 4096 && memcmp(image.get(), image.get() + 2048, 2048) == 0))
   {
-    type = isProbablyCV(image, size) ? BSType::_CV : BSType::_2K;
+    type = isProbablyCV(hits) ? BSType::_CV : BSType::_2K;
   }
   else if(size == 4096)
   {
-    if(isProbablyCV(image, size))
+    if(isProbablyCV(hits))
       type = BSType::_CV;
     else if(isProbably4KSC(image, size))
       type = BSType::_4KSC;
@@ -362,26 +374,25 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   else if(size == 8*1024)  // 8K
   {
     // First check for *potential* F8
-    uInt8 signature[] = { 0x8D, 0xF9, 0x1F };  // STA $1FF9
-    bool f8 = searchForBytes(image.get(), size, signature, 3, 2);
+    bool f8 = hits[SIG_F8] >= 2;
 
     if(isProbablySC(image, size))
       type = BSType::_F8SC;
     else if(memcmp(image.get(), image.get() + 4096, 4096) == 0)
       type = BSType::_4K;
-    else if(isProbablyE0(image, size))
+    else if(isProbablyE0(hits))
       type = BSType::_E0;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
-    else if(isProbablyUA(image, size))
+    else if(isProbablyUA(hits))
       type = BSType::_UA;
-    else if(isProbablyFE(image, size) && !f8)
+    else if(isProbablyFE(hits) && !f8)
       type = BSType::_FE;
-    else if(isProbably0840(image, size))
+    else if(isProbably0840(hits))
       type = BSType::_0840;
-    else if(isProbablyE78K(image, size))
+    else if(isProbablyE78K(hits))
       type = BSType::_E78K;
     else
       type = BSType::_F8;
@@ -402,12 +413,12 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   {
     if(isProbablySC(image, size))
       type = BSType::_F6SC;
-    else if(isProbablyE7(image, size))
+    else if(isProbablyE7(hits))
       type = BSType::_E7;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = BSType::_3E;
   /* no known 16K 3F ROMS
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
   */
     else
@@ -421,22 +432,22 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   {
     if(isProbablyARM(image, size))
       type = BSType::_FA2;
-    else /*if(isProbablyDPCplus(image, size))*/
+    else /*if(isProbablyDPCplus(hits))*/
       type = BSType::_DPCP;
   }
   else if(size == 32*1024)  // 32K
   {
     if(isProbablySC(image, size))
       type = BSType::_F4SC;
-    else if(isProbably3E(image, size))
+    else if(isProbably3E(hits))
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
-    else if (isProbablyBUS(image, size))
+    else if (isProbablyBUS(hits))
       type = BSType::_BUS;
-    else if (isProbablyCDF(image, size))
+    else if (isProbablyCDF(hits))
       type = BSType::_CDF;
-    else if(isProbablyDPCplus(image, size))
+    else if(isProbablyDPCplus(hits))
       type = BSType::_DPCP;
     else if(isProbablyCTY(image, size))
       type = BSType::_CTY;
@@ -447,57 +458,57 @@ BSType CartDetector::autodetectType(const BytePtr& image, uInt32 size)
   }
   else if(size == 64*1024)  // 64K
   {
-    if(isProbably3E(image, size))
+    if(isProbably3E(hits))
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
     else if(isProbably4A50(image, size))
       type = BSType::_4A50;
-    else if(isProbablyEF(image, size, type))
+    else if(isProbablyEF(image, size, hits, type))
       ; // type has been set directly in the function
-    else if(isProbablyX07(image, size))
+    else if(isProbablyX07(hits))
       type = BSType::_X07;
     else
       type = BSType::_F0;
   }
   else if(size == 128*1024)  // 128K
   {
-    if(isProbably3E(image, size))
+    if(isProbably3E(hits))
       type = BSType::_3E;
     else if(isProbablyDF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
     else if(isProbably4A50(image, size))
       type = BSType::_4A50;
-    else if(isProbablySB(image, size))
+    else if(isProbablySB(hits))
       type = BSType::_SB;
   }
   else if(size == 256*1024)  // 256K
   {
-    if(isProbably3E(image, size))
+    if(isProbably3E(hits))
       type = BSType::_3E;
     else if(isProbablyBF(image, size, type))
       ; // type has been set directly in the function
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
-    else /*if(isProbablySB(image, size))*/
+    else /*if(isProbablySB(hits))*/
       type = BSType::_SB;
   }
   else  // what else can we do?
   {
-    if(isProbably3E(image, size))
+    if(isProbably3E(hits))
       type = BSType::_3E;
-    else if(isProbably3F(image, size))
+    else if(isProbably3F(hits))
       type = BSType::_3F;
     else
       type = BSType::_4K;  // Most common bankswitching type
   }
 
   // Variable sized ROM formats are independent of image size and come last
-  if(isProbablyDASH(image, size))
+  if(isProbablyDASH(hits))
     type = BSType::_DASH;
-  else if(isProbably3EPlus(image, size))
+  else if(isProbably3EPlus(hits))
     type = BSType::_3EP;
   else if(isProbablyMDM(image, size))
     type = BSType::_MDM;
@@ -533,6 +544,141 @@ bool CartDetector::searchForBytes(const uInt8* image, uInt32 imagesize,
   return (count >= minhits);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const CartDetector::SignatureInfo CartDetector::ourSignatures[] = {
+  // F8 (potential)
+  { { 0x8D, 0xF9, 0x1F }, 3 },              // STA $1FF9
+  // 0840
+  { { 0xAD, 0x00, 0x08 }, 3 },              // LDA $0800
+  { { 0xAD, 0x40, 0x08 }, 3 },              // LDA $0840
+  { { 0x2C, 0x00, 0x08 }, 3 },              // BIT $0800
+  { { 0x0C, 0x00, 0x08, 0x4C }, 4 },        // NOP $0800; JMP ...
+  { { 0x0C, 0xFF, 0x0F, 0x4C }, 4 },        // NOP $0FFF; JMP ...
+  // 3E, 3E+ and 3F
+  { { 0x85, 0x3E, 0xA9, 0x00 }, 4 },        // STA $3E; LDA #$00
+  { { 'T', 'J', '3', 'E' }, 4 },
+  { { 0x85, 0x3F }, 2 },                    // STA $3F
+  // BUS and CDF
+  { { 'B', 'U', 'S' }, 3 },
+  { { 'C', 'D', 'F' }, 3 },
+  // CV; these signatures are attributed to the MESS project
+  { { 0x9D, 0xFF, 0xF3 }, 3 },              // STA $F3FF.X
+  { { 0x99, 0x00, 0xF4 }, 3 },              // STA $F400.Y
+  // DASH and DPC+
+  { { 'T', 'J', 'A', 'D' }, 4 },
+  { { 'D', 'P', 'C', '+' }, 4 },
+  // E0; these signatures are attributed to the MESS project
+  { { 0x8D, 0xE0, 0x1F }, 3 },              // STA $1FE0
+  { { 0x8D, 0xE0, 0x5F }, 3 },              // STA $5FE0
+  { { 0x8D, 0xE9, 0xFF }, 3 },              // STA $FFE9
+  { { 0x0C, 0xE0, 0x1F }, 3 },              // NOP $1FE0
+  { { 0xAD, 0xE0, 0x1F }, 3 },              // LDA $1FE0
+  { { 0xAD, 0xE9, 0xFF }, 3 },              // LDA $FFE9
+  { { 0xAD, 0xED, 0xFF }, 3 },              // LDA $FFED
+  { { 0xAD, 0xF3, 0xBF }, 3 },              // LDA $BFF3
+  // E7; these signatures are attributed to the MESS project
+  { { 0xAD, 0xE2, 0xFF }, 3 },              // LDA $FFE2
+  { { 0xAD, 0xE5, 0xFF }, 3 },              // LDA $FFE5
+  { { 0xAD, 0xE5, 0x1F }, 3 },              // LDA $1FE5
+  { { 0xAD, 0xE7, 0x1F }, 3 },              // LDA $1FE7
+  { { 0x0C, 0xE7, 0x1F }, 3 },              // NOP $1FE7
+  { { 0x8D, 0xE7, 0xFF }, 3 },              // STA $FFE7
+  { { 0x8D, 0xE7, 0x1F }, 3 },              // STA $1FE7
+  // E78K
+  { { 0xAD, 0xE4, 0xFF }, 3 },              // LDA $FFE4
+  { { 0xAD, 0xE5, 0xFF }, 3 },              // LDA $FFE5
+  { { 0xAD, 0xE6, 0xFF }, 3 },              // LDA $FFE6
+  // EF
+  { { 0x0C, 0xE0, 0xFF }, 3 },              // NOP $FFE0
+  { { 0xAD, 0xE0, 0xFF }, 3 },              // LDA $FFE0
+  { { 0x0C, 0xE0, 0x1F }, 3 },              // NOP $1FE0
+  { { 0xAD, 0xE0, 0x1F }, 3 },              // LDA $1FE0
+  // FE; these signatures are attributed to the MESS project
+  { { 0x20, 0x00, 0xD0, 0xC6, 0xC5 }, 5 },  // JSR $D000; DEC $C5
+  { { 0x20, 0xC3, 0xF8, 0xA5, 0x82 }, 5 },  // JSR $F8C3; LDA $82
+  { { 0xD0, 0xFB, 0x20, 0x73, 0xFE }, 5 },  // BNE $FB; JSR $FE73
+  { { 0x20, 0x00, 0xF0, 0x84, 0xD6 }, 5 },  // JSR $F000; STY $D6
+  // SB
+  { { 0xBD, 0x00, 0x08 }, 3 },              // LDA $0800,x
+  { { 0xAD, 0x00, 0x08 }, 3 },              // LDA $0800
+  // UA
+  { { 0x8D, 0x40, 0x02 }, 3 },              // STA $240
+  { { 0xAD, 0x40, 0x02 }, 3 },              // LDA $240
+  { { 0xBD, 0x1F, 0x02 }, 3 },              // LDA $21F,X
+  // X07
+  { { 0xAD, 0x0D, 0x08 }, 3 },              // LDA $080D
+  { { 0xAD, 0x1D, 0x08 }, 3 },              // LDA $081D
+  { { 0xAD, 0x2D, 0x08 }, 3 },              // LDA $082D
+  { { 0x0C, 0x0D, 0x08 }, 3 },              // NOP $080D
+  { { 0x0C, 0x1D, 0x08 }, 3 },              // NOP $081D
+  { { 0x0C, 0x2D, 0x08 }, 3 }               // NOP $082D
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CartDetector::countSignatures(const uInt8* image, uInt32 size,
+                                   SignatureHits& hits)
+{
+  static_assert(sizeof(ourSignatures) / sizeof(SignatureInfo) == NUM_SIGNATURES,
+                "Signature table doesn't match the Signature enum");
+
+  // Group the signatures by their first byte, so that a candidate position
+  // is only compared against those signatures that can start there; the
+  // signatures starting with byte 'c' are at order[first[c]...first[c+1])
+  // Since all signatures are at least two bytes long, most positions can
+  // be rejected with a single lookup of their first two bytes in 'pairs'
+  struct Buckets {
+    uInt8 first[257];
+    uInt8 order[NUM_SIGNATURES];
+    uInt8 pairs[65536 / 8];
+  };
+  static const Buckets buckets = [] {
+    Buckets b;
+    uInt8 n = 0;
+    for(uInt32 c = 0; c < 256; ++c)
+    {
+      b.first[c] = n;
+      for(uInt8 s = 0; s < NUM_SIGNATURES; ++s)
+        if(ourSignatures[s].bytes[0] == c)
+          b.order[n++] = s;
+    }
+    b.first[256] = n;
+
+    memset(b.pairs, 0, sizeof(b.pairs));
+    for(uInt8 s = 0; s < NUM_SIGNATURES; ++s)
+    {
+      uInt16 pair = ourSignatures[s].bytes[0] | (ourSignatures[s].bytes[1] << 8);
+      b.pairs[pair >> 3] |= 1 << (pair & 7);
+    }
+    return b;
+  }();
+
+  // Like searchForBytes(), a hit at position i excludes the next possible
+  // hit for the same signature until position i + sigsize + 1, and a
+  // signature may not end on the last byte of the image
+  uInt32 next[NUM_SIGNATURES] = { 0 };
+  hits.fill(0);
+
+  for(uInt32 i = 0; i + 1 < size; ++i)
+  {
+    const uInt16 pair = image[i] | (image[i+1] << 8);
+    if(!(buckets.pairs[pair >> 3] & (1 << (pair & 7))))
+      continue;
+
+    const uInt8 c = image[i];
+    for(uInt32 k = buckets.first[c]; k < buckets.first[c + 1]; ++k)
+    {
+      const uInt8 s = buckets.order[k];
+      const SignatureInfo& sig = ourSignatures[s];
+      if(i >= next[s] && i + sig.size < size && image[i+1] == sig.bytes[1] &&
+         memcmp(image + i + 2, sig.bytes + 2, sig.size - 2) == 0)
+      {
+        ++hits[s];
+        next[s] = i + sig.size + 1;
+      }
+    }
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CartDetector::isProbablySC(const BytePtr& image, uInt32 size)
 {
@@ -583,57 +729,41 @@ bool CartDetector::isProbablyARM(const BytePtr& image, uInt32 size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably0840(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably0840(const SignatureHits& hits)
 {
   // 0840 cart bankswitching is triggered by accessing addresses 0x0800
   // or 0x0840 at least twice
-  uInt8 signature1[3][3] = {
-    { 0xAD, 0x00, 0x08 },  // LDA $0800
-    { 0xAD, 0x40, 0x08 },  // LDA $0840
-    { 0x2C, 0x00, 0x08 }   // BIT $0800
-  };
-  for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image.get(), size, signature1[i], 3, 2))
-      return true;
-
-  uInt8 signature2[2][4] = {
-    { 0x0C, 0x00, 0x08, 0x4C },  // NOP $0800; JMP ...
-    { 0x0C, 0xFF, 0x0F, 0x4C }   // NOP $0FFF; JMP ...
-  };
-  for(uInt32 i = 0; i < 2; ++i)
-    if(searchForBytes(image.get(), size, signature2[i], 4, 2))
+  for(uInt32 s = SIG_0840_0; s <= SIG_0840_4; ++s)
+    if(hits[s] >= 2)
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3E(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably3E(const SignatureHits& hits)
 {
   // 3E cart bankswitching is triggered by storing the bank number
   // in address 3E using 'STA $3E', commonly followed by an
   // immediate mode LDA
-  uInt8 signature[] = { 0x85, 0x3E, 0xA9, 0x00 };  // STA $3E; LDA #$00
-  return searchForBytes(image.get(), size, signature, 4, 1);
+  return hits[SIG_3E] >= 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3EPlus(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably3EPlus(const SignatureHits& hits)
 {
   // 3E+ cart is identified key 'TJ3E' in the ROM
-  uInt8 signature[] = { 'T', 'J', '3', 'E' };
-  return searchForBytes(image.get(), size, signature, 4, 1);
+  return hits[SIG_3EPLUS] >= 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbably3F(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbably3F(const SignatureHits& hits)
 {
   // 3F cart bankswitching is triggered by storing the bank number
   // in address 3F using 'STA $3F'
   // We expect it will be present at least 2 times, since there are
   // at least two banks
-  uInt8 signature[] = { 0x85, 0x3F };  // STA $3F
-  return searchForBytes(image.get(), size, signature, 2, 2);
+  return hits[SIG_3F] >= 2;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -661,18 +791,10 @@ bool CartDetector::isProbablyCTY(const BytePtr&, uInt32)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCV(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyCV(const SignatureHits& hits)
 {
   // CV RAM access occurs at addresses $f3ff and $f400
-  // These signatures are attributed to the MESS project
-  uInt8 signature[2][3] = {
-    { 0x9D, 0xFF, 0xF3 },  // STA $F3FF.X
-    { 0x99, 0x00, 0xF4 }   // STA $F400.Y
-  };
-  if(searchForBytes(image.get(), size, signature[0], 3, 1))
-    return true;
-  else
-    return searchForBytes(image.get(), size, signature[1], 3, 1);
+  return hits[SIG_CV_0] >= 1 || hits[SIG_CV_1] >= 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -686,95 +808,68 @@ bool CartDetector::isProbablyCVPlus(const BytePtr& image, uInt32)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDASH(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyDASH(const SignatureHits& hits)
 {
   // DASH cart is identified key 'TJAD' in the ROM
-  uInt8 signature[] = { 'T', 'J', 'A', 'D' };
-  return searchForBytes(image.get(), size, signature, 4, 1);
+  return hits[SIG_DASH] >= 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyDPCplus(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyDPCplus(const SignatureHits& hits)
 {
   // DPC+ ARM code has 2 occurrences of the string DPC+
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 signature[] = { 'D', 'P', 'C', '+' };
-  return searchForBytes(image.get(), size, signature, 4, 2);
+  return hits[SIG_DPCPLUS] >= 2;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE0(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyE0(const SignatureHits& hits)
 {
   // E0 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FF9 using absolute non-indexed addressing
   // To eliminate false positives (and speed up processing), we
   // search for only certain known signatures
   // Thanks to "stella@casperkitty.com" for this advice
-  // These signatures are attributed to the MESS project
-  uInt8 signature[8][3] = {
-    { 0x8D, 0xE0, 0x1F },  // STA $1FE0
-    { 0x8D, 0xE0, 0x5F },  // STA $5FE0
-    { 0x8D, 0xE9, 0xFF },  // STA $FFE9
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F },  // LDA $1FE0
-    { 0xAD, 0xE9, 0xFF },  // LDA $FFE9
-    { 0xAD, 0xED, 0xFF },  // LDA $FFED
-    { 0xAD, 0xF3, 0xBF }   // LDA $BFF3
-  };
-  for(uInt32 i = 0; i < 8; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+  for(uInt32 s = SIG_E0_0; s <= SIG_E0_7; ++s)
+    if(hits[s] >= 1)
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE7(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyE7(const SignatureHits& hits)
 {
   // E7 cart bankswitching is triggered by accessing addresses
   // $FE0 to $FE6 using absolute non-indexed addressing
   // To eliminate false positives (and speed up processing), we
   // search for only certain known signatures
   // Thanks to "stella@casperkitty.com" for this advice
-  // These signatures are attributed to the MESS project
-  uInt8 signature[7][3] = {
-    { 0xAD, 0xE2, 0xFF },  // LDA $FFE2
-    { 0xAD, 0xE5, 0xFF },  // LDA $FFE5
-    { 0xAD, 0xE5, 0x1F },  // LDA $1FE5
-    { 0xAD, 0xE7, 0x1F },  // LDA $1FE7
-    { 0x0C, 0xE7, 0x1F },  // NOP $1FE7
-    { 0x8D, 0xE7, 0xFF },  // STA $FFE7
-    { 0x8D, 0xE7, 0x1F }   // STA $1FE7
-  };
-  for(uInt32 i = 0; i < 7; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+  for(uInt32 s = SIG_E7_0; s <= SIG_E7_6; ++s)
+    if(hits[s] >= 1)
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyE78K(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyE78K(const SignatureHits& hits)
 {
   // E78K cart bankswitching is triggered by accessing addresses
   // $FE4 to $FE6 using absolute non-indexed addressing
   // To eliminate false positives (and speed up processing), we
   // search for only certain known signatures
-  uInt8 signature[3][3] = {
-    { 0xAD, 0xE4, 0xFF },  // LDA $FFE4
-    { 0xAD, 0xE5, 0xFF },  // LDA $FFE5
-    { 0xAD, 0xE6, 0xFF },  // LDA $FFE6
-  };
-  for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+  for(uInt32 s = SIG_E78K_0; s <= SIG_E78K_2; ++s)
+    if(hits[s] >= 1)
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyEF(const BytePtr& image, uInt32 size, BSType& type)
+bool CartDetector::isProbablyEF(const BytePtr& image, uInt32 size,
+                                const SignatureHits& hits, BSType& type)
 {
   // Newer EF carts store strings 'EFEF' and 'EFSC' starting at address $FFF8
   // This signature is attributed to "RevEng" of AtariAge
@@ -795,15 +890,9 @@ bool CartDetector::isProbablyEF(const BytePtr& image, uInt32 size, BSType& type)
   // 0xFE0 to 0xFEF, usually with either a NOP or LDA
   // It's likely that the code will switch to bank 0, so that's what is tested
   bool isEF = false;
-  uInt8 signature[4][3] = {
-    { 0x0C, 0xE0, 0xFF },  // NOP $FFE0
-    { 0xAD, 0xE0, 0xFF },  // LDA $FFE0
-    { 0x0C, 0xE0, 0x1F },  // NOP $1FE0
-    { 0xAD, 0xE0, 0x1F }   // LDA $1FE0
-  };
-  for(uInt32 i = 0; i < 4; ++i)
+  for(uInt32 s = SIG_EF_0; s <= SIG_EF_3; ++s)
   {
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+    if(hits[s] >= 1)
     {
       isEF = true;
       break;
@@ -843,23 +932,21 @@ bool CartDetector::isProbablyBF(const BytePtr& image, uInt32 size, BSType& type)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyBUS(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyBUS(const SignatureHits& hits)
 {
   // BUS ARM code has 2 occurrences of the string BUS
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 bus[] = { 'B', 'U', 'S'};
-  return searchForBytes(image.get(), size, bus, 3, 2);
+  return hits[SIG_BUS] >= 2;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyCDF(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyCDF(const SignatureHits& hits)
 {
   // CDF ARM code has 3 occurrences of the string DPC+
   // Note: all Harmony/Melody custom drivers also contain the value
   // 0x10adab1e (LOADABLE) if needed for future improvement
-  uInt8 signature[] = { 'C', 'D', 'F' };
-  return searchForBytes(image.get(), size, signature, 3, 3);
+  return hits[SIG_CDF] >= 3;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -900,19 +987,12 @@ bool CartDetector::isProbablyFA2(const BytePtr& image, uInt32)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyFE(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyFE(const SignatureHits& hits)
 {
   // FE bankswitching is very weird, but always seems to include a
   // 'JSR $xxxx'
-  // These signatures are attributed to the MESS project
-  uInt8 signature[4][5] = {
-    { 0x20, 0x00, 0xD0, 0xC6, 0xC5 },  // JSR $D000; DEC $C5
-    { 0x20, 0xC3, 0xF8, 0xA5, 0x82 },  // JSR $F8C3; LDA $82
-    { 0xD0, 0xFB, 0x20, 0x73, 0xFE },  // BNE $FB; JSR $FE73
-    { 0x20, 0x00, 0xF0, 0x84, 0xD6 }   // JSR $F000; STY $D6
-  };
-  for(uInt32 i = 0; i < 4; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 5, 1))
+  for(uInt32 s = SIG_FE_0; s <= SIG_FE_3; ++s)
+    if(hits[s] >= 1)
       return true;
 
   return false;
@@ -927,50 +1007,30 @@ bool CartDetector::isProbablyMDM(const BytePtr& image, uInt32 size)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablySB(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablySB(const SignatureHits& hits)
 {
   // SB cart bankswitching switches banks by accessing address 0x0800
-  uInt8 signature[2][3] = {
-    { 0xBD, 0x00, 0x08 },  // LDA $0800,x
-    { 0xAD, 0x00, 0x08 }   // LDA $0800
-  };
-  if(searchForBytes(image.get(), size, signature[0], 3, 1))
-    return true;
-  else
-    return searchForBytes(image.get(), size, signature[1], 3, 1);
+  return hits[SIG_SB_0] >= 1 || hits[SIG_SB_1] >= 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyUA(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyUA(const SignatureHits& hits)
 {
   // UA cart bankswitching switches to bank 1 by accessing address 0x240
   // using 'STA $240' or 'LDA $240'
-  uInt8 signature[3][3] = {
-    { 0x8D, 0x40, 0x02 },  // STA $240
-    { 0xAD, 0x40, 0x02 },  // LDA $240
-    { 0xBD, 0x1F, 0x02 }   // LDA $21F,X
-  };
-  for(uInt32 i = 0; i < 3; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+  for(uInt32 s = SIG_UA_0; s <= SIG_UA_2; ++s)
+    if(hits[s] >= 1)
       return true;
 
   return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool CartDetector::isProbablyX07(const BytePtr& image, uInt32 size)
+bool CartDetector::isProbablyX07(const SignatureHits& hits)
 {
   // X07 bankswitching switches to bank 0, 1, 2, etc by accessing address 0x08xd
-  uInt8 signature[6][3] = {
-    { 0xAD, 0x0D, 0x08 },  // LDA $080D
-    { 0xAD, 0x1D, 0x08 },  // LDA $081D
-    { 0xAD, 0x2D, 0x08 },  // LDA $082D
-    { 0x0C, 0x0D, 0x08 },  // NOP $080D
-    { 0x0C, 0x1D, 0x08 },  // NOP $081D
-    { 0x0C, 0x2D, 0x08 }   // NOP $082D
-  };
-  for(uInt32 i = 0; i < 6; ++i)
-    if(searchForBytes(image.get(), size, signature[i], 3, 1))
+  for(uInt32 s = SIG_X07_0; s <= SIG_X07_5; ++s)
+    if(hits[s] >= 1)
       return true;
 
   return false;
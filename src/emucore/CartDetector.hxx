@@ -22,6 +22,8 @@ class Cartridge;
 class Properties;
 class OSystem;
 
+#include <array>
+
 #include "bspf.hxx"
 #include "BSType.hxx"
 
@@ -48,6 +50,16 @@ class CartDetector
     static unique_ptr<Cartridge> create(const BytePtr& image, uInt32 size,
                  string& md5, const string& dtype, const OSystem& system);
 
+    /**
+      Try to auto-detect the bankswitching type of the cartridge
+
+      @param image  A pointer to the ROM image
+      @param size   The size of the ROM image
+
+      @return The "best guess" for the cartridge type
+    */
+    static BSType autodetectType(const BytePtr& image, uInt32 size);
+
   private:
     /**
       Create a cartridge from a multi-cart image pointer; internally this
@@ -84,14 +96,46 @@ class CartDetector
                       const string& md5, const OSystem& osystem);
 
     /**
-      Try to auto-detect the bankswitching type of the cartridge
+      Byte signatures searched for across the entire ROM image.  Rather than
+      scanning the image once per signature, the hits for all of these are
+      counted in a single pass by countSignatures().
+    */
+    enum Signature {
+      SIG_F8,
+      SIG_0840_0, SIG_0840_1, SIG_0840_2, SIG_0840_3, SIG_0840_4,
+      SIG_3E, SIG_3EPLUS, SIG_3F, SIG_BUS, SIG_CDF,
+      SIG_CV_0, SIG_CV_1, SIG_DASH, SIG_DPCPLUS,
+      SIG_E0_0, SIG_E0_1, SIG_E0_2, SIG_E0_3,
+      SIG_E0_4, SIG_E0_5, SIG_E0_6, SIG_E0_7,
+      SIG_E7_0, SIG_E7_1, SIG_E7_2, SIG_E7_3, SIG_E7_4, SIG_E7_5, SIG_E7_6,
+      SIG_E78K_0, SIG_E78K_1, SIG_E78K_2,
+      SIG_EF_0, SIG_EF_1, SIG_EF_2, SIG_EF_3,
+      SIG_FE_0, SIG_FE_1, SIG_FE_2, SIG_FE_3,
+      SIG_SB_0, SIG_SB_1,
+      SIG_UA_0, SIG_UA_1, SIG_UA_2,
+      SIG_X07_0, SIG_X07_1, SIG_X07_2, SIG_X07_3, SIG_X07_4, SIG_X07_5,
+      NUM_SIGNATURES
+    };
+    struct SignatureInfo {
+      uInt8 bytes[5];
+      uInt8 size;
+    };
+    static const SignatureInfo ourSignatures[];
+
+    // Number of (non-overlapping) hits for each signature in the image
+    using SignatureHits = std::array<uInt32, NUM_SIGNATURES>;
+
+    /**
+      Count the hits for every signature in 'ourSignatures' in one pass
+      over the image.  Each count is exactly what searchForBytes() would
+      find for that signature if it weren't stopped after 'minhits'.
 
       @param image  A pointer to the ROM image
       @param size   The size of the ROM image
-
-      @return The "best guess" for the cartridge type
+      @param hits   The number of hits for each signature
     */
-    static BSType autodetectType(const BytePtr& image, uInt32 size);
+    static void countSignatures(const uInt8* image, uInt32 size,
+                                SignatureHits& hits);
 
     /**
       Search the image for the specified byte signature
@@ -127,22 +171,22 @@ class CartDetector
     /**
       Returns true if the image is probably a 0840 bankswitching cartridge
     */
-    static bool isProbably0840(const BytePtr& image, uInt32 size);
+    static bool isProbably0840(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3E bankswitching cartridge
     */
-    static bool isProbably3E(const BytePtr& image, uInt32 size);
+    static bool isProbably3E(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3E+ bankswitching cartridge
     */
-    static bool isProbably3EPlus(const BytePtr& image, uInt32 size);
+    static bool isProbably3EPlus(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 3F bankswitching cartridge
     */
-    static bool isProbably3F(const BytePtr& image, uInt32 size);
+    static bool isProbably3F(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a 4A50 bankswitching cartridge
@@ -157,12 +201,12 @@ class CartDetector
     /**
       Returns true if the image is probably a BUS bankswitching cartridge
     */
-    static bool isProbablyBUS(const BytePtr& image, uInt32 size);
+    static bool isProbablyBUS(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CDF bankswitching cartridge
     */
-    static bool isProbablyCDF(const BytePtr& image, uInt32 size);
+    static bool isProbablyCDF(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CTY bankswitching cartridge
@@ -172,7 +216,7 @@ class CartDetector
     /**
       Returns true if the image is probably a CV bankswitching cartridge
     */
-    static bool isProbablyCV(const BytePtr& image, uInt32 size);
+    static bool isProbablyCV(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a CV+ bankswitching cartridge
@@ -182,7 +226,7 @@ class CartDetector
     /**
       Returns true if the image is probably a DASH bankswitching cartridge
     */
-    static bool isProbablyDASH(const BytePtr& image, uInt32 size);
+    static bool isProbablyDASH(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a DF/DFSC bankswitching cartridge
@@ -192,27 +236,28 @@ class CartDetector
     /**
       Returns true if the image is probably a DPC+ bankswitching cartridge
     */
-    static bool isProbablyDPCplus(const BytePtr& image, uInt32 size);
+    static bool isProbablyDPCplus(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a E0 bankswitching cartridge
     */
-    static bool isProbablyE0(const BytePtr& image, uInt32 size);
+    static bool isProbablyE0(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a E7 bankswitching cartridge
     */
-    static bool isProbablyE7(const BytePtr& image, uInt32 size);
+    static bool isProbablyE7(const SignatureHits& hits);
 
     /**
     Returns true if the image is probably a E78K bankswitching cartridge
     */
-    static bool isProbablyE78K(const BytePtr& image, uInt32 size);
+    static bool isProbablyE78K(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably an EF/EFSC bankswitching cartridge
     */
-    static bool isProbablyEF(const BytePtr& image, uInt32 size, BSType& type);
+    static bool isProbablyEF(const BytePtr& image, uInt32 size,
+                             const SignatureHits& hits, BSType& type);
 
     /**
       Returns true if the image is probably an F6 bankswitching cartridge
@@ -227,7 +272,7 @@ class CartDetector
     /**
       Returns true if the image is probably an FE bankswitching cartridge
     */
-    static bool isProbablyFE(const BytePtr& image, uInt32 size);
+    static bool isProbablyFE(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a MDM bankswitching cartridge
@@ -237,17 +282,17 @@ class CartDetector
     /**
       Returns true if the image is probably a SB bankswitching cartridge
     */
-    static bool isProbablySB(const BytePtr& image, uInt32 size);
+    static bool isProbablySB(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably a UA bankswitching cartridge
     */
-    static bool isProbablyUA(const BytePtr& image, uInt32 size);
+    static bool isProbablyUA(const SignatureHits& hits);
 
     /**
       Returns true if the image is probably an X07 bankswitching cartridge
     */
-    static bool isProbablyX07(const BytePtr& image, uInt32 size);
+    static bool isProbablyX07(const SignatureHits& hits);
 
   private:
     // Following constructors and assignment operators not supported
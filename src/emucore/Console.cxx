@@ -1004,6 +1004,7 @@ void Console::attachDebugger(Debugger& dbg)
 #ifdef DEBUGGER_SUPPORT
 //  myOSystem.createDebugger(*this);
   mySystem->m6502().attach(dbg);
+  myCart->attach(dbg);
 #endif
 }
 
@@ -225,6 +225,17 @@ class FBSurface
     */
     virtual void setDirty() { }
 
+    /**
+      This method should be called to indicate that only the given rows of
+      the surface have been modified since it was last rendered.  The surface
+      is redrawn at the next interval, but only the modified rows need to be
+      transferred to the video hardware (none at all if 'h' is zero).
+
+      @param y  The first modified row
+      @param h  The number of modified rows
+    */
+    virtual void setDirtyRows(uInt32 y, uInt32 h) { setDirty(); }
+
     //////////////////////////////////////////////////////////////////////////
     // Note:  The following methods are FBSurface-specific, and must be
     //        implemented in child classes.
@@ -172,6 +172,12 @@ bool FilesystemNode::rename(const string& newfile)
   return (_realNode && _realNode->exists()) ? _realNode->rename(newfile) : false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNode::getStats(uInt64& size, uInt64& modtime) const
+{
+  return _realNode ? _realNode->getStats(size, modtime) : false;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 FilesystemNode::read(BytePtr& image) const
 {
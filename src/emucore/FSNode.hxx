@@ -250,6 +250,18 @@ class FilesystemNode
      */
     virtual uInt32 read(BytePtr& buffer) const;
 
+    /**
+     * Get the size and last modification time of the file.  These are
+     * meant to detect that a file has changed, so the units of the
+     * modification time are platform-dependent.
+     *
+     * @param size     The size of the file in bytes
+     * @param modtime  The time the file was last modified
+     *
+     * @return  True if the information is available, false otherwise
+     */
+    virtual bool getStats(uInt64& size, uInt64& modtime) const;
+
     /**
      * The following methods are almost exactly the same as the various
      * getXXXX() methods above.  Internally, they call the respective methods
@@ -399,6 +411,13 @@ class AbstractFSNode
      */
     virtual uInt32 read(BytePtr& buffer) const { return 0; }
 
+    /**
+     * Get the size and last modification time of the file.
+     *
+     * @return  True if the information is available, false otherwise
+     */
+    virtual bool getStats(uInt64& size, uInt64& modtime) const { return false; }
+
     /**
      * The parent node of this directory.
      * The parent of the root is the root itself.
@@ -18,6 +18,7 @@
 #ifdef DEBUGGER_SUPPORT
   #include "Debugger.hxx"
   #include "Expression.hxx"
+  #include "CompiledExpression.hxx"
   #include "CartDebug.hxx"
   #include "PackedBitArray.hxx"
   #include "TIA.hxx"
@@ -44,6 +45,7 @@
 #endif
 #include "Settings.hxx"
 #include "Vec.hxx"
+#include "BenchmarkTimer.hxx"
 
 #include "System.hxx"
 #include "M6502.hxx"
@@ -213,9 +215,89 @@ void M6502::updateStepStateByInstruction()
   myStepStateByInstruction = myCondBreaks.size() || myCondSaveStates.size() || myTrapConds.size();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#ifdef DEBUGGER_SUPPORT
+bool M6502::checkBreaks()
+{
+  if(myJustHitReadTrapFlag || myJustHitWriteTrapFlag)
+  {
+    bool read = myJustHitReadTrapFlag;
+    myJustHitReadTrapFlag = myJustHitWriteTrapFlag = false;
+    if(myDebugger && myDebugger->start(myHitTrapInfo.message, myHitTrapInfo.address, read))
+    {
+      return true;
+    }
+  }
+
+  if(myBreakPoints.isInitialized() && myBreakPoints.isSet(PC))
+    if(myDebugger && myDebugger->start("BP: ", PC))
+      return true;
+
+  int cond = evalCondBreaks();
+  if(cond > -1)
+  {
+    stringstream msg;
+    msg << "CBP[" << Common::Base::HEX2 << cond << "]: " << myCondBreakNames[cond];
+    if(myDebugger && myDebugger->start(msg.str()))
+      return true;
+  }
+
+  cond = evalCondSaveStates();
+  if(cond > -1)
+  {
+    stringstream msg;
+    msg << "conditional savestate [" << Common::Base::HEX2 << cond << "]";
+    myDebugger->addState(msg.str());
+  }
+
+  return false;
+}
+#endif  // DEBUGGER_SUPPORT
+
+// Computed goto is a GCC/Clang extension; other compilers always use the
+// switch-based instruction dispatch
+#if defined(THREADED_DISPATCH) && defined(__GNUC__)
+  #define M6502_THREADED_DISPATCH
+#endif
+
+// Work done before each instruction: check for debugger breaks and fetch
+// the instruction at the program counter (this address represents a code
+// section)
+#ifdef DEBUGGER_SUPPORT
+  #define FETCH_INSTRUCTION                                  \
+    if(checkBreaks())                                        \
+      return true;                                           \
+    operandAddress = intermediateAddress = 0;                \
+    operand = 0;                                             \
+    myLastPeekAddress = myLastPokeAddress = myDataAddressForPoke = 0; \
+    icycles = 0;                                             \
+    IR = peek(PC++, DISASM_CODE);
+#else
+  #define FETCH_INSTRUCTION                                  \
+    operandAddress = intermediateAddress = 0;                \
+    operand = 0;                                             \
+    myLastPeekAddress = myLastPokeAddress = myDataAddressForPoke = 0; \
+    icycles = 0;                                             \
+    IR = peek(PC++, DISASM_CODE);
+#endif
+
+// Work done after each instruction
+#ifdef DEBUGGER_SUPPORT
+  #define FINISH_INSTRUCTION                                 \
+    if(myStepStateByInstruction)                             \
+    {                                                        \
+      tia.updateEmulation();                                 \
+      riot.updateEmulation();                                \
+    }
+#else
+  #define FINISH_INSTRUCTION
+#endif
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool M6502::execute(uInt32 number)
 {
+  BenchmarkTimer::Scope timer(BenchmarkTimer::CPU);
+
   // Clear all of the execution status bits except for the fatal error bit
   myExecutionStatus &= FatalErrorBit;
 
@@ -224,53 +306,67 @@ bool M6502::execute(uInt32 number)
   M6532& riot = mySystem->m6532();
 #endif
 
+  uInt16 operandAddress = 0, intermediateAddress = 0;
+  uInt8 operand = 0;
+
   // Loop until execution is stopped or a fatal error occurs
   for(;;)
   {
-    for(; !myExecutionStatus && (number != 0); --number)
+#ifdef M6502_THREADED_DISPATCH
+    // Each instruction jumps directly to the code of the next one, so that
+    // every instruction has its own (better predictable) indirect branch
+    static const void* const ourOpcodes[256] = {
+      #define L(_a, _b, _c, _d) &&opcode_##_a, &&opcode_##_b, &&opcode_##_c, &&opcode_##_d
+      L(0x00, 0x01, 0x02, 0x03), L(0x04, 0x05, 0x06, 0x07), L(0x08, 0x09, 0x0a, 0x0b), L(0x0c, 0x0d, 0x0e, 0x0f),
+      L(0x10, 0x11, 0x12, 0x13), L(0x14, 0x15, 0x16, 0x17), L(0x18, 0x19, 0x1a, 0x1b), L(0x1c, 0x1d, 0x1e, 0x1f),
+      L(0x20, 0x21, 0x22, 0x23), L(0x24, 0x25, 0x26, 0x27), L(0x28, 0x29, 0x2a, 0x2b), L(0x2c, 0x2d, 0x2e, 0x2f),
+      L(0x30, 0x31, 0x32, 0x33), L(0x34, 0x35, 0x36, 0x37), L(0x38, 0x39, 0x3a, 0x3b), L(0x3c, 0x3d, 0x3e, 0x3f),
+      L(0x40, 0x41, 0x42, 0x43), L(0x44, 0x45, 0x46, 0x47), L(0x48, 0x49, 0x4a, 0x4b), L(0x4c, 0x4d, 0x4e, 0x4f),
+      L(0x50, 0x51, 0x52, 0x53), L(0x54, 0x55, 0x56, 0x57), L(0x58, 0x59, 0x5a, 0x5b), L(0x5c, 0x5d, 0x5e, 0x5f),
+      L(0x60, 0x61, 0x62, 0x63), L(0x64, 0x65, 0x66, 0x67), L(0x68, 0x69, 0x6a, 0x6b), L(0x6c, 0x6d, 0x6e, 0x6f),
+      L(0x70, 0x71, 0x72, 0x73), L(0x74, 0x75, 0x76, 0x77), L(0x78, 0x79, 0x7a, 0x7b), L(0x7c, 0x7d, 0x7e, 0x7f),
+      L(0x80, 0x81, 0x82, 0x83), L(0x84, 0x85, 0x86, 0x87), L(0x88, 0x89, 0x8a, 0x8b), L(0x8c, 0x8d, 0x8e, 0x8f),
+      L(0x90, 0x91, 0x92, 0x93), L(0x94, 0x95, 0x96, 0x97), L(0x98, 0x99, 0x9a, 0x9b), L(0x9c, 0x9d, 0x9e, 0x9f),
+      L(0xa0, 0xa1, 0xa2, 0xa3), L(0xa4, 0xa5, 0xa6, 0xa7), L(0xa8, 0xa9, 0xaa, 0xab), L(0xac, 0xad, 0xae, 0xaf),
+      L(0xb0, 0xb1, 0xb2, 0xb3), L(0xb4, 0xb5, 0xb6, 0xb7), L(0xb8, 0xb9, 0xba, 0xbb), L(0xbc, 0xbd, 0xbe, 0xbf),
+      L(0xc0, 0xc1, 0xc2, 0xc3), L(0xc4, 0xc5, 0xc6, 0xc7), L(0xc8, 0xc9, 0xca, 0xcb), L(0xcc, 0xcd, 0xce, 0xcf),
+      L(0xd0, 0xd1, 0xd2, 0xd3), L(0xd4, 0xd5, 0xd6, 0xd7), L(0xd8, 0xd9, 0xda, 0xdb), L(0xdc, 0xdd, 0xde, 0xdf),
+      L(0xe0, 0xe1, 0xe2, 0xe3), L(0xe4, 0xe5, 0xe6, 0xe7), L(0xe8, 0xe9, 0xea, 0xeb), L(0xec, 0xed, 0xee, 0xef),
+      L(0xf0, 0xf1, 0xf2, 0xf3), L(0xf4, 0xf5, 0xf6, 0xf7), L(0xf8, 0xf9, 0xfa, 0xfb), L(0xfc, 0xfd, 0xfe, 0xff)
+      #undef L
+    };
+
+    #define OPCODE(_op) opcode_##_op:
+    #define NEXT_OPCODE                                      \
+      FINISH_INSTRUCTION                                     \
+      if(--number == 0 || myExecutionStatus)                 \
+        goto instructionsDone;                               \
+      FETCH_INSTRUCTION                                      \
+      goto *ourOpcodes[IR];
+
+    if(!myExecutionStatus && (number != 0))
     {
-#ifdef DEBUGGER_SUPPORT
-      if(myJustHitReadTrapFlag || myJustHitWriteTrapFlag)
-      {
-        bool read = myJustHitReadTrapFlag;
-        myJustHitReadTrapFlag = myJustHitWriteTrapFlag = false;
-        if(myDebugger && myDebugger->start(myHitTrapInfo.message, myHitTrapInfo.address, read))
-        {
-          return true;
-        }
-      }
-
-      if(myBreakPoints.isInitialized() && myBreakPoints.isSet(PC))
-        if(myDebugger && myDebugger->start("BP: ", PC))
-          return true;
-
-      int cond = evalCondBreaks();
-      if(cond > -1)
-      {
-        stringstream msg;
-        msg << "CBP[" << Common::Base::HEX2 << cond << "]: " << myCondBreakNames[cond];
-        if(myDebugger && myDebugger->start(msg.str()))
-          return true;
-      }
-
-      cond = evalCondSaveStates();
-      if(cond > -1)
-      {
-        stringstream msg;
-        msg << "conditional savestate [" << Common::Base::HEX2 << cond << "]";
-        myDebugger->addState(msg.str());
-      }
-#endif  // DEBUGGER_SUPPORT
-
-      uInt16 operandAddress = 0, intermediateAddress = 0;
-      uInt8 operand = 0;
-
-      // Reset the peek/poke address pointers
-      myLastPeekAddress = myLastPokeAddress = myDataAddressForPoke = 0;
+      FETCH_INSTRUCTION
+      goto *ourOpcodes[IR];
+
+      // 6502 instruction emulation is generated by an M4 macro file
+      #include "M6502.ins"
+
+      OPCODE(0x02) OPCODE(0x12) OPCODE(0x22) OPCODE(0x32)
+      OPCODE(0x42) OPCODE(0x52) OPCODE(0x62) OPCODE(0x72)
+      OPCODE(0x92) OPCODE(0xb2) OPCODE(0xd2) OPCODE(0xf2)
+        // Oops, illegal instruction executed so set fatal error flag
+        myExecutionStatus |= FatalErrorBit;
+        NEXT_OPCODE
+    }
+  instructionsDone:
 
-      icycles = 0;
-      // Fetch instruction at the program counter
-      IR = peek(PC++, DISASM_CODE);  // This address represents a code section
+    #undef OPCODE
+    #undef NEXT_OPCODE
+#else
+    for(; !myExecutionStatus && (number != 0); --number)
+    {
+      FETCH_INSTRUCTION
 
       // Call code to execute the instruction
       switch(IR)
@@ -282,15 +378,10 @@ bool M6502::execute(uInt32 number)
           // Oops, illegal instruction executed so set fatal error flag
           myExecutionStatus |= FatalErrorBit;
       }
-      //cycles = mySystem->cycles() - c0;
 
-#ifdef DEBUGGER_SUPPORT
-      if (myStepStateByInstruction) {
-        tia.updateEmulation();
-        riot.updateEmulation();
-      }
-#endif
+      FINISH_INSTRUCTION
     }
+#endif  // M6502_THREADED_DISPATCH
 
     // See if we need to handle an interrupt
     if((myExecutionStatus & MaskableInterruptBit) ||
@@ -474,7 +565,7 @@ void M6502::attach(Debugger& debugger)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 M6502::addCondBreak(Expression* e, const string& name)
 {
-  myCondBreaks.emplace_back(e);
+  myCondBreaks.emplace_back(new CompiledExpression(e));
   myCondBreakNames.push_back(name);
 
   updateStepStateByInstruction();
@@ -515,7 +606,7 @@ const StringList& M6502::getCondBreakNames() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 M6502::addCondSaveState(Expression* e, const string& name)
 {
-  myCondSaveStates.emplace_back(e);
+  myCondSaveStates.emplace_back(new CompiledExpression(e));
   myCondSaveStateNames.push_back(name);
 
   updateStepStateByInstruction();
@@ -556,7 +647,7 @@ const StringList& M6502::getCondSaveStateNames() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 M6502::addCondTrap(Expression* e, const string& name)
 {
-  myTrapConds.emplace_back(e);
+  myTrapConds.emplace_back(new CompiledExpression(e));
   myTrapCondNames.push_back(name);
 
   updateStepStateByInstruction();
@@ -398,6 +398,14 @@ class M6502 : public Serializable
       saveStateAction
     };
 
+    /**
+      Check for traps, breakpoints and conditional breaks/save states at
+      the current instruction, starting the debugger if one of them hit.
+
+      @return  True if the debugger was started (execution must stop)
+    */
+    bool checkBreaks();
+
     Int32 evalCondBreaks() {
       for(uInt32 i = 0; i < myCondBreaks.size(); i++)
         if(myCondBreaks[i]->evaluate())
@@ -44,6 +44,14 @@
   #endif
 #endif
 
+#ifndef OPCODE
+  #define OPCODE(_op) case _op:
+#endif
+
+#ifndef NEXT_OPCODE
+  #define NEXT_OPCODE break;
+#endif
+
 #ifndef SET_LAST_POKE
   #ifdef DEBUGGER_SUPPORT
     #define SET_LAST_POKE(_addr) myDataAddressForPoke = _addr;
@@ -1009,1330 +1017,1330 @@ define(M6502_TYA, `{
 
 //////////////////////////////////////////////////
 // ADC
-case 0x69:
+OPCODE(0x69)
 M6502_IMMEDIATE_READ
 M6502_ADC
-break;
+NEXT_OPCODE
 
-case 0x65:
+OPCODE(0x65)
 M6502_ZERO_READ
 M6502_ADC
-break;
+NEXT_OPCODE
 
-case 0x75:
+OPCODE(0x75)
 M6502_ZEROX_READ
 M6502_ADC
-break;
+NEXT_OPCODE
 
-case 0x6d:
+OPCODE(0x6d)
 M6502_ABSOLUTE_READ
 M6502_ADC
-break;
+NEXT_OPCODE
 
-case 0x7d:
+OPCODE(0x7d)
 M6502_ABSOLUTEX_READ
 M6502_ADC
-break;
+NEXT_OPCODE
 
-case 0x79:
+OPCODE(0x79)
 M6502_ABSOLUTEY_READ
 M6502_ADC
-break;
+NEXT_OPCODE
 
-case 0x61:
+OPCODE(0x61)
 M6502_INDIRECTX_READ
 M6502_ADC
-break;
+NEXT_OPCODE
 
-case 0x71:
+OPCODE(0x71)
 M6502_INDIRECTY_READ
 M6502_ADC
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // ASR
-case 0x4b:
+OPCODE(0x4b)
 M6502_IMMEDIATE_READ
 M6502_ASR
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // ANC
-case 0x0b:
-case 0x2b:
+OPCODE(0x0b)
+OPCODE(0x2b)
 M6502_IMMEDIATE_READ
 M6502_ANC
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // AND
-case 0x29:
+OPCODE(0x29)
 M6502_IMMEDIATE_READ
 M6502_AND
-break;
+NEXT_OPCODE
 
-case 0x25:
+OPCODE(0x25)
 M6502_ZERO_READ
 M6502_AND
-break;
+NEXT_OPCODE
 
-case 0x35:
+OPCODE(0x35)
 M6502_ZEROX_READ
 M6502_AND
-break;
+NEXT_OPCODE
 
-case 0x2d:
+OPCODE(0x2d)
 M6502_ABSOLUTE_READ
 M6502_AND
-break;
+NEXT_OPCODE
 
-case 0x3d:
+OPCODE(0x3d)
 M6502_ABSOLUTEX_READ
 M6502_AND
-break;
+NEXT_OPCODE
 
-case 0x39:
+OPCODE(0x39)
 M6502_ABSOLUTEY_READ
 M6502_AND
-break;
+NEXT_OPCODE
 
-case 0x21:
+OPCODE(0x21)
 M6502_INDIRECTX_READ
 M6502_AND
-break;
+NEXT_OPCODE
 
-case 0x31:
+OPCODE(0x31)
 M6502_INDIRECTY_READ
 M6502_AND
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // ANE
-case 0x8b:
+OPCODE(0x8b)
 M6502_IMMEDIATE_READ
 M6502_ANE
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // ARR
-case 0x6b:
+OPCODE(0x6b)
 M6502_IMMEDIATE_READ
 M6502_ARR
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // ASL
-case 0x0a:
+OPCODE(0x0a)
 M6502_IMPLIED
 M6502_ASLA
-break;
+NEXT_OPCODE
 
-case 0x06:
+OPCODE(0x06)
 M6502_ZERO_READMODIFYWRITE
 M6502_ASL
-break;
+NEXT_OPCODE
 
-case 0x16:
+OPCODE(0x16)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ASL
-break;
+NEXT_OPCODE
 
-case 0x0e:
+OPCODE(0x0e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ASL
-break;
+NEXT_OPCODE
 
-case 0x1e:
+OPCODE(0x1e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ASL
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // BIT
-case 0x24:
+OPCODE(0x24)
 M6502_ZERO_READ
 M6502_BIT
-break;
+NEXT_OPCODE
 
-case 0x2C:
+OPCODE(0x2c)
 M6502_ABSOLUTE_READ
 M6502_BIT
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // Branches
-case 0x90:
+OPCODE(0x90)
 M6502_IMMEDIATE_READ
 M6502_BCC
-break;
+NEXT_OPCODE
 
 
-case 0xb0:
+OPCODE(0xb0)
 M6502_IMMEDIATE_READ
 M6502_BCS
-break;
+NEXT_OPCODE
 
 
-case 0xf0:
+OPCODE(0xf0)
 M6502_IMMEDIATE_READ
 M6502_BEQ
-break;
+NEXT_OPCODE
 
 
-case 0x30:
+OPCODE(0x30)
 M6502_IMMEDIATE_READ
 M6502_BMI
-break;
+NEXT_OPCODE
 
 
-case 0xD0:
+OPCODE(0xd0)
 M6502_IMMEDIATE_READ
 M6502_BNE
-break;
+NEXT_OPCODE
 
 
-case 0x10:
+OPCODE(0x10)
 M6502_IMMEDIATE_READ
 M6502_BPL
-break;
+NEXT_OPCODE
 
 
-case 0x50:
+OPCODE(0x50)
 M6502_IMMEDIATE_READ
 M6502_BVC
-break;
+NEXT_OPCODE
 
 
-case 0x70:
+OPCODE(0x70)
 M6502_IMMEDIATE_READ
 M6502_BVS
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // BRK
-case 0x00:
+OPCODE(0x00)
 M6502_BRK
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // CLC
-case 0x18:
+OPCODE(0x18)
 M6502_IMPLIED
 M6502_CLC
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // CLD
-case 0xd8:
+OPCODE(0xd8)
 M6502_IMPLIED
 M6502_CLD
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // CLI
-case 0x58:
+OPCODE(0x58)
 M6502_IMPLIED
 M6502_CLI
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // CLV
-case 0xb8:
+OPCODE(0xb8)
 M6502_IMPLIED
 M6502_CLV
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // CMP
-case 0xc9:
+OPCODE(0xc9)
 M6502_IMMEDIATE_READ
 M6502_CMP
-break;
+NEXT_OPCODE
 
-case 0xc5:
+OPCODE(0xc5)
 M6502_ZERO_READ
 M6502_CMP
-break;
+NEXT_OPCODE
 
-case 0xd5:
+OPCODE(0xd5)
 M6502_ZEROX_READ
 M6502_CMP
-break;
+NEXT_OPCODE
 
-case 0xcd:
+OPCODE(0xcd)
 M6502_ABSOLUTE_READ
 M6502_CMP
-break;
+NEXT_OPCODE
 
-case 0xdd:
+OPCODE(0xdd)
 M6502_ABSOLUTEX_READ
 M6502_CMP
-break;
+NEXT_OPCODE
 
-case 0xd9:
+OPCODE(0xd9)
 M6502_ABSOLUTEY_READ
 M6502_CMP
-break;
+NEXT_OPCODE
 
-case 0xc1:
+OPCODE(0xc1)
 M6502_INDIRECTX_READ
 M6502_CMP
-break;
+NEXT_OPCODE
 
-case 0xd1:
+OPCODE(0xd1)
 M6502_INDIRECTY_READ
 M6502_CMP
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // CPX
-case 0xe0:
+OPCODE(0xe0)
 M6502_IMMEDIATE_READ
 M6502_CPX
-break;
+NEXT_OPCODE
 
-case 0xe4:
+OPCODE(0xe4)
 M6502_ZERO_READ
 M6502_CPX
-break;
+NEXT_OPCODE
 
-case 0xec:
+OPCODE(0xec)
 M6502_ABSOLUTE_READ
 M6502_CPX
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // CPY
-case 0xc0:
+OPCODE(0xc0)
 M6502_IMMEDIATE_READ
 M6502_CPY
-break;
+NEXT_OPCODE
 
-case 0xc4:
+OPCODE(0xc4)
 M6502_ZERO_READ
 M6502_CPY
-break;
+NEXT_OPCODE
 
-case 0xcc:
+OPCODE(0xcc)
 M6502_ABSOLUTE_READ
 M6502_CPY
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // DCP
-case 0xcf:
+OPCODE(0xcf)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_DCP
-break;
+NEXT_OPCODE
 
-case 0xdf:
+OPCODE(0xdf)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_DCP
-break;
+NEXT_OPCODE
 
-case 0xdb:
+OPCODE(0xdb)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_DCP
-break;
+NEXT_OPCODE
 
-case 0xc7:
+OPCODE(0xc7)
 M6502_ZERO_READMODIFYWRITE
 M6502_DCP
-break;
+NEXT_OPCODE
 
-case 0xd7:
+OPCODE(0xd7)
 M6502_ZEROX_READMODIFYWRITE
 M6502_DCP
-break;
+NEXT_OPCODE
 
-case 0xc3:
+OPCODE(0xc3)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_DCP
-break;
+NEXT_OPCODE
 
-case 0xd3:
+OPCODE(0xd3)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_DCP
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // DEC
-case 0xc6:
+OPCODE(0xc6)
 M6502_ZERO_READMODIFYWRITE
 M6502_DEC
-break;
+NEXT_OPCODE
 
-case 0xd6:
+OPCODE(0xd6)
 M6502_ZEROX_READMODIFYWRITE
 M6502_DEC
-break;
+NEXT_OPCODE
 
-case 0xce:
+OPCODE(0xce)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_DEC
-break;
+NEXT_OPCODE
 
-case 0xde:
+OPCODE(0xde)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_DEC
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // DEX
-case 0xca:
+OPCODE(0xca)
 M6502_IMPLIED
 M6502_DEX
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // DEY
-case 0x88:
+OPCODE(0x88)
 M6502_IMPLIED
 M6502_DEY
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // EOR
-case 0x49:
+OPCODE(0x49)
 M6502_IMMEDIATE_READ
 M6502_EOR
-break;
+NEXT_OPCODE
 
-case 0x45:
+OPCODE(0x45)
 M6502_ZERO_READ
 M6502_EOR
-break;
+NEXT_OPCODE
 
-case 0x55:
+OPCODE(0x55)
 M6502_ZEROX_READ
 M6502_EOR
-break;
+NEXT_OPCODE
 
-case 0x4d:
+OPCODE(0x4d)
 M6502_ABSOLUTE_READ
 M6502_EOR
-break;
+NEXT_OPCODE
 
-case 0x5d:
+OPCODE(0x5d)
 M6502_ABSOLUTEX_READ
 M6502_EOR
-break;
+NEXT_OPCODE
 
-case 0x59:
+OPCODE(0x59)
 M6502_ABSOLUTEY_READ
 M6502_EOR
-break;
+NEXT_OPCODE
 
-case 0x41:
+OPCODE(0x41)
 M6502_INDIRECTX_READ
 M6502_EOR
-break;
+NEXT_OPCODE
 
-case 0x51:
+OPCODE(0x51)
 M6502_INDIRECTY_READ
 M6502_EOR
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // INC
-case 0xe6:
+OPCODE(0xe6)
 M6502_ZERO_READMODIFYWRITE
 M6502_INC
-break;
+NEXT_OPCODE
 
-case 0xf6:
+OPCODE(0xf6)
 M6502_ZEROX_READMODIFYWRITE
 M6502_INC
-break;
+NEXT_OPCODE
 
-case 0xee:
+OPCODE(0xee)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_INC
-break;
+NEXT_OPCODE
 
-case 0xfe:
+OPCODE(0xfe)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_INC
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // INX
-case 0xe8:
+OPCODE(0xe8)
 M6502_IMPLIED
 M6502_INX
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // INY
-case 0xc8:
+OPCODE(0xc8)
 M6502_IMPLIED
 M6502_INY
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // ISB
-case 0xef:
+OPCODE(0xef)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ISB
-break;
+NEXT_OPCODE
 
-case 0xff:
+OPCODE(0xff)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ISB
-break;
+NEXT_OPCODE
 
-case 0xfb:
+OPCODE(0xfb)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_ISB
-break;
+NEXT_OPCODE
 
-case 0xe7:
+OPCODE(0xe7)
 M6502_ZERO_READMODIFYWRITE
 M6502_ISB
-break;
+NEXT_OPCODE
 
-case 0xf7:
+OPCODE(0xf7)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ISB
-break;
+NEXT_OPCODE
 
-case 0xe3:
+OPCODE(0xe3)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_ISB
-break;
+NEXT_OPCODE
 
-case 0xf3:
+OPCODE(0xf3)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_ISB
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // JMP
-case 0x4c:
+OPCODE(0x4c)
 M6502_ABSOLUTE_WRITE
 M6502_JMP
-break;
+NEXT_OPCODE
 
-case 0x6c:
+OPCODE(0x6c)
 M6502_INDIRECT
 M6502_JMP
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // JSR
-case 0x20:
+OPCODE(0x20)
 M6502_JSR
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // LAS
-case 0xbb:
+OPCODE(0xbb)
 M6502_ABSOLUTEY_READ
 M6502_LAS
-break;
+NEXT_OPCODE
 
 
 //////////////////////////////////////////////////
 // LAX
-case 0xaf:
+OPCODE(0xaf)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+NEXT_OPCODE
 
-case 0xbf:
+OPCODE(0xbf)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+NEXT_OPCODE
 
-case 0xa7:
+OPCODE(0xa7)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+NEXT_OPCODE
 
-case 0xb7:
+OPCODE(0xb7)
 M6502_ZEROY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)  // TODO - check this
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LAX
-break;
+NEXT_OPCODE
 
-case 0xa3:
+OPCODE(0xa3)
 M6502_INDIRECTX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)  // TODO - check this
 M6502_LAX
-break;
+NEXT_OPCODE
 
-case 0xb3:
+OPCODE(0xb3)
 M6502_INDIRECTY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)  // TODO - check this
 M6502_LAX
-break;
+NEXT_OPCODE
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // LDA
-case 0xa9:
+OPCODE(0xa9)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressA)
 M6502_LDA
-break;
+NEXT_OPCODE
 
-case 0xa5:
+OPCODE(0xa5)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+NEXT_OPCODE
 
-case 0xb5:
+OPCODE(0xb5)
 M6502_ZEROX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+NEXT_OPCODE
 
-case 0xad:
+OPCODE(0xad)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+NEXT_OPCODE
 
-case 0xbd:
+OPCODE(0xbd)
 M6502_ABSOLUTEX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+NEXT_OPCODE
 
-case 0xb9:
+OPCODE(0xb9)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+NEXT_OPCODE
 
-case 0xa1:
+OPCODE(0xa1)
 M6502_INDIRECTX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+NEXT_OPCODE
 
-case 0xb1:
+OPCODE(0xb1)
 M6502_INDIRECTY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_LDA
-break;
+NEXT_OPCODE
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // LDX
-case 0xa2:
+OPCODE(0xa2)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressX)
 M6502_LDX
-break;
+NEXT_OPCODE
 
-case 0xa6:
+OPCODE(0xa6)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+NEXT_OPCODE
 
-case 0xb6:
+OPCODE(0xb6)
 M6502_ZEROY_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+NEXT_OPCODE
 
-case 0xae:
+OPCODE(0xae)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+NEXT_OPCODE
 
-case 0xbe:
+OPCODE(0xbe)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressX, intermediateAddress)
 M6502_LDX
-break;
+NEXT_OPCODE
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // LDY
-case 0xa0:
+OPCODE(0xa0)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressY)
 M6502_LDY
-break;
+NEXT_OPCODE
 
-case 0xa4:
+OPCODE(0xa4)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+NEXT_OPCODE
 
-case 0xb4:
+OPCODE(0xb4)
 M6502_ZEROX_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+NEXT_OPCODE
 
-case 0xac:
+OPCODE(0xac)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+NEXT_OPCODE
 
-case 0xbc:
+OPCODE(0xbc)
 M6502_ABSOLUTEX_READ
 SET_LAST_PEEK(myLastSrcAddressY, intermediateAddress)
 M6502_LDY
-break;
+NEXT_OPCODE
 //////////////////////////////////////////////////
 
 //////////////////////////////////////////////////
 // LSR
-case 0x4a:
+OPCODE(0x4a)
 M6502_IMPLIED
 M6502_LSRA
-break;
+NEXT_OPCODE
 
 
-case 0x46:
+OPCODE(0x46)
 M6502_ZERO_READMODIFYWRITE
 M6502_LSR
-break;
+NEXT_OPCODE
 
-case 0x56:
+OPCODE(0x56)
 M6502_ZEROX_READMODIFYWRITE
 M6502_LSR
-break;
+NEXT_OPCODE
 
-case 0x4e:
+OPCODE(0x4e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_LSR
-break;
+NEXT_OPCODE
 
-case 0x5e:
+OPCODE(0x5e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_LSR
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // LXA
-case 0xab:
+OPCODE(0xab)
 M6502_IMMEDIATE_READ
 M6502_LXA
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // NOP
-case 0x1a:
-case 0x3a:
-case 0x5a:
-case 0x7a:
-case 0xda:
-case 0xea:
-case 0xfa:
+OPCODE(0x1a)
+OPCODE(0x3a)
+OPCODE(0x5a)
+OPCODE(0x7a)
+OPCODE(0xda)
+OPCODE(0xea)
+OPCODE(0xfa)
 M6502_IMPLIED
 M6502_NOP
-break;
+NEXT_OPCODE
 
-case 0x80:
-case 0x82:
-case 0x89:
-case 0xc2:
-case 0xe2:
+OPCODE(0x80)
+OPCODE(0x82)
+OPCODE(0x89)
+OPCODE(0xc2)
+OPCODE(0xe2)
 M6502_IMMEDIATE_READ
 M6502_NOP
-break;
+NEXT_OPCODE
 
-case 0x04:
-case 0x44:
-case 0x64:
+OPCODE(0x04)
+OPCODE(0x44)
+OPCODE(0x64)
 M6502_ZERO_READ
 M6502_NOP
-break;
-
-case 0x14:
-case 0x34:
-case 0x54:
-case 0x74:
-case 0xd4:
-case 0xf4:
+NEXT_OPCODE
+
+OPCODE(0x14)
+OPCODE(0x34)
+OPCODE(0x54)
+OPCODE(0x74)
+OPCODE(0xd4)
+OPCODE(0xf4)
 M6502_ZEROX_READ
 M6502_NOP
-break;
+NEXT_OPCODE
 
-case 0x0c:
+OPCODE(0x0c)
 M6502_ABSOLUTE_READ
 M6502_NOP
-break;
-
-case 0x1c:
-case 0x3c:
-case 0x5c:
-case 0x7c:
-case 0xdc:
-case 0xfc:
+NEXT_OPCODE
+
+OPCODE(0x1c)
+OPCODE(0x3c)
+OPCODE(0x5c)
+OPCODE(0x7c)
+OPCODE(0xdc)
+OPCODE(0xfc)
 M6502_ABSOLUTEX_READ
 M6502_NOP
-break;
+NEXT_OPCODE
 
 
 //////////////////////////////////////////////////
 // ORA
-case 0x09:
+OPCODE(0x09)
 M6502_IMMEDIATE_READ
 CLEAR_LAST_PEEK(myLastSrcAddressA)
 M6502_ORA
-break;
+NEXT_OPCODE
 
-case 0x05:
+OPCODE(0x05)
 M6502_ZERO_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+NEXT_OPCODE
 
-case 0x15:
+OPCODE(0x15)
 M6502_ZEROX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+NEXT_OPCODE
 
-case 0x0d:
+OPCODE(0x0d)
 M6502_ABSOLUTE_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+NEXT_OPCODE
 
-case 0x1d:
+OPCODE(0x1d)
 M6502_ABSOLUTEX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+NEXT_OPCODE
 
-case 0x19:
+OPCODE(0x19)
 M6502_ABSOLUTEY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+NEXT_OPCODE
 
-case 0x01:
+OPCODE(0x01)
 M6502_INDIRECTX_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+NEXT_OPCODE
 
-case 0x11:
+OPCODE(0x11)
 M6502_INDIRECTY_READ
 SET_LAST_PEEK(myLastSrcAddressA, intermediateAddress)
 M6502_ORA
-break;
+NEXT_OPCODE
 //////////////////////////////////////////////////
 
 //////////////////////////////////////////////////
 // PHA
-case 0x48:
+OPCODE(0x48)
 M6502_IMPLIED
 // TODO - add tracking for this opcode
 M6502_PHA
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // PHP
-case 0x08:
+OPCODE(0x08)
 M6502_IMPLIED
 // TODO - add tracking for this opcode
 M6502_PHP
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // PLA
-case 0x68:
+OPCODE(0x68)
 M6502_IMPLIED
 // TODO - add tracking for this opcode
 M6502_PLA
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // PLP
-case 0x28:
+OPCODE(0x28)
 M6502_IMPLIED
 // TODO - add tracking for this opcode
 M6502_PLP
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // RLA
-case 0x2f:
+OPCODE(0x2f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_RLA
-break;
+NEXT_OPCODE
 
-case 0x3f:
+OPCODE(0x3f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_RLA
-break;
+NEXT_OPCODE
 
-case 0x3b:
+OPCODE(0x3b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_RLA
-break;
+NEXT_OPCODE
 
-case 0x27:
+OPCODE(0x27)
 M6502_ZERO_READMODIFYWRITE
 M6502_RLA
-break;
+NEXT_OPCODE
 
-case 0x37:
+OPCODE(0x37)
 M6502_ZEROX_READMODIFYWRITE
 M6502_RLA
-break;
+NEXT_OPCODE
 
-case 0x23:
+OPCODE(0x23)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_RLA
-break;
+NEXT_OPCODE
 
-case 0x33:
+OPCODE(0x33)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_RLA
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // ROL
-case 0x2a:
+OPCODE(0x2a)
 M6502_IMPLIED
 M6502_ROLA
-break;
+NEXT_OPCODE
 
-case 0x26:
+OPCODE(0x26)
 M6502_ZERO_READMODIFYWRITE
 M6502_ROL
-break;
+NEXT_OPCODE
 
-case 0x36:
+OPCODE(0x36)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ROL
-break;
+NEXT_OPCODE
 
-case 0x2e:
+OPCODE(0x2e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ROL
-break;
+NEXT_OPCODE
 
-case 0x3e:
+OPCODE(0x3e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ROL
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // ROR
-case 0x6a:
+OPCODE(0x6a)
 M6502_IMPLIED
 M6502_RORA
-break;
+NEXT_OPCODE
 
-case 0x66:
+OPCODE(0x66)
 M6502_ZERO_READMODIFYWRITE
 M6502_ROR
-break;
+NEXT_OPCODE
 
-case 0x76:
+OPCODE(0x76)
 M6502_ZEROX_READMODIFYWRITE
 M6502_ROR
-break;
+NEXT_OPCODE
 
-case 0x6e:
+OPCODE(0x6e)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_ROR
-break;
+NEXT_OPCODE
 
-case 0x7e:
+OPCODE(0x7e)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_ROR
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // RRA
-case 0x6f:
+OPCODE(0x6f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_RRA
-break;
+NEXT_OPCODE
 
-case 0x7f:
+OPCODE(0x7f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_RRA
-break;
+NEXT_OPCODE
 
-case 0x7b:
+OPCODE(0x7b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_RRA
-break;
+NEXT_OPCODE
 
-case 0x67:
+OPCODE(0x67)
 M6502_ZERO_READMODIFYWRITE
 M6502_RRA
-break;
+NEXT_OPCODE
 
-case 0x77:
+OPCODE(0x77)
 M6502_ZEROX_READMODIFYWRITE
 M6502_RRA
-break;
+NEXT_OPCODE
 
-case 0x63:
+OPCODE(0x63)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_RRA
-break;
+NEXT_OPCODE
 
-case 0x73:
+OPCODE(0x73)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_RRA
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // RTI
-case 0x40:
+OPCODE(0x40)
 M6502_IMPLIED
 M6502_RTI
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // RTS
-case 0x60:
+OPCODE(0x60)
 M6502_IMPLIED
 M6502_RTS
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SAX
-case 0x8f:
+OPCODE(0x8f)
 M6502_ABSOLUTE_WRITE
 M6502_SAX
-break;
+NEXT_OPCODE
 
-case 0x87:
+OPCODE(0x87)
 M6502_ZERO_WRITE
 M6502_SAX
-break;
+NEXT_OPCODE
 
-case 0x97:
+OPCODE(0x97)
 M6502_ZEROY_WRITE
 M6502_SAX
-break;
+NEXT_OPCODE
 
-case 0x83:
+OPCODE(0x83)
 M6502_INDIRECTX_WRITE
 M6502_SAX
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SBC
-case 0xe9:
-case 0xeb:
+OPCODE(0xe9)
+OPCODE(0xeb)
 M6502_IMMEDIATE_READ
 M6502_SBC
-break;
+NEXT_OPCODE
 
-case 0xe5:
+OPCODE(0xe5)
 M6502_ZERO_READ
 M6502_SBC
-break;
+NEXT_OPCODE
 
-case 0xf5:
+OPCODE(0xf5)
 M6502_ZEROX_READ
 M6502_SBC
-break;
+NEXT_OPCODE
 
-case 0xed:
+OPCODE(0xed)
 M6502_ABSOLUTE_READ
 M6502_SBC
-break;
+NEXT_OPCODE
 
-case 0xfd:
+OPCODE(0xfd)
 M6502_ABSOLUTEX_READ
 M6502_SBC
-break;
+NEXT_OPCODE
 
-case 0xf9:
+OPCODE(0xf9)
 M6502_ABSOLUTEY_READ
 M6502_SBC
-break;
+NEXT_OPCODE
 
-case 0xe1:
+OPCODE(0xe1)
 M6502_INDIRECTX_READ
 M6502_SBC
-break;
+NEXT_OPCODE
 
-case 0xf1:
+OPCODE(0xf1)
 M6502_INDIRECTY_READ
 M6502_SBC
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SBX
-case 0xcb:
+OPCODE(0xcb)
 M6502_IMMEDIATE_READ
 M6502_SBX
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SEC
-case 0x38:
+OPCODE(0x38)
 M6502_IMPLIED
 M6502_SEC
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SED
-case 0xf8:
+OPCODE(0xf8)
 M6502_IMPLIED
 M6502_SED
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SEI
-case 0x78:
+OPCODE(0x78)
 M6502_IMPLIED
 M6502_SEI
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SHA
-case 0x9f:
+OPCODE(0x9f)
 M6502_ABSOLUTEY_WRITE
 M6502_SHA
-break;
+NEXT_OPCODE
 
-case 0x93:
+OPCODE(0x93)
 M6502_INDIRECTY_WRITE
 M6502_SHA
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SHS
-case 0x9b:
+OPCODE(0x9b)
 M6502_ABSOLUTEY_WRITE
 M6502_SHS
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SHX
-case 0x9e:
+OPCODE(0x9e)
 M6502_ABSOLUTEY_WRITE
 M6502_SHX
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SHY
-case 0x9c:
+OPCODE(0x9c)
 M6502_ABSOLUTEX_WRITE
 M6502_SHY
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SLO
-case 0x0f:
+OPCODE(0x0f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_SLO
-break;
+NEXT_OPCODE
 
-case 0x1f:
+OPCODE(0x1f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_SLO
-break;
+NEXT_OPCODE
 
-case 0x1b:
+OPCODE(0x1b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_SLO
-break;
+NEXT_OPCODE
 
-case 0x07:
+OPCODE(0x07)
 M6502_ZERO_READMODIFYWRITE
 M6502_SLO
-break;
+NEXT_OPCODE
 
-case 0x17:
+OPCODE(0x17)
 M6502_ZEROX_READMODIFYWRITE
 M6502_SLO
-break;
+NEXT_OPCODE
 
-case 0x03:
+OPCODE(0x03)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_SLO
-break;
+NEXT_OPCODE
 
-case 0x13:
+OPCODE(0x13)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_SLO
-break;
+NEXT_OPCODE
 
 //////////////////////////////////////////////////
 // SRE
-case 0x4f:
+OPCODE(0x4f)
 M6502_ABSOLUTE_READMODIFYWRITE
 M6502_SRE
-break;
+NEXT_OPCODE
 
-case 0x5f:
+OPCODE(0x5f)
 M6502_ABSOLUTEX_READMODIFYWRITE
 M6502_SRE
-break;
+NEXT_OPCODE
 
-case 0x5b:
+OPCODE(0x5b)
 M6502_ABSOLUTEY_READMODIFYWRITE
 M6502_SRE
-break;
+NEXT_OPCODE
 
-case 0x47:
+OPCODE(0x47)
 M6502_ZERO_READMODIFYWRITE
 M6502_SRE
-break;
+NEXT_OPCODE
 
-case 0x57:
+OPCODE(0x57)
 M6502_ZEROX_READMODIFYWRITE
 M6502_SRE
-break;
+NEXT_OPCODE
 
-case 0x43:
+OPCODE(0x43)
 M6502_INDIRECTX_READMODIFYWRITE
 M6502_SRE
-break;
+NEXT_OPCODE
 
-case 0x53:
+OPCODE(0x53)
 M6502_INDIRECTY_READMODIFYWRITE
 M6502_SRE
-break;
+NEXT_OPCODE
 
 
 //////////////////////////////////////////////////
 // STA
-case 0x85:
+OPCODE(0x85)
 M6502_ZERO_WRITE
 SET_LAST_POKE(myLastSrcAddressA)
 M6502_STA
-break;
+NEXT_OPCODE
 
-case 0x95:
+OPCODE(0x95)
 M6502_ZEROX_WRITE
 M6502_STA
-break;
+NEXT_OPCODE
 
-case 0x8d:
+OPCODE(0x8d)
 M6502_ABSOLUTE_WRITE
 M6502_STA
-break;
+NEXT_OPCODE
 
-case 0x9d:
+OPCODE(0x9d)
 M6502_ABSOLUTEX_WRITE
 M6502_STA
-break;
+NEXT_OPCODE
 
-case 0x99:
+OPCODE(0x99)
 M6502_ABSOLUTEY_WRITE
 M6502_STA
-break;
+NEXT_OPCODE
 
-case 0x81:
+OPCODE(0x81)
 M6502_INDIRECTX_WRITE
 M6502_STA
-break;
+NEXT_OPCODE
 
-case 0x91:
+OPCODE(0x91)
 M6502_INDIRECTY_WRITE
 M6502_STA
-break;
+NEXT_OPCODE
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // STX
-case 0x86:
+OPCODE(0x86)
 M6502_ZERO_WRITE
 SET_LAST_POKE(myLastSrcAddressX)
 M6502_STX
-break;
+NEXT_OPCODE
 
-case 0x96:
+OPCODE(0x96)
 M6502_ZEROY_WRITE
 M6502_STX
-break;
+NEXT_OPCODE
 
-case 0x8e:
+OPCODE(0x8e)
 M6502_ABSOLUTE_WRITE
 M6502_STX
-break;
+NEXT_OPCODE
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // STY
-case 0x84:
+OPCODE(0x84)
 M6502_ZERO_WRITE
 SET_LAST_POKE(myLastSrcAddressY)
 M6502_STY
-break;
+NEXT_OPCODE
 
-case 0x94:
+OPCODE(0x94)
 M6502_ZEROX_WRITE
 M6502_STY
-break;
+NEXT_OPCODE
 
-case 0x8c:
+OPCODE(0x8c)
 M6502_ABSOLUTE_WRITE
 M6502_STY
-break;
+NEXT_OPCODE
 //////////////////////////////////////////////////
 
 
 //////////////////////////////////////////////////
 // Remaining MOVE opcodes
-case 0xaa:
+OPCODE(0xaa)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressX, myLastSrcAddressA)
 M6502_TAX
-break;
+NEXT_OPCODE
 
 
-case 0xa8:
+OPCODE(0xa8)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressY, myLastSrcAddressA)
 M6502_TAY
-break;
+NEXT_OPCODE
 
 
-case 0xba:
+OPCODE(0xba)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressX, myLastSrcAddressS)
 M6502_TSX
-break;
+NEXT_OPCODE
 
 
-case 0x8a:
+OPCODE(0x8a)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressA, myLastSrcAddressX)
 M6502_TXA
-break;
+NEXT_OPCODE
 
 
-case 0x9a:
+OPCODE(0x9a)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressS, myLastSrcAddressX)
 M6502_TXS
-break;
+NEXT_OPCODE
 
 
-case 0x98:
+OPCODE(0x98)
 M6502_IMPLIED
 SET_LAST_PEEK(myLastSrcAddressA, myLastSrcAddressY)
 M6502_TYA
-break;
+NEXT_OPCODE
 //////////////////////////////////////////////////
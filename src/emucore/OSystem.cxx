@@ -43,6 +43,8 @@
 #include "TIASurface.hxx"
 #include "Settings.hxx"
 #include "PropsSet.hxx"
+#include "BSTypeCache.hxx"
+#include "RomIndex.hxx"
 #include "EventHandler.hxx"
 #include "Menu.hxx"
 #include "CommandMenu.hxx"
@@ -132,16 +134,24 @@ bool OSystem::create()
   // Create a properties set for us to use and set it up
   myPropSet = make_unique<PropertiesSet>(propertiesFile());
 
+  // Remember the bankswitch types detected in previous runs
+  myBSTypeCache = make_unique<BSTypeCache>(myBSTypeCacheFile);
+
 #ifdef CHEATCODE_SUPPORT
   myCheatManager = make_unique<CheatManager>(*this);
   myCheatManager->loadCheatDatabase();
 #endif
 
   // Create menu and launcher GUI objects
-  myMenu = make_unique<Menu>(*this);
-  myCommandMenu = make_unique<CommandMenu>(*this);
-  myTimeMachine = make_unique<TimeMachine>(*this);
-  myLauncher = make_unique<Launcher>(*this);
+  // These are never shown in headless mode, so we don't bother creating them
+  if(!mySettings->getBool("headless"))
+  {
+    myMenu = make_unique<Menu>(*this);
+    myCommandMenu = make_unique<CommandMenu>(*this);
+    myTimeMachine = make_unique<TimeMachine>(*this);
+    myRomIndex = make_unique<RomIndex>(myRomIndexFile);
+    myLauncher = make_unique<Launcher>(*this);
+  }
   myStateManager = make_unique<StateManager>(*this);
 
   // Create the sound object; the sound subsystem isn't actually
@@ -181,6 +191,12 @@ void OSystem::saveConfig()
 
   if(myPropSet)
     myPropSet->save(myPropertiesFile);
+
+  if(myBSTypeCache)
+    myBSTypeCache->save(myBSTypeCacheFile);
+
+  if(myRomIndex)
+    myRomIndex->save(myRomIndexFile);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -215,6 +231,9 @@ void OSystem::setConfigPaths()
   node = FilesystemNode(s);
   myPropertiesFile = node.getPath();
   mySettings->setValue("propsfile", node.getShortPath());
+
+  myBSTypeCacheFile = FilesystemNode(myBaseDir + "stella.bsc").getPath();
+  myRomIndexFile = FilesystemNode(myBaseDir + "stella.idx").getPath();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -310,6 +329,10 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
     mySettings->setValue("romloadcount", 0);
   }
 
+  // Indexing the launcher directory would compete with emulation for I/O
+  if(myRomIndex)
+    myRomIndex->stopScan();
+
   // Create an instance of the 2600 game console
   ostringstream buf;
   try
@@ -344,6 +367,10 @@ string OSystem::createConsole(const FilesystemNode& rom, const string& md5sum,
     }
     myConsole->initializeAudio();
 
+    // Remember the display format, so the launcher can show it
+    if(myRomIndex)
+      myRomIndex->setFormat(myRomFile, myConsole->about().DisplayFormat);
+
     if(showmessage)
     {
       const string& id = myConsole->cartridge().multiCartID();
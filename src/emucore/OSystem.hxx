@@ -18,6 +18,7 @@
 #ifndef OSYSTEM_HXX
 #define OSYSTEM_HXX
 
+class BSTypeCache;
 #ifdef CHEATCODE_SUPPORT
 class CheatManager;
 #endif
@@ -33,6 +34,7 @@ class PNGLibrary;
 class Properties;
 class PropertiesSet;
 class Random;
+class RomIndex;
 class SerialPort;
 class Settings;
 class Sound;
@@ -64,6 +66,7 @@ class OSystem
   friend class EventHandler;
   friend class VideoDialog;
   friend class DeveloperDialog;
+  friend class HeadlessRunner;
 
   public:
     OSystem();
@@ -117,6 +120,20 @@ class OSystem
     */
     PropertiesSet& propSet() const { return *myPropSet; }
 
+    /**
+      Get the cache of autodetected bankswitch types for the system.
+
+      @return The bankswitch type cache object
+    */
+    BSTypeCache& bsTypeCache() const { return *myBSTypeCache; }
+
+    /**
+      Get the index of ROM file information used by the ROM launcher.
+
+      @return The ROM index object
+    */
+    RomIndex& romIndex() const { return *myRomIndex; }
+
     /**
       Get the console of the system.  The console won't always exist,
       so we should test if it's available.
@@ -454,6 +471,12 @@ class OSystem
     // Pointer to the PropertiesSet object
     unique_ptr<PropertiesSet> myPropSet;
 
+    // Pointer to the BSTypeCache object
+    unique_ptr<BSTypeCache> myBSTypeCache;
+
+    // Pointer to the RomIndex object
+    unique_ptr<RomIndex> myRomIndex;
+
     // Pointer to the (currently defined) Console object
     unique_ptr<Console> myConsole;
 
@@ -516,6 +539,8 @@ class OSystem
     string myConfigFile;
     string myPaletteFile;
     string myPropertiesFile;
+    string myBSTypeCacheFile;
+    string myRomIndexFile;
 
     FilesystemNode myRomFile;
     string myRomMD5;
@@ -89,34 +89,55 @@ bool PropertiesSet::getMD5(const string& md5, Properties& properties,
     }
   }
 
-  // Otherwise, search the internal database using binary search
+  // Otherwise, search the internal database
   if(!found)
   {
-    int low = 0, high = DEF_PROPS_SIZE - 1;
-    while(low <= high)
+    int i = findDefault(md5);
+    if(i >= 0)
     {
-      int i = (low + high) / 2;
-      int cmp = BSPF::compareIgnoreCase(md5, DefProps[i][Cartridge_MD5]);
+      for(int p = 0; p < LastPropType; ++p)
+        if(DefProps[i][p] != 0)
+          properties.set(PropertyType(p), DefPropsStrings[DefProps[i][p]]);
 
-      if(cmp == 0)  // found it
-      {
-        for(int p = 0; p < LastPropType; ++p)
-          if(DefProps[i][p][0] != 0)
-            properties.set(PropertyType(p), DefProps[i][p]);
-
-        found = true;
-        break;
-      }
-      else if(cmp < 0)
-        high = i - 1; // look at lower range
-      else
-        low = i + 1;  // look at upper range
+      found = true;
     }
   }
 
   return found;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int PropertiesSet::findDefault(const string& md5)
+{
+  // The database is indexed by a perfect hash of the md5, which is
+  // computed from its (case-insensitive) value as four 32-bit words
+  if(md5.length() != 32)
+    return -1;
+
+  uInt32 words[4] = { 0 };
+  for(uInt32 i = 0; i < 32; ++i)
+  {
+    char c = md5[i];
+    uInt32 digit;
+    if(c >= '0' && c <= '9')       digit = c - '0';
+    else if(c >= 'a' && c <= 'f')  digit = c - 'a' + 10;
+    else if(c >= 'A' && c <= 'F')  digit = c - 'A' + 10;
+    else                           return -1;
+
+    words[i / 8] = (words[i / 8] << 4) | digit;
+  }
+
+  // Every md5 maps to exactly one slot, so there's only one entry that
+  // can possibly match
+  uInt16 i = DefPropsHashTable[DefPropsHash(words[0], words[1], words[2])];
+  if(i != 0xFFFF &&
+     DefPropsMD5[i][0] == words[0] && DefPropsMD5[i][1] == words[1] &&
+     DefPropsMD5[i][2] == words[2] && DefPropsMD5[i][3] == words[3])
+    return i;
+
+  return -1;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PropertiesSet::getMD5WithInsert(const FilesystemNode& rom,
                                      const string& md5, Properties& properties)
@@ -199,10 +220,10 @@ void PropertiesSet::print() const
   {
     properties.setDefaults();
     for(int p = 0; p < LastPropType; ++p)
-      if(DefProps[i][p][0] != 0)
-        properties.set(PropertyType(p), DefProps[i][p]);
+      if(DefProps[i][p] != 0)
+        properties.set(PropertyType(p), DefPropsStrings[DefProps[i][p]]);
 
-    list.emplace(DefProps[i][Cartridge_MD5], properties);
+    list.emplace(DefPropsStrings[DefProps[i][Cartridge_MD5]], properties);
   }
 
   // Now, print the resulting list
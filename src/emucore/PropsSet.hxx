@@ -112,6 +112,17 @@ class PropertiesSet
     */
     void print() const;
 
+  private:
+    /**
+      Find the given md5 in the built-in properties database.
+
+      @param md5  The md5 of the properties to find
+
+      @return  The index of the properties in the database, or -1 if
+               the md5 wasn't found
+    */
+    static int findDefault(const string& md5);
+
   private:
     using PropsList = std::map<string, Properties>;
 
@@ -35,7 +35,8 @@ class Random : public Serializable
     /**
       Create a new random number generator
     */
-    Random(const OSystem& osystem) : myOSystem(osystem) { initSeed(); }
+    Random(const OSystem& osystem)
+      : myOSystem(osystem), myFixedSeed(0), myUseFixedSeed(false) { initSeed(); }
 
     /**
       Re-initialize the random number generator with a new seed,
@@ -43,7 +44,19 @@ class Random : public Serializable
     */
     void initSeed()
     {
-      myValue = uInt32(myOSystem.getTicks());
+      myValue = myUseFixedSeed ? myFixedSeed : uInt32(myOSystem.getTicks());
+    }
+
+    /**
+      Always use the given seed when re-initializing the random number
+      generator, instead of one based on the current time.  This makes
+      emulation repeatable (ie, when comparing results in headless mode).
+    */
+    void useFixedSeed(uInt32 seed)
+    {
+      myFixedSeed = seed;
+      myUseFixedSeed = true;
+      initSeed();
     }
 
     /**
@@ -120,6 +133,10 @@ class Random : public Serializable
     // random number)
     mutable uInt32 myValue;
 
+    // Seed to use instead of the current time (if enabled)
+    uInt32 myFixedSeed;
+    bool myUseFixedSeed;
+
   private:
     // Following constructors and assignment operators not supported
     Random() = delete;
@@ -0,0 +1,181 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include "CartDetector.hxx"
+#include "MD5.hxx"
+#include "Version.hxx"
+#include "RomIndex.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndex::RomIndex(const string& indexfile)
+  : myChanged(false),
+    myStopScan(false)
+{
+  load(indexfile);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomIndex::~RomIndex()
+{
+  stopScan();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::load(const string& filename)
+{
+  ifstream in(filename);
+
+  // Entries from other versions may no longer be valid
+  string line;
+  if(!getline(in, line) || line != "Stella " STELLA_VERSION)
+    return;
+
+  // Each line contains the tab-separated fields of one entry, starting
+  // with the path (which may contain spaces)
+  std::lock_guard<std::mutex> lock(myMutex);
+  while(getline(in, line))
+  {
+    string path, size, modtime, md5, type, format;
+    istringstream buf(line);
+    if(!(getline(buf, path, '\t') && getline(buf, size, '\t') &&
+         getline(buf, modtime, '\t') && getline(buf, md5, '\t') &&
+         getline(buf, type, '\t')))
+      continue;
+    getline(buf, format);
+
+    Entry& entry = myEntries[path];
+    entry.size = strtoull(size.c_str(), nullptr, 10);
+    entry.modtime = strtoull(modtime.c_str(), nullptr, 10);
+    entry.md5 = md5;
+    entry.type = Bankswitch::nameToType(type);
+    entry.format = format;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndex::save(const string& filename)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  if(!myChanged)
+    return true;
+
+  ofstream out(filename);
+  if(!out)
+    return false;
+
+  out << "Stella " STELLA_VERSION << endl;
+  for(const auto& i: myEntries)
+    out << i.first << '\t' << i.second.size << '\t' << i.second.modtime << '\t'
+        << i.second.md5 << '\t' << Bankswitch::typeToName(i.second.type) << '\t'
+        << i.second.format << endl;
+
+  myChanged = false;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomIndex::find(const FilesystemNode& node, Entry& entry, bool readROM)
+{
+  uInt64 size = 0, modtime = 0;
+  bool haveStats = node.getStats(size, modtime);
+  if(haveStats)
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    auto i = myEntries.find(node.getPath());
+    if(i != myEntries.end() &&
+       i->second.size == size && i->second.modtime == modtime)
+    {
+      entry = i->second;
+      return true;
+    }
+  }
+
+  // Not indexed yet, so the ROM must be read
+  // This is done without holding the lock, since it may take a while
+  if(!readROM)
+    return false;
+
+  BytePtr image;
+  uInt32 romsize = 0;
+  try
+  {
+    romsize = node.read(image);
+  }
+  catch(...)
+  {
+    return false;
+  }
+
+  entry.size = size;
+  entry.modtime = modtime;
+  entry.md5 = MD5::hash(image, romsize);
+  entry.type = CartDetector::autodetectType(image, romsize);
+  entry.format = "";
+
+  // Without the file stats, there's no way to know when the entry
+  // becomes invalid
+  if(haveStats)
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myEntries[node.getPath()] = entry;
+    myChanged = true;
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::setFormat(const FilesystemNode& node, const string& format)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  auto i = myEntries.find(node.getPath());
+  if(i != myEntries.end() && i->second.format != format)
+  {
+    i->second.format = format;
+    myChanged = true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::scan(const FSList& files)
+{
+  stopScan();
+  myScanThread = std::thread([this, files] { scanFiles(files); });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::stopScan()
+{
+  if(myScanThread.joinable())
+  {
+    myStopScan = true;
+    myScanThread.join();
+    myStopScan = false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomIndex::scanFiles(const FSList& files)
+{
+  Entry entry;
+  for(const auto& f: files)
+  {
+    if(myStopScan)
+      break;
+
+    find(f, entry);
+  }
+}
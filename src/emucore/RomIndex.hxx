@@ -0,0 +1,137 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef ROM_INDEX_HXX
+#define ROM_INDEX_HXX
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "bspf.hxx"
+#include "BSType.hxx"
+#include "FSNode.hxx"
+
+/**
+  This class remembers information about ROM files that is expensive to
+  compute, since the whole file must be read (and possibly decompressed).
+  Entries are keyed by the full path of the ROM, and are only valid as
+  long as the size and modification time of the file are unchanged.
+
+  The index can be filled by a background thread while the user browses
+  a directory, and is saved to disk between runs.  Like the bankswitch
+  type cache, the file is discarded when read by a different version.
+*/
+class RomIndex
+{
+  public:
+    struct Entry
+    {
+      uInt64 size;
+      uInt64 modtime;
+      string md5;
+      BSType type;    // autodetected bankswitch type
+      string format;  // display format, once the ROM has been started
+    };
+
+  public:
+    /**
+      Create an index object from the specified index file.
+    */
+    RomIndex(const string& indexfile);
+    ~RomIndex();
+
+  public:
+    /**
+      Load index entries from the specified file.
+
+      @param filename  Full pathname of input file to use
+    */
+    void load(const string& filename);
+
+    /**
+      Save index entries to the specified file, if any were changed
+      since it was loaded.
+
+      @param filename  Full pathname of output file to use
+
+      @return  True on success, false on failure
+               Failure occurs if file couldn't be opened for writing
+    */
+    bool save(const string& filename);
+
+    /**
+      Get the information for the given ROM file.  If it isn't indexed
+      yet (or the file has changed since), the ROM is read and the result
+      is added to the index.
+
+      @param node     The ROM file
+      @param entry    The information about the ROM, if found
+      @param readROM  Whether to read the ROM if it isn't indexed
+
+      @return  True if the information is available, false if the file
+               couldn't (or shouldn't) be read
+    */
+    bool find(const FilesystemNode& node, Entry& entry, bool readROM = true);
+
+    /**
+      Remember the display format of an already indexed ROM file.
+
+      @param node    The ROM file
+      @param format  The display format used for the ROM
+    */
+    void setFormat(const FilesystemNode& node, const string& format);
+
+    /**
+      Index the given files in a background thread.  Any scan still in
+      progress is stopped first.
+
+      @param files  The files to index
+    */
+    void scan(const FSList& files);
+
+    /**
+      Stop the background scan, if any, and wait for it to finish.
+    */
+    void stopScan();
+
+  private:
+    void scanFiles(const FSList& files);
+
+  private:
+    std::map<string, Entry> myEntries;
+
+    // Indicates whether the index must be written back to disk
+    bool myChanged;
+
+    // Entries are accessed both by the main and the scanning thread
+    mutable std::mutex myMutex;
+
+    std::thread myScanThread;
+    std::atomic<bool> myStopScan;
+
+  private:
+    // Following constructors and assignment operators not supported
+    RomIndex() = delete;
+    RomIndex(const RomIndex&) = delete;
+    RomIndex(RomIndex&&) = delete;
+    RomIndex& operator=(const RomIndex&) = delete;
+    RomIndex& operator=(RomIndex&&) = delete;
+};
+
+#endif
@@ -85,6 +85,12 @@ void Serializer::rewind()
   myStream->seekp(ios_base::beg);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Serializer::size() const
+{
+  return uInt32(myStream->tellp());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt8 Serializer::getByte() const
 {
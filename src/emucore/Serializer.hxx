@@ -61,6 +61,12 @@ class Serializer
     */
     void rewind();
 
+    /**
+      Answers the current write location in the stream.  Directly after
+      writing to a rewound stream, this is the number of bytes written.
+    */
+    uInt32 size() const;
+
     /**
       Reads a byte value (unsigned 8-bit) from the current input stream.
 
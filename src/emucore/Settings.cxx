@@ -132,6 +132,9 @@ Settings::Settings(OSystem& osystem)
   setInternal("threads", "false");
   setExternal("romloadcount", "0");
   setExternal("maxres", "");
+  setExternal("frames", "600");
+  setExternal("jobs", "0");
+  setExternal("wavdir", "");
 
 #ifdef DEBUGGER_SUPPORT
   // Debugger/disassembly options
@@ -143,6 +146,7 @@ Settings::Settings(OSystem& osystem)
   setInternal("dis.gfxformat", "2");
   setInternal("dis.showaddr", "true");
   setInternal("dis.relocate", "false");
+  setExternal("disasmdir", "");
 #endif
 
   // player settings
@@ -250,7 +254,8 @@ string Settings::loadCommandLine(int argc, char** argv)
       // Take care of arguments without an option or ones that shouldn't
       // be saved to the config file
       if(key == "rominfo" || key == "debug" || key == "holdreset" ||
-         key == "holdselect" || key == "takesnapshot")
+         key == "holdselect" || key == "takesnapshot" || key == "headless" ||
+         key == "benchmark" || key == "ntscbenchmark")
       {
         setExternal(key, "true");
         continue;
@@ -496,6 +501,17 @@ void Settings::usage() const
     << endl
     << "  -rominfo      <rom>          Display detailed information for the given ROM\n"
     << "  -listrominfo                 Display contents of stella.pro, one line per ROM entry\n"
+    << "  -headless                    Run ROM (or all ROMs in a directory) without video/audio,\n"
+    << "                                 and display final state, one line per ROM\n"
+    << "  -frames       <number>       Number of frames to emulate in headless mode\n"
+    << "  -jobs         <number>       Number of ROMs to emulate in parallel in headless mode\n"
+    << "                                 (0 means one per CPU core)\n"
+    << "  -wavdir       <path>         In headless mode, write the sound of each ROM to a\n"
+    << "                                 WAV file in this directory\n"
+    << "  -benchmark                   Run ROM (or all ROMs in a directory) for 'frames' frames\n"
+    << "                                 as fast as possible, and display timing information\n"
+    << "  -ntscbenchmark               Render 'frames' frames with each NTSC filter implementation\n"
+    << "                                 supported by the CPU, and verify they produce the same output\n"
     << "  -exitlauncher <1|0>          On exiting a ROM, go back to the ROM launcher\n"
     << "  -launcherres  <WxH>          The resolution to use in ROM launcher mode\n"
     << "  -launcherfont <small|medium| Use the specified font in the ROM launcher\n"
@@ -529,6 +545,8 @@ void Settings::usage() const
     << "   -dis.gfxformat <2|16>       Set base to use for displaying GFX sections in disassembler\n"
     << "   -dis.showaddr  <1|0>        Show opcode addresses in disassembler\n"
     << "   -dis.relocate  <1|0>        Relocate calls out of address range in disassembler\n"
+    << "   -disasmdir     <path>       In headless mode, disassemble all banks of each ROM after\n"
+    << "                                 'frames' frames, and write .asm/.cfg files to this directory\n"
     << endl
     << "   -dbg.res       <WxH>          The resolution to use in debugger mode\n"
     << "   -dbg.fontsize  <small|medium| Font size to use in debugger window\n"
@@ -611,6 +629,15 @@ void Settings::setValue(const string& key, const Variant& value)
     setExternal(key, value);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Settings::copyFrom(const Settings& settings)
+{
+  for(const auto& s: settings.myInternalSettings)
+    setInternal(s.key, s.value);
+  for(const auto& s: settings.myExternalSettings)
+    setExternal(s.key, s.value);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Settings::saveConfig()
 {
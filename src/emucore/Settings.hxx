@@ -74,6 +74,15 @@ class Settings
     */
     void setValue(const string& key, const Variant& value);
 
+    /**
+      Set all values (internal and external) to those in the given
+      settings object.  This is used to give another OSystem the exact
+      same configuration (ie, for headless worker threads).
+
+      @param settings  The settings to copy the values from
+    */
+    void copyFrom(const Settings& settings);
+
     /**
       Convenience methods to return specific types.
 
@@ -15,6 +15,8 @@
 // this file, and for a DISCLAIMER OF ALL WARRANTIES.
 //============================================================================
 
+#include <cmath>
+
 #include "System.hxx"
 #include "TIAConstants.hxx"
 #include "TIASnd.hxx"
@@ -23,9 +25,14 @@
 TIASound::TIASound(Int32 outputFrequency)
   : myChannelMode(Hardware2Stereo),
     myOutputFrequency(outputFrequency),
+    myVolumePercentage(100),
     myOutputCounter(0),
-    myVolumePercentage(100)
+    myClockStep(0),
+    myPlaybackRate(1.0),
+    myHistoryPos(0)
 {
+  filterInit();
+  updateClockStep();
   reset();
 }
 
@@ -53,12 +60,32 @@ void TIASound::reset()
   }
 
   myOutputCounter = 0;
+  memset(myHistory, 0, sizeof(myHistory));
+  myHistoryPos = 0;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASound::outputFrequency(Int32 freq)
 {
   myOutputFrequency = freq;
+  filterInit();
+  updateClockStep();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::playbackRate(double rate)
+{
+  myPlaybackRate = rate;
+  updateClockStep();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::updateClockStep()
+{
+  // Limit the step, so that the output counter can never overflow
+  myClockStep = BSPF::clamp(
+      uInt32(myOutputFrequency * COUNTER_SCALE / myPlaybackRate),
+      1u, uInt32(CLOCK_FREQUENCY * COUNTER_SCALE * 8));
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -159,7 +186,7 @@ void TIASound::volume(uInt32 percent)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TIASound::process(Int16* buffer, uInt32 samples)
+uInt32 TIASound::process(Int16* buffer, uInt32 samples, uInt32& clocks)
 {
   // Make temporary local copy
   uInt8 audc0 = myAUDC[0], audc1 = myAUDC[1];
@@ -171,9 +198,59 @@ void TIASound::process(Int16* buffer, uInt32 samples)
   Int16 audv0 = (myAUDV[0] * myVolumePercentage) / 100,
         audv1 = (myAUDV[1] * myVolumePercentage) / 100;
 
-  // Loop until the sample buffer is full
-  while(samples > 0)
+  const uInt32 threshold = CLOCK_FREQUENCY * COUNTER_SCALE;
+  uInt32 generated = 0;
+
+  // Loop until the sample buffer is full, or all clocks are used
+  for(;;)
   {
+    // Create all output samples which are due before the next clock; when
+    // upsampling, there can be several of them
+    while(generated < samples && myOutputCounter >= threshold)
+    {
+      // Position of the output sample between the last two clocks
+      // (the step may have been reduced since the last clock)
+      const uInt32 phase = std::min(uInt32(FILTER_PHASES - 1),
+          uInt32(uInt64(myOutputCounter - threshold) * FILTER_PHASES / myClockStep));
+      const Int16* filter = myFilter[phase];
+      const Int16* history0 = &myHistory[0][myHistoryPos + 1];
+      const Int16* history1 = &myHistory[1][myHistoryPos + 1];
+
+      Int32 sum0 = 1 << (FILTER_SHIFT - 1), sum1 = sum0;
+      for(uInt32 i = 0; i < FILTER_TAPS; ++i)
+      {
+        sum0 += filter[i] * history0[i];
+        sum1 += filter[i] * history1[i];
+      }
+      sum0 >>= FILTER_SHIFT;
+      sum1 >>= FILTER_SHIFT;
+
+      switch(myChannelMode)
+      {
+        case Hardware2Mono:  // mono sampling with 2 hardware channels
+        {
+          Int16 byte = Int16(BSPF::clamp(sum0 + sum1, -32768, 32767));
+          *(buffer++) = byte;
+          *(buffer++) = byte;
+          break;
+        }
+
+        case Hardware2Stereo:  // stereo sampling with 2 hardware channels
+          *(buffer++) = Int16(BSPF::clamp(sum0, -32768, 32767));
+          *(buffer++) = Int16(BSPF::clamp(sum1, -32768, 32767));
+          break;
+
+        case Hardware1:  // mono/stereo sampling with only 1 hardware channel
+          *(buffer++) = Int16(BSPF::clamp(sum0 + sum1, -32768, 32767));
+          break;
+      }
+      myOutputCounter -= threshold;
+      ++generated;
+    }
+    if(generated == samples || clocks == 0)
+      break;
+    --clocks;
+
     // Process channel 0
     if (div_n_cnt0 > 1)
     {
@@ -321,40 +398,12 @@ void TIASound::process(Int16* buffer, uInt32 samples)
       }
     }
 
-    myOutputCounter += myOutputFrequency;
+    // Remember the new output levels for the resampling filter
+    myHistoryPos = (myHistoryPos + 1) % FILTER_TAPS;
+    myHistory[0][myHistoryPos] = myHistory[0][myHistoryPos + FILTER_TAPS] = v0;
+    myHistory[1][myHistoryPos] = myHistory[1][myHistoryPos + FILTER_TAPS] = v1;
 
-    switch(myChannelMode)
-    {
-      case Hardware2Mono:  // mono sampling with 2 hardware channels
-        while((samples > 0) && (myOutputCounter >= 31400))
-        {
-          Int16 byte = v0 + v1;
-          *(buffer++) = byte;
-          *(buffer++) = byte;
-          myOutputCounter -= 31400;
-          samples--;
-        }
-        break;
-
-      case Hardware2Stereo:  // stereo sampling with 2 hardware channels
-        while((samples > 0) && (myOutputCounter >= 31400))
-        {
-          *(buffer++) = v0;
-          *(buffer++) = v1;
-          myOutputCounter -= 31400;
-          samples--;
-        }
-        break;
-
-      case Hardware1:  // mono/stereo sampling with only 1 hardware channel
-        while((samples > 0) && (myOutputCounter >= 31400))
-        {
-          *(buffer++) = v0 + v1;
-          myOutputCounter -= 31400;
-          samples--;
-        }
-        break;
-    }
+    myOutputCounter += myClockStep;
   }
 
   // Save for next round
@@ -364,6 +413,8 @@ void TIASound::process(Int16* buffer, uInt32 samples)
   myVolume[1] = v1;
   myDivNCnt[0] = div_n_cnt0;
   myDivNCnt[1] = div_n_cnt1;
+
+  return generated;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -381,6 +432,47 @@ void TIASound::polyInit(uInt8* poly, int size, int f0, int f1)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASound::filterInit()
+{
+  // Below the output Nyquist frequency when downsampling, and slightly
+  // below the TIA's own when upsampling, to leave room for the transition
+  const double cutoff = 0.9 * std::min(1.0, double(myOutputFrequency) / CLOCK_FREQUENCY);
+  const double halfWidth = FILTER_TAPS / 2;
+  const double pi = 3.14159265358979323846;
+
+  for(uInt32 phase = 0; phase < FILTER_PHASES; ++phase)
+  {
+    double coeff[FILTER_TAPS], sum = 0.0;
+
+    for(uInt32 i = 0; i < FILTER_TAPS; ++i)
+    {
+      // Distance (in clocks) of the history entry from the output sample,
+      // which is delayed by half the filter width
+      const double x = (FILTER_TAPS - 1 - i) - double(phase) / FILTER_PHASES - halfWidth;
+      const double sinc = x == 0.0 ? 1.0 : std::sin(pi * cutoff * x) / (pi * cutoff * x);
+      const double window = std::abs(x) >= halfWidth ? 0.0 :
+          0.42 + 0.5 * std::cos(pi * x / halfWidth) + 0.08 * std::cos(2 * pi * x / halfWidth);
+
+      coeff[i] = sinc * window;
+      sum += coeff[i];
+    }
+
+    // Normalize, so that a constant level is reproduced exactly; rounding
+    // errors are added to the largest coefficient
+    Int32 total = 0;
+    uInt32 largest = 0;
+    for(uInt32 i = 0; i < FILTER_TAPS; ++i)
+    {
+      myFilter[phase][i] = Int16(std::lround(coeff[i] / sum * (1 << FILTER_SHIFT)));
+      total += myFilter[phase][i];
+      if(myFilter[phase][i] > myFilter[phase][largest])
+        largest = i;
+    }
+    myFilter[phase][largest] += Int16((1 << FILTER_SHIFT) - total);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const uInt8 TIASound::Div31[POLY5_SIZE] = {
   0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
@@ -24,8 +24,12 @@
   This class implements a fairly accurate emulation of the TIA sound
   hardware.  This class uses code/ideas from z26 and MESS.
 
-  Currently, the sound generation routines work at 31400Hz only.
-  Resampling can be done by passing in a different output frequency.
+  The sound generation routines work at the native TIA audio clock of
+  (about) 31400Hz.  The generated signal is then resampled to the output
+  frequency using a band-limited (windowed sinc) polyphase filter.  Since
+  the emulation is advanced by a given number of audio clocks, and the
+  resampler state is kept between calls, the output doesn't depend on how
+  it is split into fragments.
 
   @author  Bradford W. Mott, Stephen Anthony, z26 and MESS teams
 */
@@ -48,6 +52,16 @@ class TIASound
     */
     void outputFrequency(Int32 freq);
 
+    /**
+      Slightly speed up (rate > 1) or slow down (rate < 1) the playback,
+      without changing the filter.  This is used to keep the output in
+      sync with the emulation, without dropping any register writes.
+
+      @param rate  The factor to apply to the number of audio clocks used
+                   per output sample
+    */
+    void playbackRate(double rate);
+
     /**
       Selects the number of audio channels per sample.  There are two factors
       to consider: hardware capability and desired mixing.
@@ -77,23 +91,47 @@ class TIASound
     uInt8 get(uInt16 address) const;
 
     /**
-      Create sound samples based on the current sound register settings
-      in the specified buffer. NOTE: If channels is set to stereo then
-      the buffer will need to be twice as long as the number of samples.
-
-      @param buffer The location to store generated samples
-      @param samples The number of samples to generate
+      Run the sound emulation for the given number of audio clocks, based
+      on the current sound register settings, and store the resampled
+      output in the specified buffer.  This stops when either all clocks
+      have been used, or the buffer is full.  NOTE: If channels is set to
+      stereo then the buffer will need to be twice as long as the number
+      of samples.
+
+      @param buffer   The location to store generated samples
+      @param samples  The maximum number of samples to generate
+      @param clocks   The number of audio clocks to run; on return, this
+                      contains the number of clocks which weren't used
+
+      @return  The number of samples generated
     */
-    void process(Int16* buffer, uInt32 samples);
+    uInt32 process(Int16* buffer, uInt32 samples, uInt32& clocks);
 
     /**
       Set the volume of the samples created (0-100)
     */
     void volume(uInt32 percent);
 
+  public:
+    // The frequency of the TIA audio clock (two clocks per scanline)
+    static constexpr Int32 CLOCK_FREQUENCY = 31400;
+
+    // The number of CPU cycles per audio clock
+    static constexpr uInt32 CYCLES_PER_CLOCK = 38;
+
   private:
     void polyInit(uInt8* poly, int size, int f0, int f1);
 
+    /**
+      Calculate the resampling filter for the current output frequency.
+    */
+    void filterInit();
+
+    /**
+      Calculate the number of output counter units added per audio clock.
+    */
+    void updateClockStep();
+
   private:
     // Definitions for AUDCx (15, 16)
     enum AUDCxRegister
@@ -121,8 +159,12 @@ class TIASound
       POLY5_SIZE = 0x001f,
       POLY9_SIZE = 0x01ff,
       DIV3_MASK  = 0x0c,
-      AUDV_SHIFT = 10     // shift 2 positions for AUDV,
+      AUDV_SHIFT = 10,    // shift 2 positions for AUDV,
                           // then another 8 for 16-bit sound
+      FILTER_TAPS   = 16, // audio clocks used for each output sample
+      FILTER_PHASES = 64, // resolution of output sample positions
+      FILTER_SHIFT  = 15, // fixed point precision of filter coefficients
+      COUNTER_SCALE = 1024
     };
 
     enum ChannelMode {
@@ -149,9 +191,24 @@ class TIASound
 
     ChannelMode myChannelMode;
     Int32  myOutputFrequency;
-    Int32  myOutputCounter;
     uInt32 myVolumePercentage;
 
+    // An output sample is due whenever the counter reaches
+    // CLOCK_FREQUENCY * COUNTER_SCALE; each audio clock adds the
+    // output frequency (adjusted by the playback rate)
+    uInt32 myOutputCounter;
+    uInt32 myClockStep;
+    double myPlaybackRate;
+
+    // The most recent output levels of each channel, stored twice, so
+    // that the last FILTER_TAPS values are always available in order
+    Int16 myHistory[2][FILTER_TAPS * 2];
+    uInt32 myHistoryPos;
+
+    // Filter coefficients for each possible output sample position
+    // between two audio clocks
+    Int16 myFilter[FILTER_PHASES][FILTER_TAPS];
+
     /*
       Initialize the bit patterns for the polynomials (at runtime).
 
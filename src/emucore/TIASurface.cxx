@@ -17,6 +17,16 @@
 
 #include <cmath>
 
+// The NEON version hasn't been verified on ARM hardware yet, so it must
+// be enabled explicitly (configure --enable-neon-phosphor)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+  #define TIASURFACE_SSE2
+  #include <emmintrin.h>
+#elif defined(NEON_PHOSPHOR) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+  #define TIASURFACE_NEON
+  #include <arm_neon.h>
+#endif
+
 #include "FrameBuffer.hxx"
 #include "FBSurface.hxx"
 #include "Settings.hxx"
@@ -24,6 +34,7 @@
 #include "Console.hxx"
 #include "TIA.hxx"
 #include "TIASurface.hxx"
+#include "BenchmarkTimer.hxx"
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TIASurface::TIASurface(OSystem& system)
@@ -33,8 +44,10 @@ TIASurface::TIASurface(OSystem& system)
     myFilter(Filter::Normal),
     myUsePhosphor(false),
     myPhosphorPercent(0.60f),
+    myPhosphorMultiplier(-1),
     myScanlinesEnabled(false),
-    myPalette(nullptr)
+    myPalette(nullptr),
+    myLastFrameValid(false)
 {
   // Load NTSC filter settings
   myNTSCFilter.loadConfig(myOSystem.settings());
@@ -101,6 +114,7 @@ cerr << "SLine:\n"
 void TIASurface::setPalette(const uInt32* tia_palette, const uInt32* rgb_palette)
 {
   myPalette = tia_palette;
+  myLastFrameValid = false;
 
   // The NTSC filtering needs access to the raw RGB data, since it calculates
   // its own internal palette
@@ -226,6 +240,7 @@ void TIASurface::enablePhosphor(bool enable, int blend)
   if(blend >= 0)
     myPhosphorPercent = blend / 100.0;
   myFilter = Filter(enable ? uInt8(myFilter) | 0x01 : uInt8(myFilter) & 0x10);
+  myLastFrameValid = false;
 
   myTiaSurface->setDirty();
   mySLineSurface->setDirty();
@@ -239,6 +254,20 @@ void TIASurface::enablePhosphor(bool enable, int blend)
         myPhosphorPalette[c][p] = getPhosphor(c, p);
 
     myNTSCFilter.setPhosphorPalette(myPhosphorPalette);
+
+    // Look for an integer multiplier giving the same decayed values as the
+    // (floating point) palette above, so the decay can be done in SIMD
+    const Int32 estimate = Int32(myPhosphorPercent * 65536);
+    myPhosphorMultiplier = -1;
+    for(Int32 m = std::max(estimate - 256, 0);
+        m <= std::min(estimate + 256, 0xFFFF) && myPhosphorMultiplier < 0; ++m)
+    {
+      uInt32 p = 0;
+      while(p < 256 && ((p * m) >> 16) == myPhosphorPalette[0][p])
+        ++p;
+      if(p == 256)
+        myPhosphorMultiplier = m;
+    }
   }
 }
 
@@ -259,10 +288,78 @@ inline uInt32 TIASurface::getRGBPhosphor(const uInt32 c, const uInt32 p) const
   return (rn << 16) | (gn << 8) | bn;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIASurface::renderPhosphorLine(const uInt8* tiaIn, uInt32* rgbIn,
+                                    uInt32* out, uInt32 width) const
+{
+  uInt32 x = 0;
+
+#if defined(TIASURFACE_SSE2)
+  if(myPhosphorMultiplier >= 0)
+  {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i multiplier = _mm_set1_epi16(Int16(myPhosphorMultiplier));
+    const __m128i rgbMask = _mm_set1_epi32(0x00FFFFFF);
+
+    for(; x + 4 <= width; x += 4)
+    {
+      const __m128i c = _mm_set_epi32(
+        myPalette[tiaIn[x+3]], myPalette[tiaIn[x+2]],
+        myPalette[tiaIn[x+1]], myPalette[tiaIn[x]]);
+      const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgbIn + x));
+
+      // Decay previous frame, and use maximum of current and decayed value
+      const __m128i lo = _mm_mulhi_epu16(_mm_unpacklo_epi8(p, zero), multiplier);
+      const __m128i hi = _mm_mulhi_epu16(_mm_unpackhi_epi8(p, zero), multiplier);
+      const __m128i n = _mm_and_si128(
+        _mm_max_epu8(c, _mm_packus_epi16(lo, hi)), rgbMask);
+
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(rgbIn + x), n);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), n);
+    }
+  }
+#elif defined(TIASURFACE_NEON)
+  if(myPhosphorMultiplier >= 0)
+  {
+    const uint16x4_t multiplier = vdup_n_u16(uInt16(myPhosphorMultiplier));
+    const uint32x4_t rgbMask = vdupq_n_u32(0x00FFFFFF);
+
+    for(; x + 4 <= width; x += 4)
+    {
+      const uInt32 pixels[4] = {
+        myPalette[tiaIn[x]],   myPalette[tiaIn[x+1]],
+        myPalette[tiaIn[x+2]], myPalette[tiaIn[x+3]]
+      };
+      const uint8x16_t c = vreinterpretq_u8_u32(vld1q_u32(pixels));
+      const uint8x16_t p = vreinterpretq_u8_u32(vld1q_u32(rgbIn + x));
+
+      // Decay previous frame, and use maximum of current and decayed value
+      const uint16x8_t lo = vmovl_u8(vget_low_u8(p));
+      const uint16x8_t hi = vmovl_u8(vget_high_u8(p));
+      const uint16x4_t d0 = vshrn_n_u32(vmull_u16(vget_low_u16(lo), multiplier), 16);
+      const uint16x4_t d1 = vshrn_n_u32(vmull_u16(vget_high_u16(lo), multiplier), 16);
+      const uint16x4_t d2 = vshrn_n_u32(vmull_u16(vget_low_u16(hi), multiplier), 16);
+      const uint16x4_t d3 = vshrn_n_u32(vmull_u16(vget_high_u16(hi), multiplier), 16);
+      const uint8x16_t d = vcombine_u8(vmovn_u16(vcombine_u16(d0, d1)),
+                                       vmovn_u16(vcombine_u16(d2, d3)));
+      const uint32x4_t n = vandq_u32(vreinterpretq_u32_u8(vmaxq_u8(c, d)), rgbMask);
+
+      vst1q_u32(rgbIn + x, n);
+      vst1q_u32(out + x, n);
+    }
+  }
+#endif
+
+  // Store back into displayed frame buffer (for next frame)
+  for(; x < width; ++x)
+    rgbIn[x] = out[x] = getRGBPhosphor(myPalette[tiaIn[x]], rgbIn[x]);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::enableNTSC(bool enable)
 {
   myFilter = Filter(enable ? uInt8(myFilter) | 0x10 : uInt8(myFilter) & 0x01);
+  myLastFrameValid = false;
 
   // Normal vs NTSC mode uses different source widths
   myTiaSurface->setSrcSize(enable ?
@@ -313,12 +410,21 @@ string TIASurface::effectsInfo() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIASurface::render()
 {
+  BenchmarkTimer::Scope timer(BenchmarkTimer::Render);
+
   uInt32 width  = myTIA->width();
   uInt32 height = myTIA->height();
 
   uInt32 *out, outPitch;
   myTiaSurface->basePtr(out, outPitch);
 
+  // Range of rows which were modified; only normal mode tracks them, all
+  // other modes modify every row
+  const bool trackRows = myFilter == Filter::Normal;
+  uInt32 dirtyTop = trackRows ? height : 0, dirtyBottom = trackRows ? 0 : height;
+  if(!trackRows)
+    myLastFrameValid = false;
+
   switch(myFilter)
   {
     case Filter::Normal:
@@ -328,14 +434,26 @@ void TIASurface::render()
       uInt32 bufofs = 0, screenofsY = 0, pos;
       for(uInt32 y = 0; y < height; ++y)
       {
-        pos = screenofsY;
-        for (uInt32 x = width / 2; x; --x)
+        // Skip rows which are unchanged since the last conversion
+        if(!myLastFrameValid || memcmp(myLastFrame + bufofs, tiaIn + bufofs, width))
         {
-          out[pos++] = myPalette[tiaIn[bufofs++]];
-          out[pos++] = myPalette[tiaIn[bufofs++]];
+          memcpy(myLastFrame + bufofs, tiaIn + bufofs, width);
+          dirtyTop = std::min(dirtyTop, y);
+          dirtyBottom = y + 1;
+
+          pos = screenofsY;
+          for (uInt32 x = width / 2; x; --x)
+          {
+            out[pos++] = myPalette[tiaIn[bufofs++]];
+            out[pos++] = myPalette[tiaIn[bufofs++]];
+          }
         }
+        else
+          bufofs += width;
+
         screenofsY += outPitch;
       }
+      myLastFrameValid = true;
       break;
     }
 
@@ -344,18 +462,11 @@ void TIASurface::render()
       uInt8*  tiaIn = myTIA->frameBuffer();
       uInt32* rgbIn = myRGBFramebuffer;
 
-      uInt32 bufofs = 0, screenofsY = 0, pos;
+      uInt32 bufofs = 0, screenofsY = 0;
       for(uInt32 y = height; y ; --y)
       {
-        pos = screenofsY;
-        for(uInt32 x = width / 2; x ; --x)
-        {
-          // Store back into displayed frame buffer (for next frame)
-          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          bufofs++;
-          rgbIn[bufofs] = out[pos++] = getRGBPhosphor(myPalette[tiaIn[bufofs]], rgbIn[bufofs]);
-          bufofs++;
-        }
+        renderPhosphorLine(tiaIn + bufofs, rgbIn + bufofs, out + screenofsY, width);
+        bufofs += width;
         screenofsY += outPitch;
       }
       break;
@@ -375,7 +486,7 @@ void TIASurface::render()
   }
 
   // Draw TIA image
-  myTiaSurface->setDirty();
+  myTiaSurface->setDirtyRows(dirtyTop, dirtyBottom > dirtyTop ? dirtyBottom - dirtyTop : 0);
   myTiaSurface->render();
 
   // Draw overlaying scanlines
@@ -139,6 +139,19 @@ class TIASurface
     */
     uInt32 getRGBPhosphor(const uInt32 c, const uInt32 cp) const;
 
+    /**
+      Render one line in phosphor mode, blending the current frame with
+      the previous one (which is updated in place). Uses SIMD instructions
+      where available.
+
+      @param tiaIn  The TIA pixels of the line
+      @param rgbIn  The RGB pixels of the previous frame
+      @param out    The RGB pixels to display
+      @param width  The number of pixels in the line
+    */
+    void renderPhosphorLine(const uInt8* tiaIn, uInt32* rgbIn, uInt32* out,
+                            uInt32 width) const;
+
     /**
       Enable/disable/query NTSC filtering effects.
     */
@@ -195,6 +208,11 @@ class TIASurface
 
     // Precalculated averaged phosphor colors
     uInt8 myPhosphorPalette[256][256];
+
+    // Fixed point (16 bit fraction) multiplier reproducing the decay of the
+    // precalculated phosphor colors exactly, or -1 if there is none (in which
+    // case the SIMD code path isn't used)
+    Int32 myPhosphorMultiplier;
     /////////////////////////////////////////////////////////////
 
     // Use scanlines in TIA rendering mode
@@ -203,6 +221,12 @@ class TIASurface
     // Palette for normal TIA rendering mode
     const uInt32* myPalette;
 
+    // Copy of the TIA frame last converted in normal TIA rendering mode;
+    // rows that haven't changed since then are neither converted nor
+    // uploaded again
+    uInt8 myLastFrame[kTIAW * kTIAH];
+    bool myLastFrameValid;
+
   private:
     // Following constructors and assignment operators not supported
     TIASurface() = delete;
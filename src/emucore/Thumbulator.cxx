@@ -26,6 +26,7 @@
 #include "Base.hxx"
 #include "Cart.hxx"
 #include "Thumbulator.hxx"
+#include "BenchmarkTimer.hxx"
 using Common::Base;
 
 // Uncomment the following to enable specific functionality
@@ -57,23 +58,39 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, bool traponfata
                          Thumbulator::ConfigureFor configurefor, Cartridge* cartridge)
   : rom(rom_ptr),
     ram(ram_ptr),
+    profileRuns(0),
     T1TCR(0),
     T1TC(0),
+    trapOnFatal(traponfatal),
     configuration(configurefor),
     myCartridge(cartridge)
 {
   setConsoleTiming(ConsoleTiming::ntsc);
-  trapFatalErrors(traponfatal);
+  invalidateROMCache();
+  mapMemory();
   reset();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 string Thumbulator::run()
 {
+  BenchmarkTimer::Scope timer(BenchmarkTimer::ARM);
+
+  // The cartridge may have modified RAM since the last call
+  std::fill(decodedRam, decodedRam + RAMSIZE/2, Op::undecoded);
+
   reset();
+  if(profile)
+  {
+    // The entry point is called once for every run
+    ProfileEntry* entry = profileEntry(read_register(15) - 2);
+    if(entry) entry->calls++;
+    profileRuns++;
+  }
+
   for(;;)
   {
-    if(execute()) break;
+    if(profile ? executeProfiled() : execute()) break;
     if(instructions > 500000) // way more than would otherwise be possible
       throw runtime_error("instructions > 500000");
   }
@@ -100,6 +117,46 @@ void Thumbulator::setConsoleTiming(ConsoleTiming timing)
     case ConsoleTiming::pal:    timing_factor = PAL;    break;
   }
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::invalidateROMCache()
+{
+  for(uInt32 i = 0; i < ROMSIZE/2; ++i)
+  {
+    uInt32 inst = CONV_RAMROM(rom[i]);
+    decodedRom[i] = decodeInstructionWord(inst);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::mapMemory()
+{
+  // Debug output is generated by the slow path only, so nothing is mapped
+#if !defined(THUMB_DBUG)
+  for(uInt32 page = 0; page < ROMSIZE >> PAGE_SHIFT; ++page)
+    pageAccess[page].directReadBase = rom + ((page << PAGE_SHIFT) >> 1);
+
+  const uInt32 ramPage = pageIndex(0x40000000);
+  for(uInt32 page = 0; page < RAMSIZE >> PAGE_SHIFT; ++page)
+  {
+    PageAccess& access = pageAccess[ramPage + page];
+    access.directReadBase = access.directWriteBase =
+      ram + ((page << PAGE_SHIFT) >> 1);
+
+    // Any write to a page containing part of the driver must be checked
+    const uInt32 start = 0x40000000 + (page << PAGE_SHIFT);
+    for(uInt32 addr = start; addr <= start + PAGE_MASK; addr += 2)
+    {
+      if(isProtected(addr))
+      {
+        access.directWriteBase = nullptr;
+        break;
+      }
+    }
+  }
+#endif
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Thumbulator::updateTimer(uInt32 cycles)
 {
@@ -221,6 +278,19 @@ uInt32 Thumbulator::fetch32(uInt32 addr)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Thumbulator::write16(uInt32 addr, uInt32 data)
 {
+  // Unprotected RAM is written directly; everything else is checked below
+  if((addr & (UNPAGED_BITS | 1)) == 0)
+  {
+    uInt16* base = pageAccess[pageIndex(addr)].directWriteBase;
+    if(base)
+    {
+      writes++;
+      base[(addr & PAGE_MASK) >> 1] = CONV_DATA(data);
+      decodedRam[(addr & RAMADDMASK) >> 1] = Op::undecoded;
+      return;
+    }
+  }
+
   if((addr > 0x40001fff) && (addr < 0x50000000))
     fatalError("write16", addr, "abort - out of range");
 
@@ -239,6 +309,7 @@ void Thumbulator::write16(uInt32 addr, uInt32 data)
       addr &= RAMADDMASK;
       addr >>= 1;
       ram[addr] = CONV_DATA(data);
+      decodedRam[addr] = Op::undecoded;
       return;
 
     case 0xE0000000: //MAMCR
@@ -255,6 +326,23 @@ void Thumbulator::write16(uInt32 addr, uInt32 data)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Thumbulator::write32(uInt32 addr, uInt32 data)
 {
+  // Unprotected RAM is written directly; everything else is checked below
+  if((addr & (UNPAGED_BITS | 3)) == 0)
+  {
+    uInt16* base = pageAccess[pageIndex(addr)].directWriteBase;
+    if(base)
+    {
+      writes += 2;
+      base += (addr & PAGE_MASK) >> 1;
+      base[0] = CONV_DATA(data);
+      data >>= 16;
+      base[1] = CONV_DATA(data);
+      addr = (addr & RAMADDMASK) >> 1;
+      decodedRam[addr] = decodedRam[addr+1] = Op::undecoded;
+      return;
+    }
+  }
+
   if(addr & 3)
     fatalError("write32", addr, "abort - misaligned");
 
@@ -362,6 +450,18 @@ uInt32 Thumbulator::read16(uInt32 addr)
 {
   uInt32 data;
 
+  // ROM and RAM are read directly; everything else is checked below
+  if((addr & (UNPAGED_BITS | 1)) == 0)
+  {
+    const uInt16* base = pageAccess[pageIndex(addr)].directReadBase;
+    if(base)
+    {
+      reads++;
+      data = base[(addr & PAGE_MASK) >> 1];
+      return CONV_RAMROM(data);
+    }
+  }
+
   if((addr > 0x40001fff) && (addr < 0x50000000))
     fatalError("read16", addr, "abort - out of range");
   else if((addr > 0x7fff) && (addr < 0x10000000))
@@ -400,10 +500,27 @@ uInt32 Thumbulator::read16(uInt32 addr)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 uInt32 Thumbulator::read32(uInt32 addr)
 {
+  uInt32 data;
+
+  // ROM and RAM are read directly; everything else is checked below
+  if((addr & (UNPAGED_BITS | 3)) == 0)
+  {
+    const uInt16* base = pageAccess[pageIndex(addr)].directReadBase;
+    if(base)
+    {
+      reads += 2;
+      base += (addr & PAGE_MASK) >> 1;
+      data = base[1];
+      data = CONV_RAMROM(data);
+      uInt32 low = base[0];
+      low = CONV_RAMROM(low);
+      return low | (data << 16);
+    }
+  }
+
   if(addr & 3)
     fatalError("read32", addr, "abort - misaligned");
 
-  uInt32 data;
   switch(addr & 0xF0000000)
   {
     case 0x00000000: //ROM
@@ -526,6 +643,88 @@ void Thumbulator::do_vflag_bit(uInt32 x)
   if(x) cpsr |= CPSR_V;  else cpsr &= ~CPSR_V;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Thumbulator::Op Thumbulator::decodeInstructionWord(uInt32 inst)
+{
+  // The order of the tests matters, since some encodings overlap
+  // (ie, CPY is a subset of MOV(3), and ADD(1) with a zero immediate is MOV(2))
+  if((inst & 0xFFC0) == 0x4140) return Op::adc;
+  if((inst & 0xFE00) == 0x1C00 && (inst & 0x01C0)) return Op::add1;
+  if((inst & 0xF800) == 0x3000) return Op::add2;
+  if((inst & 0xFE00) == 0x1800) return Op::add3;
+  if((inst & 0xFF00) == 0x4400) return Op::add4;
+  if((inst & 0xF800) == 0xA000) return Op::add5;
+  if((inst & 0xF800) == 0xA800) return Op::add6;
+  if((inst & 0xFF80) == 0xB000) return Op::add7;
+  if((inst & 0xFFC0) == 0x4000) return Op::and_;
+  if((inst & 0xF800) == 0x1000) return Op::asr1;
+  if((inst & 0xFFC0) == 0x4100) return Op::asr2;
+  if((inst & 0xF000) == 0xD000 && (inst & 0x0F00) < 0x0E00) return Op::b1;
+  if((inst & 0xF800) == 0xE000) return Op::b2;
+  if((inst & 0xFFC0) == 0x4380) return Op::bic;
+  if((inst & 0xFF00) == 0xBE00) return Op::bkpt;
+  if((inst & 0xE000) == 0xE000) return Op::bl;
+  if((inst & 0xFF87) == 0x4780) return Op::blx2;
+  if((inst & 0xFF87) == 0x4700) return Op::bx;
+  if((inst & 0xFFC0) == 0x42C0) return Op::cmn;
+  if((inst & 0xF800) == 0x2800) return Op::cmp1;
+  if((inst & 0xFFC0) == 0x4280) return Op::cmp2;
+  if((inst & 0xFF00) == 0x4500) return Op::cmp3;
+  if((inst & 0xFFE8) == 0xB660) return Op::cps;
+  if((inst & 0xFFC0) == 0x4600) return Op::cpy;
+  if((inst & 0xFFC0) == 0x4040) return Op::eor;
+  if((inst & 0xF800) == 0xC800) return Op::ldmia;
+  if((inst & 0xF800) == 0x6800) return Op::ldr1;
+  if((inst & 0xFE00) == 0x5800) return Op::ldr2;
+  if((inst & 0xF800) == 0x4800) return Op::ldr3;
+  if((inst & 0xF800) == 0x9800) return Op::ldr4;
+  if((inst & 0xF800) == 0x7800) return Op::ldrb1;
+  if((inst & 0xFE00) == 0x5C00) return Op::ldrb2;
+  if((inst & 0xF800) == 0x8800) return Op::ldrh1;
+  if((inst & 0xFE00) == 0x5A00) return Op::ldrh2;
+  if((inst & 0xFE00) == 0x5600) return Op::ldrsb;
+  if((inst & 0xFE00) == 0x5E00) return Op::ldrsh;
+  if((inst & 0xF800) == 0x0000) return Op::lsl1;
+  if((inst & 0xFFC0) == 0x4080) return Op::lsl2;
+  if((inst & 0xF800) == 0x0800) return Op::lsr1;
+  if((inst & 0xFFC0) == 0x40C0) return Op::lsr2;
+  if((inst & 0xF800) == 0x2000) return Op::mov1;
+  if((inst & 0xFFC0) == 0x1C00) return Op::mov2;
+  if((inst & 0xFF00) == 0x4600) return Op::mov3;
+  if((inst & 0xFFC0) == 0x4340) return Op::mul;
+  if((inst & 0xFFC0) == 0x43C0) return Op::mvn;
+  if((inst & 0xFFC0) == 0x4240) return Op::neg;
+  if((inst & 0xFFC0) == 0x4300) return Op::orr;
+  if((inst & 0xFE00) == 0xBC00) return Op::pop;
+  if((inst & 0xFE00) == 0xB400) return Op::push;
+  if((inst & 0xFFC0) == 0xBA00) return Op::rev;
+  if((inst & 0xFFC0) == 0xBA40) return Op::rev16;
+  if((inst & 0xFFC0) == 0xBAC0) return Op::revsh;
+  if((inst & 0xFFC0) == 0x41C0) return Op::ror;
+  if((inst & 0xFFC0) == 0x4180) return Op::sbc;
+  if((inst & 0xFFF7) == 0xB650) return Op::setend;
+  if((inst & 0xF800) == 0xC000) return Op::stmia;
+  if((inst & 0xF800) == 0x6000) return Op::str1;
+  if((inst & 0xFE00) == 0x5000) return Op::str2;
+  if((inst & 0xF800) == 0x9000) return Op::str3;
+  if((inst & 0xF800) == 0x7000) return Op::strb1;
+  if((inst & 0xFE00) == 0x5400) return Op::strb2;
+  if((inst & 0xF800) == 0x8000) return Op::strh1;
+  if((inst & 0xFE00) == 0x5200) return Op::strh2;
+  if((inst & 0xFE00) == 0x1E00) return Op::sub1;
+  if((inst & 0xF800) == 0x3800) return Op::sub2;
+  if((inst & 0xFE00) == 0x1A00) return Op::sub3;
+  if((inst & 0xFF80) == 0xB080) return Op::sub4;
+  if((inst & 0xFF00) == 0xDF00) return Op::swi;
+  if((inst & 0xFFC0) == 0xB240) return Op::sxtb;
+  if((inst & 0xFFC0) == 0xB200) return Op::sxth;
+  if((inst & 0xFFC0) == 0x4200) return Op::tst;
+  if((inst & 0xFFC0) == 0xB2C0) return Op::uxtb;
+  if((inst & 0xFFC0) == 0xB280) return Op::uxth;
+
+  return Op::invalid;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Thumbulator::execute()
 {
@@ -592,40 +791,64 @@ int Thumbulator::execute()
   }
 #endif
 
-  inst = fetch16(pc-2);
+  // Instructions are decoded only once; code in ROM can never change while
+  // the ARM is running, so it takes the fast path that bypasses fetch16()
+  Op decoded;
+  uInt32 addr = pc - 2;
+  if((addr & 0xF0000000) == 0x00000000 && (addr & ROMADDMASK) >= 0x50)
+  {
+    addr = (addr & ROMADDMASK) >> 1;
+    fetches++;
+    inst = CONV_RAMROM(rom[addr]);
+    decoded = decodedRom[addr];
+    DO_DBUG(statusMsg << "fetch16(" << Base::HEX8 << addr << ")=" << Base::HEX4 << inst << endl);
+  }
+  else if((addr & 0xF0000000) == 0x40000000)
+  {
+    inst = fetch16(addr);
+    addr = (addr & RAMADDMASK) >> 1;
+    decoded = decodedRam[addr];
+    if(decoded == Op::undecoded)
+      decoded = decodedRam[addr] = decodeInstructionWord(inst);
+  }
+  else
+  {
+    inst = fetch16(addr);
+    decoded = decodeInstructionWord(inst);
+  }
   pc += 2;
   write_register(15, pc);
   DO_DISS(statusMsg << Base::HEX8 << (pc-5) << ": " << Base::HEX4 << inst << " ");
 
   instructions++;
 
-  //ADC
-  if((inst & 0xFFC0) == 0x4140)
+  switch(decoded)
   {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "adc r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra + rb;
-    if(cpsr & CPSR_C)
-      rc++;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    if(cpsr & CPSR_C) { do_cflag(ra, rb, 1); do_vflag(ra, rb, 1); }
-    else              { do_cflag(ra, rb, 0); do_vflag(ra, rb, 0); }
-    return 0;
-  }
+    //ADC
+    case Op::adc:
+    {
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "adc r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra + rb;
+      if(cpsr & CPSR_C)
+        rc++;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      if(cpsr & CPSR_C) { do_cflag(ra, rb, 1); do_vflag(ra, rb, 1); }
+      else              { do_cflag(ra, rb, 0); do_vflag(ra, rb, 0); }
+      return 0;
+    }
 
-  //ADD(1) small immediate two registers
-  if((inst & 0xFE00) == 0x1C00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rb = (inst >> 6) & 0x7;
-    if(rb)
+    //ADD(1) small immediate two registers
+    case Op::add1:
     {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rb = (inst >> 6) & 0x7;   // zero immediate is decoded as MOV(2)
       DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ","
                         << "#0x" << Base::HEX2 << rb << endl);
       ra = read_register(rn);
@@ -638,1684 +861,1832 @@ int Thumbulator::execute()
       do_vflag(ra, rb, 0);
       return 0;
     }
-    else
+
+    //ADD(2) big immediate one register
+    case Op::add2:
     {
-      //this is a mov
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x7;
+      DO_DISS(statusMsg << "adds r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rd);
+      rc = ra + rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, rb, 0);
+      do_vflag(ra, rb, 0);
+      return 0;
     }
-  }
-
-  //ADD(2) big immediate one register
-  if((inst & 0xF800) == 0x3000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x7;
-    DO_DISS(statusMsg << "adds r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rd);
-    rc = ra + rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, rb, 0);
-    do_vflag(ra, rb, 0);
-    return 0;
-  }
-
-  //ADD(3) three registers
-  if((inst & 0xFE00) == 0x1800)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ",r" << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra + rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, rb, 0);
-    do_vflag(ra, rb, 0);
-    return 0;
-  }
 
-  //ADD(4) two registers one or both high no flags
-  if((inst & 0xFF00) == 0x4400)
-  {
-    if((inst >> 6) & 3)
+    //ADD(3) three registers
+    case Op::add3:
     {
-      //UNPREDICTABLE
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "adds r" << dec << rd << ",r" << dec << rn << ",r" << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra + rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, rb, 0);
+      do_vflag(ra, rb, 0);
+      return 0;
     }
-    rd  = (inst >> 0) & 0x7;
-    rd |= (inst >> 4) & 0x8;
-    rm  = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "add r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra + rb;
-    if(rd == 15)
+
+    //ADD(4) two registers one or both high no flags
+    case Op::add4:
     {
-      if((rc & 1) == 0)
-        fatalError("add pc", pc, rc, " produced an arm address");
+      if((inst >> 6) & 3)
+      {
+        //UNPREDICTABLE
+      }
+      rd  = (inst >> 0) & 0x7;
+      rd |= (inst >> 4) & 0x8;
+      rm  = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "add r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra + rb;
+      if(rd == 15)
+      {
+        if((rc & 1) == 0)
+          fatalError("add pc", pc, rc, " produced an arm address");
 
-      rc &= ~1; //write_register may do this as well
-      rc += 2;  //The program counter is special
+        rc &= ~1; //write_register may do this as well
+        rc += 2;  //The program counter is special
+      }
+      //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
+      write_register(rd, rc);
+      return 0;
     }
-    //fprintf(stderr,"0x%08X = 0x%08X + 0x%08X\n",rc,ra,rb);
-    write_register(rd, rc);
-    return 0;
-  }
 
-  //ADD(5) rd = pc plus immediate
-  if((inst & 0xF800) == 0xA000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x7;
-    rb <<= 2;
-    DO_DISS(statusMsg << "add r" << dec << rd << ",PC,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(15);
-    rc = (ra & (~3u)) + rb;
-    write_register(rd, rc);
-    return 0;
-  }
+    //ADD(5) rd = pc plus immediate
+    case Op::add5:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x7;
+      rb <<= 2;
+      DO_DISS(statusMsg << "add r" << dec << rd << ",PC,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(15);
+      rc = (ra & (~3u)) + rb;
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //ADD(6) rd = sp plus immediate
-  if((inst & 0xF800) == 0xA800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x7;
-    rb <<= 2;
-    DO_DISS(statusMsg << "add r" << dec << rd << ",SP,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(13);
-    rc = ra + rb;
-    write_register(rd, rc);
-    return 0;
-  }
+    //ADD(6) rd = sp plus immediate
+    case Op::add6:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x7;
+      rb <<= 2;
+      DO_DISS(statusMsg << "add r" << dec << rd << ",SP,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(13);
+      rc = ra + rb;
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //ADD(7) sp plus immediate
-  if((inst & 0xFF80) == 0xB000)
-  {
-    rb = (inst >> 0) & 0x7F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "add SP,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(13);
-    rc = ra + rb;
-    write_register(13, rc);
-    return 0;
-  }
+    //ADD(7) sp plus immediate
+    case Op::add7:
+    {
+      rb = (inst >> 0) & 0x7F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "add SP,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(13);
+      rc = ra + rb;
+      write_register(13, rc);
+      return 0;
+    }
 
-  //AND
-  if((inst & 0xFFC0) == 0x4000)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "ands r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra & rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    //AND
+    case Op::and_:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "ands r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra & rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
 
-  //ASR(1) two register immediate
-  if((inst & 0xF800) == 0x1000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-    rc = read_register(rm);
-    if(rb == 0)
+    //ASR(1) two register immediate
+    case Op::asr1:
     {
-      if(rc & 0x80000000)
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
+      rc = read_register(rm);
+      if(rb == 0)
       {
-        do_cflag_bit(1);
-        rc = ~0;
+        if(rc & 0x80000000)
+        {
+          do_cflag_bit(1);
+          rc = ~0;
+        }
+        else
+        {
+          do_cflag_bit(0);
+          rc = 0;
+        }
       }
       else
       {
-        do_cflag_bit(0);
-        rc = 0;
+        do_cflag_bit(rc & (1 << (rb-1)));
+        ra = rc & 0x80000000;
+        rc >>= rb;
+        if(ra) //asr, sign is shifted in
+          rc |= (~0u) << (32-rb);
       }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    else
-    {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      ra = rc & 0x80000000;
-      rc >>= rb;
-      if(ra) //asr, sign is shifted in
-        rc |= (~0u) << (32-rb);
-    }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //ASR(2) two register
-  if((inst & 0xFFC0) == 0x4100)
-  {
-    rd = (inst >> 0) & 0x07;
-    rs = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    rb = read_register(rs);
-    rb &= 0xFF;
-    if(rb == 0)
-    {
-    }
-    else if(rb < 32)
+    //ASR(2) two register
+    case Op::asr2:
     {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      ra = rc & 0x80000000;
-      rc >>= rb;
-      if(ra) //asr, sign is shifted in
+      rd = (inst >> 0) & 0x07;
+      rs = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "asrs r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      rb = read_register(rs);
+      rb &= 0xFF;
+      if(rb == 0)
       {
-        rc |= (~0u) << (32-rb);
       }
-    }
-    else
-    {
-      if(rc & 0x80000000)
+      else if(rb < 32)
       {
-        do_cflag_bit(1);
-        rc = (~0u);
+        do_cflag_bit(rc & (1 << (rb-1)));
+        ra = rc & 0x80000000;
+        rc >>= rb;
+        if(ra) //asr, sign is shifted in
+        {
+          rc |= (~0u) << (32-rb);
+        }
       }
       else
       {
-        do_cflag_bit(0);
-        rc = 0;
+        if(rc & 0x80000000)
+        {
+          do_cflag_bit(1);
+          rc = (~0u);
+        }
+        else
+        {
+          do_cflag_bit(0);
+          rc = 0;
+        }
       }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
-
-  //B(1) conditional branch
-  if((inst & 0xF000) == 0xD000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    if(rb & 0x80)
-      rb |= (~0u) << 8;
-    op=(inst >> 8) & 0xF;
-    rb <<= 1;
-    rb += pc;
-    rb += 2;
-    switch(op)
-    {
-      case 0x0: //b eq  z set
-        DO_DISS(statusMsg << "beq 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_Z)
-          write_register(15, rb);
-        return 0;
 
-      case 0x1: //b ne  z clear
-        DO_DISS(statusMsg << "bne 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_Z))
-          write_register(15, rb);
-        return 0;
+    //B(1) conditional branch
+    case Op::b1:
+    {
+      rb = (inst >> 0) & 0xFF;
+      if(rb & 0x80)
+        rb |= (~0u) << 8;
+      op=(inst >> 8) & 0xF;
+      rb <<= 1;
+      rb += pc;
+      rb += 2;
+      switch(op)
+      {
+        case 0x0: //b eq  z set
+          DO_DISS(statusMsg << "beq 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_Z)
+            write_register(15, rb);
+          return 0;
+
+        case 0x1: //b ne  z clear
+          DO_DISS(statusMsg << "bne 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_Z))
+            write_register(15, rb);
+          return 0;
+
+        case 0x2: //b cs c set
+          DO_DISS(statusMsg << "bcs 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_C)
+            write_register(15, rb);
+          return 0;
+
+        case 0x3: //b cc c clear
+          DO_DISS(statusMsg << "bcc 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_C))
+            write_register(15, rb);
+          return 0;
+
+        case 0x4: //b mi n set
+          DO_DISS(statusMsg << "bmi 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_N)
+            write_register(15, rb);
+          return 0;
+
+        case 0x5: //b pl n clear
+          DO_DISS(statusMsg << "bpl 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_N))
+            write_register(15, rb);
+          return 0;
+
+        case 0x6: //b vs v set
+          DO_DISS(statusMsg << "bvs 0x" << Base::HEX8 << (rb-3) << endl);
+          if(cpsr & CPSR_V)
+            write_register(15,rb);
+          return 0;
+
+        case 0x7: //b vc v clear
+          DO_DISS(statusMsg << "bvc 0x" << Base::HEX8 << (rb-3) << endl);
+          if(!(cpsr & CPSR_V))
+            write_register(15, rb);
+          return 0;
+
+        case 0x8: //b hi c set z clear
+          DO_DISS(statusMsg << "bhi 0x" << Base::HEX8 << (rb-3) << endl);
+          if((cpsr & CPSR_C) && (!(cpsr & CPSR_Z)))
+            write_register(15, rb);
+          return 0;
+
+        case 0x9: //b ls c clear or z set
+          DO_DISS(statusMsg << "bls 0x" << Base::HEX8 << (rb-3) << endl);
+          if((cpsr & CPSR_Z) || (!(cpsr & CPSR_C)))
+            write_register(15, rb);
+          return 0;
+
+        case 0xA: //b ge N == V
+          DO_DISS(statusMsg << "bge 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
+          if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        case 0xB: //b lt N != V
+          DO_DISS(statusMsg << "blt 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
+          if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        case 0xC: //b gt Z==0 and N == V
+          DO_DISS(statusMsg << "bgt 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
+          if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
+          if(cpsr & CPSR_Z) ra = 0;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        case 0xD: //b le Z==1 or N != V
+          DO_DISS(statusMsg << "ble 0x" << Base::HEX8 << (rb-3) << endl);
+          ra = 0;
+          if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
+          if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
+          if(cpsr & CPSR_Z) ra++;
+          if(ra)
+            write_register(15, rb);
+          return 0;
+
+        default:
+          // 0xE (undefined) and 0xF (swi) are never decoded as B(1)
+          break;
+      }
+      break;
+    }
 
-      case 0x2: //b cs c set
-        DO_DISS(statusMsg << "bcs 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_C)
-          write_register(15, rb);
-        return 0;
+    //B(2) unconditional branch
+    case Op::b2:
+    {
+      rb = (inst >> 0) & 0x7FF;
+      if(rb & (1 << 10))
+        rb |= (~0u) << 11;
+      rb <<= 1;
+      rb += pc;
+      rb += 2;
+      DO_DISS(statusMsg << "B 0x" << Base::HEX8 << (rb-3) << endl);
+      write_register(15, rb);
+      return 0;
+    }
 
-      case 0x3: //b cc c clear
-        DO_DISS(statusMsg << "bcc 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_C))
-          write_register(15, rb);
-        return 0;
+    //BIC
+    case Op::bic:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "bics r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra & (~rb);
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
 
-      case 0x4: //b mi n set
-        DO_DISS(statusMsg << "bmi 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_N)
-          write_register(15, rb);
-        return 0;
+    //BKPT
+    case Op::bkpt:
+    {
+      rb = (inst >> 0) & 0xFF;
+      statusMsg << "bkpt 0x" << Base::HEX2 << rb << endl;
+      return 1;
+    }
 
-      case 0x5: //b pl n clear
-        DO_DISS(statusMsg << "bpl 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_N))
-          write_register(15, rb);
+    //BL/BLX(1)
+    case Op::bl:
+    {
+      if((inst & 0x1800) == 0x1000) //H=b10
+      {
+        DO_DISS(statusMsg << endl);
+        rb = inst & ((1 << 11) - 1);
+        if(rb & 1<<10) rb |= (~((1 << 11) - 1)); //sign extend
+        rb <<= 12;
+        rb += pc;
+        write_register(14, rb);
         return 0;
-
-      case 0x6: //b vs v set
-        DO_DISS(statusMsg << "bvs 0x" << Base::HEX8 << (rb-3) << endl);
-        if(cpsr & CPSR_V)
-          write_register(15,rb);
+      }
+      else if((inst & 0x1800) == 0x1800) //H=b11
+      {
+        //branch to thumb
+        rb = read_register(14);
+        rb += (inst & ((1 << 11) - 1)) << 1;;
+        rb += 2;
+        DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
+        write_register(14, (pc-2) | 1);
+        write_register(15, rb);
         return 0;
-
-      case 0x7: //b vc v clear
-        DO_DISS(statusMsg << "bvc 0x" << Base::HEX8 << (rb-3) << endl);
-        if(!(cpsr & CPSR_V))
-          write_register(15, rb);
+      }
+      else if((inst & 0x1800) == 0x0800) //H=b01
+      {
+        //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
+        // fxq: this should exit the code without having to detect it
+        rb = read_register(14);
+        rb += (inst & ((1 << 11) - 1)) << 1;;
+        rb &= 0xFFFFFFFC;
+        rb += 2;
+        DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
+        write_register(14, (pc-2) | 1);
+        write_register(15, rb);
         return 0;
+      }
+      // H=b00 is decoded as B(2)
+      break;
+    }
 
-      case 0x8: //b hi c set z clear
-        DO_DISS(statusMsg << "bhi 0x" << Base::HEX8 << (rb-3) << endl);
-        if((cpsr & CPSR_C) && (!(cpsr & CPSR_Z)))
-          write_register(15, rb);
+    //BLX(2)
+    case Op::blx2:
+    {
+      rm = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "blx r" << dec << rm << endl);
+      rc = read_register(rm);
+      //fprintf(stderr,"blx r%u 0x%X 0x%X\n",rm,rc,pc);
+      rc += 2;
+      if(rc & 1)
+      {
+        write_register(14, (pc-2) | 1);
+        rc &= ~1;
+        write_register(15, rc);
         return 0;
+      }
+      else
+      {
+        //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
+        // fxq: this could serve as exit code
+        return 1;
+      }
+    }
 
-      case 0x9: //b ls c clear or z set
-        DO_DISS(statusMsg << "bls 0x" << Base::HEX8 << (rb-3) << endl);
-        if((cpsr & CPSR_Z) || (!(cpsr & CPSR_C)))
-          write_register(15, rb);
+    //BX
+    case Op::bx:
+    {
+      rm = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "bx r" << dec << rm << endl);
+      rc = read_register(rm);
+      rc += 2;
+      //fprintf(stderr,"bx r%u 0x%X 0x%X\n",rm,rc,pc);
+      if(rc & 1)
+      {
+        // branch to odd address denotes 16 bit ARM code
+        rc &= ~1;
+        write_register(15, rc);
         return 0;
+      }
+      else
+      {
+        // branch to even address denotes 32 bit ARM code, which the Thumbulator
+        // class does not support. So capture relavent information and hand it
+        // off to the Cartridge class for it to handle.
 
-      case 0xA: //b ge N == V
-        DO_DISS(statusMsg << "bge 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
-        if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
-        if(ra)
-          write_register(15, rb);
-        return 0;
+        bool handled = false;
 
-      case 0xB: //b lt N != V
-        DO_DISS(statusMsg << "blt 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
-        if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
-        if(ra)
-          write_register(15, rb);
-        return 0;
+        switch(configuration)
+        {
+          case ConfigureFor::BUS:
+            // this subroutine interface is used in the BUS driver,
+            // it starts at address 0x000006d8
+            // _SetNote:
+            //   ldr     r4, =NoteStore
+            //   bx      r4   // bx instruction at 0x000006da
+            // _ResetWave:
+            //   ldr     r4, =ResetWaveStore
+            //   bx      r4   // bx instruction at 0x000006de
+            // _GetWavePtr:
+            //   ldr     r4, =WavePtrFetch
+            //   bx      r4   // bx instruction at 0x000006e2
+            // _SetWaveSize:
+            //   ldr     r4, =WaveSizeStore
+            //   bx      r4   // bx instruction at 0x000006e6
+
+            // address to test for is + 4 due to pipelining
+
+  #define BUS_SetNote     (0x000006da + 4)
+  #define BUS_ResetWave   (0x000006de + 4)
+  #define BUS_GetWavePtr  (0x000006e2 + 4)
+  #define BUS_SetWaveSize (0x000006e6 + 4)
+
+            if      (pc == BUS_SetNote)
+            {
+              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == BUS_ResetWave)
+            {
+              myCartridge->thumbCallback(1, read_register(2), 0);
+              handled = true;
+            }
+            else if (pc == BUS_GetWavePtr)
+            {
+              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              handled = true;
+            }
+            else if (pc == BUS_SetWaveSize)
+            {
+              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == 0x0000083a)
+            {
+              // exiting Custom ARM code, returning to BUS Driver control
+            }
+            else
+            {
+  #if 0  // uncomment this for testing
+              uInt32 r0 = read_register(0);
+              uInt32 r1 = read_register(1);
+              uInt32 r2 = read_register(2);
+              uInt32 r3 = read_register(3);
+              uInt32 r4 = read_register(4);
+  #endif
+              myCartridge->thumbCallback(255, 0, 0);
+            }
+
+            break;
+
+          case ConfigureFor::CDF:
+            // this subroutine interface is used in the CDF driver,
+            // it starts at address 0x000006e0
+            // _SetNote:
+            //   ldr     r4, =NoteStore
+            //   bx      r4   // bx instruction at 0x000006e2
+            // _ResetWave:
+            //   ldr     r4, =ResetWaveStore
+            //   bx      r4   // bx instruction at 0x000006e6
+            // _GetWavePtr:
+            //   ldr     r4, =WavePtrFetch
+            //   bx      r4   // bx instruction at 0x000006ea
+            // _SetWaveSize:
+            //   ldr     r4, =WaveSizeStore
+            //   bx      r4   // bx instruction at 0x000006ee
+
+            // address to test for is + 4 due to pipelining
+
+          #define CDF_SetNote     (0x000006e2 + 4)
+          #define CDF_ResetWave   (0x000006e6 + 4)
+          #define CDF_GetWavePtr  (0x000006ea + 4)
+          #define CDF_SetWaveSize (0x000006ee + 4)
+
+            if      (pc == CDF_SetNote)
+            {
+              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == CDF_ResetWave)
+            {
+              myCartridge->thumbCallback(1, read_register(2), 0);
+              handled = true;
+            }
+            else if (pc == CDF_GetWavePtr)
+            {
+              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              handled = true;
+            }
+            else if (pc == CDF_SetWaveSize)
+            {
+              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == 0x0000083a)
+            {
+              // exiting Custom ARM code, returning to BUS Driver control
+            }
+            else
+            {
+            #if 0  // uncomment this for testing
+              uInt32 r0 = read_register(0);
+              uInt32 r1 = read_register(1);
+              uInt32 r2 = read_register(2);
+              uInt32 r3 = read_register(3);
+              uInt32 r4 = read_register(4);
+            #endif
+              myCartridge->thumbCallback(255, 0, 0);
+            }
+
+            break;
+
+          case ConfigureFor::CDF1:
+            // this subroutine interface is used in the CDF driver,
+            // it starts at address 0x00000750
+            // _SetNote:
+            //   ldr     r4, =NoteStore
+            //   bx      r4   // bx instruction at 0x000006e2
+            // _ResetWave:
+            //   ldr     r4, =ResetWaveStore
+            //   bx      r4   // bx instruction at 0x000006e6
+            // _GetWavePtr:
+            //   ldr     r4, =WavePtrFetch
+            //   bx      r4   // bx instruction at 0x000006ea
+            // _SetWaveSize:
+            //   ldr     r4, =WaveSizeStore
+            //   bx      r4   // bx instruction at 0x000006ee
+
+            // address to test for is + 4 due to pipelining
+
+  #define CDF1_SetNote     (0x00000752 + 4)
+  #define CDF1_ResetWave   (0x00000756 + 4)
+  #define CDF1_GetWavePtr  (0x0000075a + 4)
+  #define CDF1_SetWaveSize (0x0000075e + 4)
+
+            if      (pc == CDF1_SetNote)
+            {
+              myCartridge->thumbCallback(0, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == CDF1_ResetWave)
+            {
+              myCartridge->thumbCallback(1, read_register(2), 0);
+              handled = true;
+            }
+            else if (pc == CDF1_GetWavePtr)
+            {
+              write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
+              handled = true;
+            }
+            else if (pc == CDF1_SetWaveSize)
+            {
+              myCartridge->thumbCallback(3, read_register(2), read_register(3));
+              handled = true;
+            }
+            else if (pc == 0x0000083a)
+            {
+              // exiting Custom ARM code, returning to BUS Driver control
+            }
+            else
+            {
+  #if 0  // uncomment this for testing
+              uInt32 r0 = read_register(0);
+              uInt32 r1 = read_register(1);
+              uInt32 r2 = read_register(2);
+              uInt32 r3 = read_register(3);
+              uInt32 r4 = read_register(4);
+  #endif
+              myCartridge->thumbCallback(255, 0, 0);
+            }
 
-      case 0xC: //b gt Z==0 and N == V
-        DO_DISS(statusMsg << "bgt 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if(  (cpsr & CPSR_N)  &&   (cpsr & CPSR_V) ) ra++;
-        if((!(cpsr & CPSR_N)) && (!(cpsr & CPSR_V))) ra++;
-        if(cpsr & CPSR_Z) ra = 0;
-        if(ra)
-          write_register(15, rb);
-        return 0;
+            break;
 
-      case 0xD: //b le Z==1 or N != V
-        DO_DISS(statusMsg << "ble 0x" << Base::HEX8 << (rb-3) << endl);
-        ra = 0;
-        if((!(cpsr & CPSR_N)) && (cpsr & CPSR_V)) ra++;
-        if((!(cpsr & CPSR_V)) && (cpsr & CPSR_N)) ra++;
-        if(cpsr & CPSR_Z) ra++;
-        if(ra)
-          write_register(15, rb);
-        return 0;
+          case ConfigureFor::DPCplus:
+            // no 32-bit subroutines in DPC+
+            break;
+        }
 
-      case 0xE:
-        //undefined instruction
-        break;
+        if (handled)
+        {
+          rc = read_register(14); // lr
+          rc += 2;
+          rc &= ~1;
+          write_register(15, rc);
+          return 0;
+        }
 
-      case 0xF:
-        //swi
-        break;
+        return 1;
+      }
     }
-  }
-
-  //B(2) unconditional branch
-  if((inst & 0xF800) == 0xE000)
-  {
-    rb = (inst >> 0) & 0x7FF;
-    if(rb & (1 << 10))
-      rb |= (~0u) << 11;
-    rb <<= 1;
-    rb += pc;
-    rb += 2;
-    DO_DISS(statusMsg << "B 0x" << Base::HEX8 << (rb-3) << endl);
-    write_register(15, rb);
-    return 0;
-  }
-
-  //BIC
-  if((inst & 0xFFC0) == 0x4380)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "bics r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra & (~rb);
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //BKPT
-  if((inst & 0xFF00) == 0xBE00)
-  {
-    rb = (inst >> 0) & 0xFF;
-    statusMsg << "bkpt 0x" << Base::HEX2 << rb << endl;
-    return 1;
-  }
-
-  //BL/BLX(1)
-  if((inst & 0xE000) == 0xE000) //BL,BLX
-  {
-    if((inst & 0x1800) == 0x1000) //H=b10
+    //CMN
+    case Op::cmn:
     {
-      DO_DISS(statusMsg << endl);
-      rb = inst & ((1 << 11) - 1);
-      if(rb & 1<<10) rb |= (~((1 << 11) - 1)); //sign extend
-      rb <<= 12;
-      rb += pc;
-      write_register(14, rb);
+      rn = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "cmns r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra + rb;
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, rb, 0);
+      do_vflag(ra, rb, 0);
       return 0;
     }
-    else if((inst & 0x1800) == 0x1800) //H=b11
+
+    //CMP(1) compare immediate
+    case Op::cmp1:
     {
-      //branch to thumb
-      rb = read_register(14);
-      rb += (inst & ((1 << 11) - 1)) << 1;;
-      rb += 2;
-      DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
-      write_register(14, (pc-2) | 1);
-      write_register(15, rb);
+      rb = (inst >> 0) & 0xFF;
+      rn = (inst >> 8) & 0x07;
+      DO_DISS(statusMsg << "cmp r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rn);
+      rc = ra - rb;
+      //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
       return 0;
     }
-    else if((inst & 0x1800) == 0x0800) //H=b01
+
+    //CMP(2) compare register
+    case Op::cmp2:
     {
-      //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
-      // fxq: this should exit the code without having to detect it
-      rb = read_register(14);
-      rb += (inst & ((1 << 11) - 1)) << 1;;
-      rb &= 0xFFFFFFFC;
-      rb += 2;
-      DO_DISS(statusMsg << "bl 0x" << Base::HEX8 << (rb-3) << endl);
-      write_register(14, (pc-2) | 1);
-      write_register(15, rb);
+      rn = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra - rb;
+      //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
       return 0;
     }
-  }
 
-  //BLX(2)
-  if((inst & 0xFF87) == 0x4780)
-  {
-    rm = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "blx r" << dec << rm << endl);
-    rc = read_register(rm);
-    //fprintf(stderr,"blx r%u 0x%X 0x%X\n",rm,rc,pc);
-    rc += 2;
-    if(rc & 1)
+    //CMP(3) compare high register
+    case Op::cmp3:
     {
-      write_register(14, (pc-2) | 1);
-      rc &= ~1;
-      write_register(15, rc);
+      if(((inst >> 6) & 3) == 0x0)
+      {
+        //UNPREDICTABLE
+      }
+      rn = (inst >> 0) & 0x7;
+      rn |= (inst >> 4) & 0x8;
+      if(rn == 0xF)
+      {
+        //UNPREDICTABLE
+      }
+      rm = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra - rb;
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
       return 0;
     }
-    else
+
+    //CPS
+    case Op::cps:
     {
-      //fprintf(stderr,"cannot branch to arm 0x%08X 0x%04X\n",pc,inst);
-      // fxq: this could serve as exit code
+      DO_DISS(statusMsg << "cps TODO" << endl);
       return 1;
     }
-  }
 
-  //BX
-  if((inst & 0xFF87) == 0x4700)
-  {
-    rm = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "bx r" << dec << rm << endl);
-    rc = read_register(rm);
-    rc += 2;
-    //fprintf(stderr,"bx r%u 0x%X 0x%X\n",rm,rc,pc);
-    if(rc & 1)
+    //CPY copy high register
+    case Op::cpy:
     {
-      // branch to odd address denotes 16 bit ARM code
-      rc &= ~1;
-      write_register(15, rc);
+      //same as mov except you can use both low registers
+      //going to let mov handle high registers
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "cpy r" << dec << rd << ",r" << dec << rm << endl);
+      rc = read_register(rm);
+      write_register(rd, rc);
       return 0;
     }
-    else
-    {
-      // branch to even address denotes 32 bit ARM code, which the Thumbulator
-      // class does not support. So capture relavent information and hand it
-      // off to the Cartridge class for it to handle.
-
-      bool handled = false;
-
-      switch(configuration)
-      {
-        case ConfigureFor::BUS:
-          // this subroutine interface is used in the BUS driver,
-          // it starts at address 0x000006d8
-          // _SetNote:
-          //   ldr     r4, =NoteStore
-          //   bx      r4   // bx instruction at 0x000006da
-          // _ResetWave:
-          //   ldr     r4, =ResetWaveStore
-          //   bx      r4   // bx instruction at 0x000006de
-          // _GetWavePtr:
-          //   ldr     r4, =WavePtrFetch
-          //   bx      r4   // bx instruction at 0x000006e2
-          // _SetWaveSize:
-          //   ldr     r4, =WaveSizeStore
-          //   bx      r4   // bx instruction at 0x000006e6
-
-          // address to test for is + 4 due to pipelining
-
-#define BUS_SetNote     (0x000006da + 4)
-#define BUS_ResetWave   (0x000006de + 4)
-#define BUS_GetWavePtr  (0x000006e2 + 4)
-#define BUS_SetWaveSize (0x000006e6 + 4)
-
-          if      (pc == BUS_SetNote)
-          {
-            myCartridge->thumbCallback(0, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == BUS_ResetWave)
-          {
-            myCartridge->thumbCallback(1, read_register(2), 0);
-            handled = true;
-          }
-          else if (pc == BUS_GetWavePtr)
-          {
-            write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-            handled = true;
-          }
-          else if (pc == BUS_SetWaveSize)
-          {
-            myCartridge->thumbCallback(3, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == 0x0000083a)
-          {
-            // exiting Custom ARM code, returning to BUS Driver control
-          }
-          else
-          {
-#if 0  // uncomment this for testing
-            uInt32 r0 = read_register(0);
-            uInt32 r1 = read_register(1);
-            uInt32 r2 = read_register(2);
-            uInt32 r3 = read_register(3);
-            uInt32 r4 = read_register(4);
-#endif
-            myCartridge->thumbCallback(255, 0, 0);
-          }
 
-          break;
-
-        case ConfigureFor::CDF:
-          // this subroutine interface is used in the CDF driver,
-          // it starts at address 0x000006e0
-          // _SetNote:
-          //   ldr     r4, =NoteStore
-          //   bx      r4   // bx instruction at 0x000006e2
-          // _ResetWave:
-          //   ldr     r4, =ResetWaveStore
-          //   bx      r4   // bx instruction at 0x000006e6
-          // _GetWavePtr:
-          //   ldr     r4, =WavePtrFetch
-          //   bx      r4   // bx instruction at 0x000006ea
-          // _SetWaveSize:
-          //   ldr     r4, =WaveSizeStore
-          //   bx      r4   // bx instruction at 0x000006ee
-
-          // address to test for is + 4 due to pipelining
-
-        #define CDF_SetNote     (0x000006e2 + 4)
-        #define CDF_ResetWave   (0x000006e6 + 4)
-        #define CDF_GetWavePtr  (0x000006ea + 4)
-        #define CDF_SetWaveSize (0x000006ee + 4)
-
-          if      (pc == CDF_SetNote)
-          {
-            myCartridge->thumbCallback(0, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == CDF_ResetWave)
-          {
-            myCartridge->thumbCallback(1, read_register(2), 0);
-            handled = true;
-          }
-          else if (pc == CDF_GetWavePtr)
-          {
-            write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-            handled = true;
-          }
-          else if (pc == CDF_SetWaveSize)
-          {
-            myCartridge->thumbCallback(3, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == 0x0000083a)
-          {
-            // exiting Custom ARM code, returning to BUS Driver control
-          }
-          else
-          {
-          #if 0  // uncomment this for testing
-            uInt32 r0 = read_register(0);
-            uInt32 r1 = read_register(1);
-            uInt32 r2 = read_register(2);
-            uInt32 r3 = read_register(3);
-            uInt32 r4 = read_register(4);
-          #endif
-            myCartridge->thumbCallback(255, 0, 0);
-          }
-
-          break;
-
-        case ConfigureFor::CDF1:
-          // this subroutine interface is used in the CDF driver,
-          // it starts at address 0x00000750
-          // _SetNote:
-          //   ldr     r4, =NoteStore
-          //   bx      r4   // bx instruction at 0x000006e2
-          // _ResetWave:
-          //   ldr     r4, =ResetWaveStore
-          //   bx      r4   // bx instruction at 0x000006e6
-          // _GetWavePtr:
-          //   ldr     r4, =WavePtrFetch
-          //   bx      r4   // bx instruction at 0x000006ea
-          // _SetWaveSize:
-          //   ldr     r4, =WaveSizeStore
-          //   bx      r4   // bx instruction at 0x000006ee
-
-          // address to test for is + 4 due to pipelining
-
-#define CDF1_SetNote     (0x00000752 + 4)
-#define CDF1_ResetWave   (0x00000756 + 4)
-#define CDF1_GetWavePtr  (0x0000075a + 4)
-#define CDF1_SetWaveSize (0x0000075e + 4)
-
-          if      (pc == CDF1_SetNote)
-          {
-            myCartridge->thumbCallback(0, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == CDF1_ResetWave)
-          {
-            myCartridge->thumbCallback(1, read_register(2), 0);
-            handled = true;
-          }
-          else if (pc == CDF1_GetWavePtr)
-          {
-            write_register(2, myCartridge->thumbCallback(2, read_register(2), 0));
-            handled = true;
-          }
-          else if (pc == CDF1_SetWaveSize)
-          {
-            myCartridge->thumbCallback(3, read_register(2), read_register(3));
-            handled = true;
-          }
-          else if (pc == 0x0000083a)
-          {
-            // exiting Custom ARM code, returning to BUS Driver control
-          }
-          else
-          {
-#if 0  // uncomment this for testing
-            uInt32 r0 = read_register(0);
-            uInt32 r1 = read_register(1);
-            uInt32 r2 = read_register(2);
-            uInt32 r3 = read_register(3);
-            uInt32 r4 = read_register(4);
-#endif
-            myCartridge->thumbCallback(255, 0, 0);
-          }
-
-          break;
+    //EOR
+    case Op::eor:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "eors r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra ^ rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
 
-        case ConfigureFor::DPCplus:
-          // no 32-bit subroutines in DPC+
-          break;
+    //LDMIA
+    case Op::ldmia:
+    {
+      rn = (inst >> 8) & 0x7;
+    #if defined(THUMB_DISS)
+      statusMsg << "ldmia r" << dec << rn << "!,{";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+      {
+        if(inst&rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
       }
-
-      if (handled)
+      statusMsg << "}" << endl;
+    #endif
+      sp = read_register(rn);
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
       {
-        rc = read_register(14); // lr
-        rc += 2;
-        rc &= ~1;
-        write_register(15, rc);
-        return 0;
+        if(inst & rb)
+        {
+          write_register(ra, read32(sp));
+          sp += 4;
+        }
       }
+      //there is a write back exception.
+      if((inst & (1 << rn)) == 0)
+        write_register(rn, sp);
 
-      return 1;
+      return 0;
     }
-  }
 
-  //CMN
-  if((inst & 0xFFC0) == 0x42C0)
-  {
-    rn = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "cmns r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra + rb;
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, rb, 0);
-    do_vflag(ra, rb, 0);
-    return 0;
-  }
-
-  //CMP(1) compare immediate
-  if((inst & 0xF800) == 0x2800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rn = (inst >> 8) & 0x07;
-    DO_DISS(statusMsg << "cmp r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rn);
-    rc = ra - rb;
-    //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
-
-  //CMP(2) compare register
-  if((inst & 0xFFC0) == 0x4280)
-  {
-    rn = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra - rb;
-    //fprintf(stderr,"0x%08X 0x%08X\n",ra,rb);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
-
-  //CMP(3) compare high register
-  if((inst & 0xFF00) == 0x4500)
-  {
-    if(((inst >> 6) & 3) == 0x0)
-    {
-      //UNPREDICTABLE
-    }
-    rn = (inst >> 0) & 0x7;
-    rn |= (inst >> 4) & 0x8;
-    if(rn == 0xF)
-    {
-      //UNPREDICTABLE
-    }
-    rm = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "cmps r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra - rb;
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
+    //LDR(1) two register immediate
+    case Op::ldr1:
+    {
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //CPS
-  if((inst & 0xFFE8) == 0xB660)
-  {
-    DO_DISS(statusMsg << "cps TODO" << endl);
-    return 1;
-  }
+    //LDR(2) three register
+    case Op::ldr2:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",r" << dec << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //CPY copy high register
-  if((inst & 0xFFC0) == 0x4600)
-  {
-    //same as mov except you can use both low registers
-    //going to let mov handle high registers
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "cpy r" << dec << rd << ",r" << dec << rm << endl);
-    rc = read_register(rm);
-    write_register(rd, rc);
-    return 0;
-  }
+    //LDR(3)
+    case Op::ldr3:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      rb <<= 2;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[PC+#0x" << Base::HEX2 << rb << "] ");
+      ra = read_register(15);
+      ra &= ~3;
+      rb += ra;
+      DO_DISS(statusMsg << ";@ 0x" << Base::HEX2 << rb << endl);
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //EOR
-  if((inst & 0xFFC0) == 0x4040)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "eors r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra ^ rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
+    //LDR(4)
+    case Op::ldr4:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      rb <<= 2;
+      DO_DISS(statusMsg << "ldr r" << dec << rd << ",[SP+#0x" << Base::HEX2 << rb << "]" << endl);
+      ra = read_register(13);
+      //ra&=~3;
+      rb += ra;
+      rc = read32(rb);
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //LDMIA
-  if((inst & 0xF800) == 0xC800)
-  {
-    rn = (inst >> 8) & 0x7;
-  #if defined(THUMB_DISS)
-    statusMsg << "ldmia r" << dec << rn << "!,{";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+    //LDRB(1)
+    case Op::ldrb1:
     {
-      if(inst&rb)
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read16(rb & (~1u));
+      if(rb & 1)
       {
-        if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
+        rc >>= 8;
       }
+      else
+      {
+      }
+      write_register(rd, rc & 0xFF);
+      return 0;
     }
-    statusMsg << "}" << endl;
-  #endif
-    sp = read_register(rn);
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+
+    //LDRB(2)
+    case Op::ldrb2:
     {
-      if(inst & rb)
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb & (~1u));
+      if(rb & 1)
       {
-        write_register(ra, read32(sp));
-        sp += 4;
+        rc >>= 8;
       }
+      else
+      {
+      }
+      write_register(rd, rc & 0xFF);
+      return 0;
     }
-    //there is a write back exception.
-    if((inst & (1 << rn)) == 0)
-      write_register(rn, sp);
-
-    return 0;
-  }
-
-  //LDR(1) two register immediate
-  if((inst & 0xF800) == 0x6800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //LDR(2) three register
-  if((inst & 0xFE00) == 0x5800)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[r" << dec << rn << ",r" << dec << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //LDR(3)
-  if((inst & 0xF800) == 0x4800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    rb <<= 2;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[PC+#0x" << Base::HEX2 << rb << "] ");
-    ra = read_register(15);
-    ra &= ~3;
-    rb += ra;
-    DO_DISS(statusMsg << ";@ 0x" << Base::HEX2 << rb << endl);
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //LDR(4)
-  if((inst & 0xF800) == 0x9800)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    rb <<= 2;
-    DO_DISS(statusMsg << "ldr r" << dec << rd << ",[SP+#0x" << Base::HEX2 << rb << "]" << endl);
-    ra = read_register(13);
-    //ra&=~3;
-    rb += ra;
-    rc = read32(rb);
-    write_register(rd, rc);
-    return 0;
-  }
 
-  //LDRB(1)
-  if((inst & 0xF800) == 0x7800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read16(rb & (~1u));
-    if(rb & 1)
+    //LDRH(1)
+    case Op::ldrh1:
     {
-      rc >>= 8;
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 1;
+      DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb=read_register(rn) + rb;
+      rc = read16(rb);
+      write_register(rd, rc & 0xFFFF);
+      return 0;
     }
-    else
+
+    //LDRH(2)
+    case Op::ldrh2:
     {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb);
+      write_register(rd, rc & 0xFFFF);
+      return 0;
     }
-    write_register(rd, rc & 0xFF);
-    return 0;
-  }
 
-  //LDRB(2)
-  if((inst & 0xFE00) == 0x5C00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb & (~1u));
-    if(rb & 1)
+    //LDRSB
+    case Op::ldrsb:
     {
-      rc >>= 8;
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrsb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb & (~1u));
+      if(rb & 1)
+      {
+        rc >>= 8;
+      }
+      else
+      {
+      }
+      rc &= 0xFF;
+      if(rc & 0x80)
+        rc |= ((~0u) << 8);
+      write_register(rd, rc);
+      return 0;
     }
-    else
+
+    //LDRSH
+    case Op::ldrsh:
     {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "ldrsh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read16(rb);
+      rc &= 0xFFFF;
+      if(rc & 0x8000)
+        rc |= ((~0u) << 16);
+      write_register(rd, rc);
+      return 0;
     }
-    write_register(rd, rc & 0xFF);
-    return 0;
-  }
 
-  //LDRH(1)
-  if((inst & 0xF800) == 0x8800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 1;
-    DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb=read_register(rn) + rb;
-    rc = read16(rb);
-    write_register(rd, rc & 0xFFFF);
-    return 0;
-  }
+    //LSL(1)
+    case Op::lsl1:
+    {
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
+      rc = read_register(rm);
+      if(rb == 0)
+      {
+        //if immed_5 == 0
+        //C unaffected
+        //result not shifted
+      }
+      else
+      {
+        //else immed_5 > 0
+        do_cflag_bit(rc & (1 << (32-rb)));
+        rc <<= rb;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
 
-  //LDRH(2)
-  if((inst & 0xFE00) == 0x5A00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb);
-    write_register(rd, rc & 0xFFFF);
-    return 0;
-  }
+    //LSL(2) two register
+    case Op::lsl2:
+    {
+      rd = (inst >> 0) & 0x07;
+      rs = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      rb = read_register(rs);
+      rb &= 0xFF;
+      if(rb == 0)
+      {
+      }
+      else if(rb < 32)
+      {
+        do_cflag_bit(rc & (1 << (32-rb)));
+        rc <<= rb;
+      }
+      else if(rb == 32)
+      {
+        do_cflag_bit(rc & 1);
+        rc = 0;
+      }
+      else
+      {
+        do_cflag_bit(0);
+        rc = 0;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
+    }
 
-  //LDRSB
-  if((inst & 0xFE00) == 0x5600)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrsb r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb & (~1u));
-    if(rb & 1)
+    //LSR(1) two register immediate
+    case Op::lsr1:
     {
-      rc >>= 8;
+      rd = (inst >> 0) & 0x07;
+      rm = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
+      rc = read_register(rm);
+      if(rb == 0)
+      {
+        do_cflag_bit(rc & 0x80000000);
+        rc = 0;
+      }
+      else
+      {
+        do_cflag_bit(rc & (1 << (rb-1)));
+        rc >>= rb;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    else
+
+    //LSR(2) two register
+    case Op::lsr2:
     {
+      rd = (inst >> 0) & 0x07;
+      rs = (inst >> 3) & 0x07;
+      DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      rb = read_register(rs);
+      rb &= 0xFF;
+      if(rb == 0)
+      {
+      }
+      else if(rb < 32)
+      {
+        do_cflag_bit(rc & (1 << (rb-1)));
+        rc >>= rb;
+      }
+      else if(rb == 32)
+      {
+        do_cflag_bit(rc & 0x80000000);
+        rc = 0;
+      }
+      else
+      {
+        do_cflag_bit(0);
+        rc = 0;
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    rc &= 0xFF;
-    if(rc & 0x80)
-      rc |= ((~0u) << 8);
-    write_register(rd, rc);
-    return 0;
-  }
 
-  //LDRSH
-  if((inst & 0xFE00) == 0x5E00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "ldrsh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read16(rb);
-    rc &= 0xFFFF;
-    if(rc & 0x8000)
-      rc |= ((~0u) << 16);
-    write_register(rd, rc);
-    return 0;
-  }
+    //MOV(1) immediate
+    case Op::mov1:
+    {
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      DO_DISS(statusMsg << "movs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
+      write_register(rd, rb);
+      do_nflag(rb);
+      do_zflag(rb);
+      return 0;
+    }
 
-  //LSL(1)
-  if((inst & 0xF800) == 0x0000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-    rc = read_register(rm);
-    if(rb == 0)
+    //MOV(2) two low registers
+    case Op::mov2:
     {
-      //if immed_5 == 0
-      //C unaffected
-      //result not shifted
+      rd = (inst >> 0) & 7;
+      rn = (inst >> 3) & 7;
+      DO_DISS(statusMsg << "movs r" << dec << rd << ",r" << dec << rn << endl);
+      rc = read_register(rn);
+      //fprintf(stderr,"0x%08X\n",rc);
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag_bit(0);
+      do_vflag_bit(0);
+      return 0;
     }
-    else
+
+    //MOV(3)
+    case Op::mov3:
     {
-      //else immed_5 > 0
-      do_cflag_bit(rc & (1 << (32-rb)));
-      rc <<= rb;
+      rd  = (inst >> 0) & 0x7;
+      rd |= (inst >> 4) & 0x8;
+      rm  = (inst >> 3) & 0xF;
+      DO_DISS(statusMsg << "mov r" << dec << rd << ",r" << dec << rm << endl);
+      rc = read_register(rm);
+      if((rd == 14) && (rm == 15))
+      {
+        //printf("mov lr,pc warning 0x%08X\n",pc-2);
+        //rc|=1;
+      }
+      if(rd == 15)
+      {
+        rc &= ~1; //write_register may do this as well
+        rc += 2;  //The program counter is special
+      }
+      write_register(rd, rc);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //LSL(2) two register
-  if((inst & 0xFFC0) == 0x4080)
-  {
-    rd = (inst >> 0) & 0x07;
-    rs = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "lsls r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    rb = read_register(rs);
-    rb &= 0xFF;
-    if(rb == 0)
+    //MUL
+    case Op::mul:
     {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "muls r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra * rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    else if(rb < 32)
+
+    //MVN
+    case Op::mvn:
     {
-      do_cflag_bit(rc & (1 << (32-rb)));
-      rc <<= rb;
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "mvns r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = (~ra);
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    else if(rb == 32)
+
+    //NEG
+    case Op::neg:
     {
-      do_cflag_bit(rc & 1);
-      rc = 0;
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "negs r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = 0 - ra;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(0, ~ra, 1);
+      do_vflag(0, ~ra, 1);
+      return 0;
     }
-    else
+
+    //ORR
+    case Op::orr:
     {
-      do_cflag_bit(0);
-      rc = 0;
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "orrs r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra | rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //LSR(1) two register immediate
-  if((inst & 0xF800) == 0x0800)
-  {
-    rd = (inst >> 0) & 0x07;
-    rm = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rm << ",#0x" << Base::HEX2 << rb << endl);
-    rc = read_register(rm);
-    if(rb == 0)
+    //POP
+    case Op::pop:
     {
-      do_cflag_bit(rc & 0x80000000);
-      rc = 0;
+    #if defined(THUMB_DISS)
+      statusMsg << "pop {";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+      {
+        if(inst&rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
+      }
+      if(inst&0x100)
+      {
+        if(rc) statusMsg << ",";
+        statusMsg << "pc";
+      }
+      statusMsg << "}" << endl;
+    #endif
+
+      sp = read_register(13);
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+      {
+        if(inst & rb)
+        {
+          write_register(ra, read32(sp));
+          sp += 4;
+        }
+      }
+      if(inst & 0x100)
+      {
+        rc = read32(sp);
+        rc += 2;
+        write_register(15, rc);
+        sp += 4;
+      }
+      write_register(13, sp);
+      return 0;
     }
-    else
+
+    //PUSH
+    case Op::push:
     {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      rc >>= rb;
+    #if defined(THUMB_DISS)
+      statusMsg << "push {";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+      {
+        if(inst&rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
+      }
+      if(inst&0x100)
+      {
+        if(rc) statusMsg << ",";
+        statusMsg << "lr";
+      }
+      statusMsg << "}" << endl;
+    #endif
+
+      sp = read_register(13);
+      //fprintf(stderr,"sp 0x%08X\n",sp);
+      for(ra = 0, rb = 0x01, rc = 0; rb; rb = (rb << 1) & 0xFF, ra++)
+      {
+        if(inst & rb)
+        {
+          rc++;
+        }
+      }
+      if(inst & 0x100) rc++;
+      rc <<= 2;
+      sp -= rc;
+      rd = sp;
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+      {
+        if(inst & rb)
+        {
+          write32(rd, read_register(ra));
+          rd += 4;
+        }
+      }
+      if(inst & 0x100)
+      {
+        rc = read_register(14);
+        write32(rd, rc);
+        if((rc & 1) == 0)
+        {
+          // FIXME fprintf(stderr,"push {lr} with an ARM address pc 0x%08X popped 0x%08X\n",pc,rc);
+        }
+      }
+      write_register(13, sp);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //LSR(2) two register
-  if((inst & 0xFFC0) == 0x40C0)
-  {
-    rd = (inst >> 0) & 0x07;
-    rs = (inst >> 3) & 0x07;
-    DO_DISS(statusMsg << "lsrs r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    rb = read_register(rs);
-    rb &= 0xFF;
-    if(rb == 0)
-    {
-    }
-    else if(rb < 32)
+    //REV
+    case Op::rev:
     {
-      do_cflag_bit(rc & (1 << (rb-1)));
-      rc >>= rb;
-    }
-    else if(rb == 32)
-    {
-      do_cflag_bit(rc & 0x80000000);
-      rc = 0;
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "rev r" << dec << rd << ",r" << dec << rn << endl);
+      ra = read_register(rn);
+      rc  = ((ra >>  0) & 0xFF) << 24;
+      rc |= ((ra >>  8) & 0xFF) << 16;
+      rc |= ((ra >> 16) & 0xFF) <<  8;
+      rc |= ((ra >> 24) & 0xFF) <<  0;
+      write_register(rd, rc);
+      return 0;
     }
-    else
+
+    //REV16
+    case Op::rev16:
     {
-      do_cflag_bit(0);
-      rc = 0;
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "rev16 r" << dec << rd << ",r" << dec << rn << endl);
+      ra = read_register(rn);
+      rc  = ((ra >>  0) & 0xFF) <<  8;
+      rc |= ((ra >>  8) & 0xFF) <<  0;
+      rc |= ((ra >> 16) & 0xFF) << 24;
+      rc |= ((ra >> 24) & 0xFF) << 16;
+      write_register(rd, rc);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
-
-  //MOV(1) immediate
-  if((inst & 0xF800) == 0x2000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    DO_DISS(statusMsg << "movs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-    write_register(rd, rb);
-    do_nflag(rb);
-    do_zflag(rb);
-    return 0;
-  }
-
-  //MOV(2) two low registers
-  if((inst & 0xFFC0) == 0x1C00)
-  {
-    rd = (inst >> 0) & 7;
-    rn = (inst >> 3) & 7;
-    DO_DISS(statusMsg << "movs r" << dec << rd << ",r" << dec << rn << endl);
-    rc = read_register(rn);
-    //fprintf(stderr,"0x%08X\n",rc);
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag_bit(0);
-    do_vflag_bit(0);
-    return 0;
-  }
 
-  //MOV(3)
-  if((inst & 0xFF00) == 0x4600)
-  {
-    rd  = (inst >> 0) & 0x7;
-    rd |= (inst >> 4) & 0x8;
-    rm  = (inst >> 3) & 0xF;
-    DO_DISS(statusMsg << "mov r" << dec << rd << ",r" << dec << rm << endl);
-    rc = read_register(rm);
-    if((rd == 14) && (rm == 15))
+    //REVSH
+    case Op::revsh:
     {
-      //printf("mov lr,pc warning 0x%08X\n",pc-2);
-      //rc|=1;
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "revsh r" << dec << rd << ",r" << dec << rn << endl);
+      ra = read_register(rn);
+      rc  = ((ra >> 0) & 0xFF) << 8;
+      rc |= ((ra >> 8) & 0xFF) << 0;
+      if(rc & 0x8000) rc |= 0xFFFF0000;
+      else            rc &= 0x0000FFFF;
+      write_register(rd, rc);
+      return 0;
     }
-    if(rd == 15)
+
+    //ROR
+    case Op::ror:
     {
-      rc &= ~1; //write_register may do this as well
-      rc += 2;  //The program counter is special
+      rd = (inst >> 0) & 0x7;
+      rs = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "rors r" << dec << rd << ",r" << dec << rs << endl);
+      rc = read_register(rd);
+      ra = read_register(rs);
+      ra &= 0xFF;
+      if(ra == 0)
+      {
+      }
+      else
+      {
+        ra &= 0x1F;
+        if(ra == 0)
+        {
+          do_cflag_bit(rc & 0x80000000);
+        }
+        else
+        {
+          do_cflag_bit(rc & (1 << (ra-1)));
+          rb = rc << (32-ra);
+          rc >>= ra;
+          rc |= rb;
+        }
+      }
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //MUL
-  if((inst & 0xFFC0) == 0x4340)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "muls r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra * rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
-
-  //MVN
-  if((inst & 0xFFC0) == 0x43C0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "mvns r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = (~ra);
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
-
-  //NEG
-  if((inst & 0xFFC0) == 0x4240)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "negs r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = 0 - ra;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(0, ~ra, 1);
-    do_vflag(0, ~ra, 1);
-    return 0;
-  }
-
-  //ORR
-  if((inst & 0xFFC0) == 0x4300)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "orrs r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra | rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //POP
-  if((inst & 0xFE00) == 0xBC00)
-  {
-  #if defined(THUMB_DISS)
-    statusMsg << "pop {";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+    //SBC
+    case Op::sbc:
     {
-      if(inst&rb)
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "sbc r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rd);
+      rb = read_register(rm);
+      rc = ra - rb;
+      if(!(cpsr & CPSR_C)) rc--;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      if(cpsr & CPSR_C)
       {
-        if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
+        do_cflag(ra, ~rb, 1);
+        do_vflag(ra, ~rb, 1);
       }
+      else
+      {
+        do_cflag(ra, ~rb, 0);
+        do_vflag(ra, ~rb, 0);
+      }
+      return 0;
     }
-    if(inst&0x100)
+
+    //SETEND
+    case Op::setend:
     {
-      if(rc) statusMsg << ",";
-      statusMsg << "pc";
+      statusMsg << "setend not implemented" << endl;
+      return 1;
     }
-    statusMsg << "}" << endl;
-  #endif
 
-    sp = read_register(13);
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+    //STMIA
+    case Op::stmia:
     {
-      if(inst & rb)
+      rn = (inst >> 8) & 0x7;
+    #if defined(THUMB_DISS)
+      statusMsg << "stmia r" << dec << rn << "!,{";
+      for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
       {
-        write_register(ra, read32(sp));
-        sp += 4;
+        if(inst & rb)
+        {
+          if(rc) statusMsg << ",";
+          statusMsg << "r" << dec << ra;
+          rc++;
+        }
+      }
+      statusMsg << "}" << endl;
+    #endif
+
+      sp = read_register(rn);
+      for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+      {
+        if(inst & rb)
+        {
+          write32(sp, read_register(ra));
+          sp += 4;
+        }
       }
+      write_register(rn, sp);
+      return 0;
     }
-    if(inst & 0x100)
+
+    //STR(1)
+    case Op::str1:
     {
-      rc = read32(sp);
-      rc += 2;
-      write_register(15, rc);
-      sp += 4;
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read_register(rd);
+      write32(rb, rc);
+      return 0;
     }
-    write_register(13, sp);
-    return 0;
-  }
 
-  //PUSH
-  if((inst & 0xFE00) == 0xB400)
-  {
-  #if defined(THUMB_DISS)
-    statusMsg << "push {";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+    //STR(2)
+    case Op::str2:
     {
-      if(inst&rb)
-      {
-        if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
-      }
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read_register(rd);
+      write32(rb, rc);
+      return 0;
     }
-    if(inst&0x100)
+
+    //STR(3)
+    case Op::str3:
     {
-      if(rc) statusMsg << ",";
-      statusMsg << "lr";
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      rb <<= 2;
+      DO_DISS(statusMsg << "str r" << dec << rd << ",[SP,#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(13) + rb;
+      //fprintf(stderr,"0x%08X\n",rb);
+      rc = read_register(rd);
+      write32(rb, rc);
+      return 0;
     }
-    statusMsg << "}" << endl;
-  #endif
 
-    sp = read_register(13);
-    //fprintf(stderr,"sp 0x%08X\n",sp);
-    for(ra = 0, rb = 0x01, rc = 0; rb; rb = (rb << 1) & 0xFF, ra++)
+    //STRB(1)
+    case Op::strb1:
     {
-      if(inst & rb)
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX8 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc = read_register(rd);
+      ra = read16(rb & (~1u));
+      if(rb & 1)
       {
-        rc++;
+        ra &= 0x00FF;
+        ra |= rc << 8;
       }
-    }
-    if(inst & 0x100) rc++;
-    rc <<= 2;
-    sp -= rc;
-    rd = sp;
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
-    {
-      if(inst & rb)
+      else
       {
-        write32(rd, read_register(ra));
-        rd += 4;
+        ra &= 0xFF00;
+        ra |= rc & 0x00FF;
       }
+      write16(rb & (~1u), ra & 0xFFFF);
+      return 0;
     }
-    if(inst & 0x100)
+
+    //STRB(2)
+    case Op::strb2:
     {
-      rc = read_register(14);
-      write32(rd, rc);
-      if((rc & 1) == 0)
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",r" << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read_register(rd);
+      ra = read16(rb & (~1u));
+      if(rb & 1)
       {
-        // FIXME fprintf(stderr,"push {lr} with an ARM address pc 0x%08X popped 0x%08X\n",pc,rc);
+        ra &= 0x00FF;
+        ra |= rc << 8;
       }
+      else
+      {
+        ra &= 0xFF00;
+        ra |= rc & 0x00FF;
+      }
+      write16(rb & (~1u), ra & 0xFFFF);
+      return 0;
     }
-    write_register(13, sp);
-    return 0;
-  }
-
-  //REV
-  if((inst & 0xFFC0) == 0xBA00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "rev r" << dec << rd << ",r" << dec << rn << endl);
-    ra = read_register(rn);
-    rc  = ((ra >>  0) & 0xFF) << 24;
-    rc |= ((ra >>  8) & 0xFF) << 16;
-    rc |= ((ra >> 16) & 0xFF) <<  8;
-    rc |= ((ra >> 24) & 0xFF) <<  0;
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //REV16
-  if((inst & 0xFFC0) == 0xBA40)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "rev16 r" << dec << rd << ",r" << dec << rn << endl);
-    ra = read_register(rn);
-    rc  = ((ra >>  0) & 0xFF) <<  8;
-    rc |= ((ra >>  8) & 0xFF) <<  0;
-    rc |= ((ra >> 16) & 0xFF) << 24;
-    rc |= ((ra >> 24) & 0xFF) << 16;
-    write_register(rd, rc);
-    return 0;
-  }
-
-  //REVSH
-  if((inst & 0xFFC0) == 0xBAC0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "revsh r" << dec << rd << ",r" << dec << rn << endl);
-    ra = read_register(rn);
-    rc  = ((ra >> 0) & 0xFF) << 8;
-    rc |= ((ra >> 8) & 0xFF) << 0;
-    if(rc & 0x8000) rc |= 0xFFFF0000;
-    else            rc &= 0x0000FFFF;
-    write_register(rd, rc);
-    return 0;
-  }
 
-  //ROR
-  if((inst & 0xFFC0) == 0x41C0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rs = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "rors r" << dec << rd << ",r" << dec << rs << endl);
-    rc = read_register(rd);
-    ra = read_register(rs);
-    ra &= 0xFF;
-    if(ra == 0)
+    //STRH(1)
+    case Op::strh1:
     {
+      rd = (inst >> 0) & 0x07;
+      rn = (inst >> 3) & 0x07;
+      rb = (inst >> 6) & 0x1F;
+      rb <<= 1;
+      DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
+      rb = read_register(rn) + rb;
+      rc=  read_register(rd);
+      write16(rb, rc & 0xFFFF);
+      return 0;
     }
-    else
+
+    //STRH(2)
+    case Op::strh2:
     {
-      ra &= 0x1F;
-      if(ra == 0)
-      {
-        do_cflag_bit(rc & 0x80000000);
-      }
-      else
-      {
-        do_cflag_bit(rc & (1 << (ra-1)));
-        rb = rc << (32-ra);
-        rc >>= ra;
-        rc |= rb;
-      }
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
+      rb = read_register(rn) + read_register(rm);
+      rc = read_register(rd);
+      write16(rb, rc & 0xFFFF);
+      return 0;
     }
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
-  }
 
-  //SBC
-  if((inst & 0xFFC0) == 0x4180)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "sbc r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rd);
-    rb = read_register(rm);
-    rc = ra - rb;
-    if(!(cpsr & CPSR_C)) rc--;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    if(cpsr & CPSR_C)
+    //SUB(1)
+    case Op::sub1:
     {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rb = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rn);
+      rc = ra - rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
       do_cflag(ra, ~rb, 1);
       do_vflag(ra, ~rb, 1);
+      return 0;
     }
-    else
+
+    //SUB(2)
+    case Op::sub2:
     {
-      do_cflag(ra, ~rb, 0);
-      do_vflag(ra, ~rb, 0);
+      rb = (inst >> 0) & 0xFF;
+      rd = (inst >> 8) & 0x07;
+      DO_DISS(statusMsg << "subs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(rd);
+      rc = ra - rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
     }
-    return 0;
-  }
 
-  //SETEND
-  if((inst & 0xFFF7) == 0xB650)
-  {
-    statusMsg << "setend not implemented" << endl;
-    return 1;
-  }
+    //SUB(3)
+    case Op::sub3:
+    {
+      rd = (inst >> 0) & 0x7;
+      rn = (inst >> 3) & 0x7;
+      rm = (inst >> 6) & 0x7;
+      DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra - rb;
+      write_register(rd, rc);
+      do_nflag(rc);
+      do_zflag(rc);
+      do_cflag(ra, ~rb, 1);
+      do_vflag(ra, ~rb, 1);
+      return 0;
+    }
 
-  //STMIA
-  if((inst & 0xF800) == 0xC000)
-  {
-    rn = (inst >> 8) & 0x7;
-  #if defined(THUMB_DISS)
-    statusMsg << "stmia r" << dec << rn << "!,{";
-    for(ra=0,rb=0x01,rc=0;rb;rb=(rb<<1)&0xFF,ra++)
+    //SUB(4)
+    case Op::sub4:
     {
-      if(inst & rb)
-      {
-        if(rc) statusMsg << ",";
-        statusMsg << "r" << dec << ra;
-        rc++;
-      }
+      rb = inst & 0x7F;
+      rb <<= 2;
+      DO_DISS(statusMsg << "sub SP,#0x" << Base::HEX2 << rb << endl);
+      ra = read_register(13);
+      ra -= rb;
+      write_register(13, ra);
+      return 0;
     }
-    statusMsg << "}" << endl;
-  #endif
 
-    sp = read_register(rn);
-    for(ra = 0, rb = 0x01; rb; rb = (rb << 1) & 0xFF, ra++)
+    //SWI
+    case Op::swi:
     {
-      if(inst & rb)
+      rb = inst & 0xFF;
+      DO_DISS(statusMsg << "swi 0x" << Base::HEX2 << rb << endl);
+
+      if((inst & 0xFF) == 0xCC)
       {
-        write32(sp, read_register(ra));
-        sp += 4;
+        write_register(0, cpsr);
+        return 0;
+      }
+      else
+      {
+        statusMsg << endl << endl << "swi 0x" << Base::HEX2 << rb << endl;
+        return 1;
       }
     }
-    write_register(rn, sp);
-    return 0;
-  }
-
-  //STR(1)
-  if((inst & 0xF800) == 0x6000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read_register(rd);
-    write32(rb, rc);
-    return 0;
-  }
-
-  //STR(2)
-  if((inst & 0xFE00) == 0x5000)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "str r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read_register(rd);
-    write32(rb, rc);
-    return 0;
-  }
 
-  //STR(3)
-  if((inst & 0xF800) == 0x9000)
-  {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    rb <<= 2;
-    DO_DISS(statusMsg << "str r" << dec << rd << ",[SP,#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(13) + rb;
-    //fprintf(stderr,"0x%08X\n",rb);
-    rc = read_register(rd);
-    write32(rb, rc);
-    return 0;
-  }
+    //SXTB
+    case Op::sxtb:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "sxtb r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFF;
+      if(rc & 0x80)
+        rc |= (~0u) << 8;
+      write_register(rd, rc);
+      return 0;
+    }
 
-  //STRB(1)
-  if((inst & 0xF800) == 0x7000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX8 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc = read_register(rd);
-    ra = read16(rb & (~1u));
-    if(rb & 1)
-    {
-      ra &= 0x00FF;
-      ra |= rc << 8;
+    //SXTH
+    case Op::sxth:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "sxth r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFFFF;
+      if(rc & 0x8000)
+        rc |= (~0u) << 16;
+      write_register(rd, rc);
+      return 0;
     }
-    else
+
+    //TST
+    case Op::tst:
     {
-      ra &= 0xFF00;
-      ra |= rc & 0x00FF;
+      rn = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "tst r" << dec << rn << ",r" << dec << rm << endl);
+      ra = read_register(rn);
+      rb = read_register(rm);
+      rc = ra & rb;
+      do_nflag(rc);
+      do_zflag(rc);
+      return 0;
     }
-    write16(rb & (~1u), ra & 0xFFFF);
-    return 0;
-  }
 
-  //STRB(2)
-  if((inst & 0xFE00) == 0x5400)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "strb r" << dec << rd << ",[r" << dec << rn << ",r" << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read_register(rd);
-    ra = read16(rb & (~1u));
-    if(rb & 1)
-    {
-      ra &= 0x00FF;
-      ra |= rc << 8;
+    //UXTB
+    case Op::uxtb:
+    {
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "uxtb r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFF;
+      write_register(rd, rc);
+      return 0;
     }
-    else
+
+    //UXTH
+    case Op::uxth:
     {
-      ra &= 0xFF00;
-      ra |= rc & 0x00FF;
+      rd = (inst >> 0) & 0x7;
+      rm = (inst >> 3) & 0x7;
+      DO_DISS(statusMsg << "uxth r" << dec << rd << ",r" << dec << rm << endl);
+      ra = read_register(rm);
+      rc = ra & 0xFFFF;
+      write_register(rd, rc);
+      return 0;
     }
-    write16(rb & (~1u), ra & 0xFFFF);
-    return 0;
-  }
 
-  //STRH(1)
-  if((inst & 0xF800) == 0x8000)
-  {
-    rd = (inst >> 0) & 0x07;
-    rn = (inst >> 3) & 0x07;
-    rb = (inst >> 6) & 0x1F;
-    rb <<= 1;
-    DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",#0x" << Base::HEX2 << rb << "]" << endl);
-    rb = read_register(rn) + rb;
-    rc=  read_register(rd);
-    write16(rb, rc & 0xFFFF);
-    return 0;
+    case Op::invalid:
+    case Op::undecoded:
+      break;
   }
 
-  //STRH(2)
-  if((inst & 0xFE00) == 0x5200)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "strh r" << dec << rd << ",[r" << dec << rn << ",r" << dec << rm << "]" << endl);
-    rb = read_register(rn) + read_register(rm);
-    rc = read_register(rd);
-    write16(rb, rc & 0xFFFF);
-    return 0;
-  }
+  statusMsg << "invalid instruction " << Base::HEX8 << pc << " " << Base::HEX4 << inst << endl;
+  return 1;
+}
 
-  //SUB(1)
-  if((inst & 0xFE00) == 0x1E00)
-  {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rb = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rn);
-    rc = ra - rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
-  }
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Thumbulator::executeProfiled()
+{
+  const uInt32 addr = read_register(15) - 2;
+  const uInt64 accesses = reads + writes;
 
-  //SUB(2)
-  if((inst & 0xF800) == 0x3800)
+  int result = execute();
+
+  ProfileEntry* entry = profileEntry(addr);
+  if(entry)
   {
-    rb = (inst >> 0) & 0xFF;
-    rd = (inst >> 8) & 0x07;
-    DO_DISS(statusMsg << "subs r" << dec << rd << ",#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(rd);
-    rc = ra - rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
+    entry->instructions++;
+    entry->accesses += reads + writes - accesses;
   }
 
-  //SUB(3)
-  if((inst & 0xFE00) == 0x1A00)
+  // BL and BLX set LR to the address of the next instruction (with the
+  // Thumb bit set) and then branch; this identifies the called functions
+  const uInt32 pc = read_register(15);
+  if(reg_norm[14] == ((addr + 2) | 1) && pc != addr + 4)
   {
-    rd = (inst >> 0) & 0x7;
-    rn = (inst >> 3) & 0x7;
-    rm = (inst >> 6) & 0x7;
-    DO_DISS(statusMsg << "subs r" << dec << rd << ",r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra - rb;
-    write_register(rd, rc);
-    do_nflag(rc);
-    do_zflag(rc);
-    do_cflag(ra, ~rb, 1);
-    do_vflag(ra, ~rb, 1);
-    return 0;
+    entry = profileEntry(pc - 2);
+    if(entry) entry->calls++;
   }
 
-  //SUB(4)
-  if((inst & 0xFF80) == 0xB080)
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Thumbulator::ProfileEntry* Thumbulator::profileEntry(uInt32 addr) const
+{
+  switch(addr & 0xF0000000)
   {
-    rb = inst & 0x7F;
-    rb <<= 2;
-    DO_DISS(statusMsg << "sub SP,#0x" << Base::HEX2 << rb << endl);
-    ra = read_register(13);
-    ra -= rb;
-    write_register(13, ra);
-    return 0;
+    case 0x00000000: //ROM
+      return &profile[(addr & ROMADDMASK) >> 1];
+
+    case 0x40000000: //RAM
+      return &profile[(ROMSIZE + (addr & RAMADDMASK)) >> 1];
   }
+  return nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 Thumbulator::profileAddress(uInt32 index)
+{
+  index <<= 1;
+  return index < ROMSIZE ? index : 0x40000000 + (index - ROMSIZE);
+}
 
-  //SWI
-  if((inst & 0xFF00) == 0xDF00)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::enableProfiling(bool enable)
+{
+  if(enable)
+    profile = make_unique<ProfileEntry[]>(PROFILE_SIZE);
+  else
+    profile.reset();
+
+  profileRuns = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::resetProfile()
+{
+  if(profile)
+    std::fill(profile.get(), profile.get() + PROFILE_SIZE, ProfileEntry());
+
+  profileRuns = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Thumbulator::FunctionProfileList Thumbulator::functionProfile() const
+{
+  FunctionProfileList list;
+  if(!profile)
+    return list;
+
+  // Every executed address belongs to the closest called address below it;
+  // code executed before any such address (in ROM or RAM) starts a function
+  bool inFunction = false;
+  for(uInt32 i = 0; i < PROFILE_SIZE; ++i)
   {
-    rb = inst & 0xFF;
-    DO_DISS(statusMsg << "swi 0x" << Base::HEX2 << rb << endl);
+    if(i == ROMSIZE/2)
+      inFunction = false;
 
-    if((inst & 0xFF) == 0xCC)
-    {
-      write_register(0, cpsr);
-      return 0;
-    }
-    else
+    const ProfileEntry& entry = profile[i];
+    if(entry.calls == 0 && entry.instructions == 0)
+      continue;
+
+    if(entry.calls > 0 || !inFunction)
     {
-      statusMsg << endl << endl << "swi 0x" << Base::HEX2 << rb << endl;
-      return 1;
+      list.push_back({ profileAddress(i), 0, 0, 0, 0 });
+      inFunction = true;
     }
+    FunctionProfile& function = list.back();
+    function.calls        += entry.calls;
+    function.instructions += entry.instructions;
+    function.accesses     += entry.accesses;
+    function.cycles       += entry.instructions + entry.accesses;
   }
 
-  //SXTB
-  if((inst & 0xFFC0) == 0xB240)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "sxtb r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFF;
-    if(rc & 0x80)
-      rc |= (~0u) << 8;
-    write_register(rd, rc);
-    return 0;
-  }
+  std::stable_sort(list.begin(), list.end(),
+    [](const FunctionProfile& a, const FunctionProfile& b) {
+      return a.cycles > b.cycles;
+    }
+  );
+  return list;
+}
 
-  //SXTH
-  if((inst & 0xFFC0) == 0xB200)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Thumbulator::dumpProfile(ostream& out) const
+{
+  if(!profile)
   {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "sxth r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFFFF;
-    if(rc & 0x8000)
-      rc |= (~0u) << 16;
-    write_register(rd, rc);
-    return 0;
+    out << "ARM profiling is disabled" << endl;
+    return;
   }
 
-  //TST
-  if((inst & 0xFFC0) == 0x4200)
+  using std::setw;
+  const FunctionProfileList& functions = functionProfile();
+  uInt64 instructions = 0, cycles = 0;
+  for(const auto& f: functions)
   {
-    rn = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "tst r" << dec << rn << ",r" << dec << rm << endl);
-    ra = read_register(rn);
-    rb = read_register(rm);
-    rc = ra & rb;
-    do_nflag(rc);
-    do_zflag(rc);
-    return 0;
+    instructions += f.instructions;
+    cycles += f.cycles;
   }
 
-  //UXTB
-  if((inst & 0xFFC0) == 0xB2C0)
-  {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "uxtb r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFF;
-    write_register(rd, rc);
-    return 0;
-  }
+  out << "ARM profile of " << profileRuns << " calls from the 6507: "
+      << instructions << " instructions, " << cycles << " cycles (estimated)"
+      << endl << endl
+      << "Function           Calls  Instructions      Accesses        Cycles       %"
+      << endl;
+  for(const auto& f: functions)
+    out << Base::HEX8 << f.address << std::dec << std::setfill(' ')
+        << setw(15) << f.calls << setw(14) << f.instructions
+        << setw(14) << f.accesses << setw(14) << f.cycles
+        << setw(7) << std::fixed << std::setprecision(1)
+        << (cycles ? 100.0 * f.cycles / cycles : 0.0) << endl;
 
-  //UXTH
-  if((inst & 0xFFC0) == 0xB280)
+  out << endl
+      << "Address     Instructions      Accesses        Cycles" << endl;
+  for(uInt32 i = 0; i < PROFILE_SIZE; ++i)
   {
-    rd = (inst >> 0) & 0x7;
-    rm = (inst >> 3) & 0x7;
-    DO_DISS(statusMsg << "uxth r" << dec << rd << ",r" << dec << rm << endl);
-    ra = read_register(rm);
-    rc = ra & 0xFFFF;
-    write_register(rd, rc);
-    return 0;
+    const ProfileEntry& entry = profile[i];
+    if(entry.instructions > 0)
+      out << Base::HEX8 << profileAddress(i) << std::dec << std::setfill(' ')
+          << setw(17) << entry.instructions << setw(14) << entry.accesses
+          << setw(14) << (entry.instructions + entry.accesses) << endl;
   }
-
-  statusMsg << "invalid instruction " << Base::HEX8 << pc << " " << Base::HEX4 << inst << endl;
-  return 1;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2356,6 +2727,3 @@ int Thumbulator::reset()
 
   return 0;
 }
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool Thumbulator::trapOnFatal = true;
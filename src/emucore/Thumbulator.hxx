@@ -86,7 +86,7 @@ class Thumbulator
 
       @param enable  Enable (the default) or disable exceptions on fatal errors
     */
-    static void trapFatalErrors(bool enable) { trapOnFatal = enable; }
+    void trapFatalErrors(bool enable) { trapOnFatal = enable; }
 
     /**
       Inform the Thumbulator class about the console currently in use,
@@ -95,7 +95,118 @@ class Thumbulator
     */
     void setConsoleTiming(ConsoleTiming timing);
 
+    /**
+      Decode the ROM image again.  Instructions in ROM are decoded only once,
+      so this must be called whenever the ROM contents are changed (ie, by
+      patching them from the debugger).
+    */
+    void invalidateROMCache();
+
+    /**
+      Execution profile of one ARM function, which is the range of code
+      starting at an address which was called (by BL or BLX, or as the
+      entry point from the 6507), up to the next such address.
+    */
+    struct FunctionProfile
+    {
+      uInt32 address;       // address of the first instruction
+      uInt64 calls;         // number of times the function was entered
+      uInt64 instructions;  // number of instructions executed
+      uInt64 accesses;      // number of memory reads and writes
+      uInt64 cycles;        // estimated cycles, see below
+    };
+    using FunctionProfileList = vector<FunctionProfile>;
+
+    /**
+      Enable or disable collecting an execution profile of the ARM code.
+      While enabled, executed instructions and memory accesses are counted
+      for every instruction address.  Cycles are estimated as the sum of
+      instruction fetches and memory accesses, since wait states aren't
+      emulated.
+
+      @param enable  Start (and reset) or stop collecting the profile
+    */
+    void enableProfiling(bool enable);
+    bool isProfiling() const { return profile != nullptr; }
+
+    /**
+      Clear all counts collected so far.
+    */
+    void resetProfile();
+
+    /**
+      Aggregate the counts collected so far into functions.
+
+      @return  The executed functions, sorted by cycles (highest first)
+    */
+    FunctionProfileList functionProfile() const;
+
+    /**
+      Write a report of the profile to the given stream: the totals, the
+      functions and every executed instruction address.
+    */
+    void dumpProfile(ostream& out) const;
+
   private:
+    // Every Thumb instruction the emulation knows about; instruction words
+    // are translated to these once, and then dispatched directly
+    enum class Op : uInt8 {
+      invalid,
+      undecoded,  // RAM contents have changed, must be decoded again
+      adc, add1, add2, add3, add4, add5, add6, add7, and_, asr1, asr2,
+      b1, b2, bic, bkpt, bl, blx2, bx, cmn, cmp1, cmp2, cmp3, cps, cpy,
+      eor, ldmia, ldr1, ldr2, ldr3, ldr4, ldrb1, ldrb2, ldrh1, ldrh2,
+      ldrsb, ldrsh, lsl1, lsl2, lsr1, lsr2, mov1, mov2, mov3, mul, mvn,
+      neg, orr, pop, push, rev, rev16, revsh, ror, sbc, setend, stmia,
+      str1, str2, str3, strb1, strb2, strh1, strh2, sub1, sub2, sub3,
+      sub4, swi, sxtb, sxth, tst, uxtb, uxth
+    };
+
+    /**
+      Structure used to specify direct access to a page of ROM or RAM
+    */
+    struct PageAccess
+    {
+      /**
+        Pointer to the memory of this page, or the null pointer.  The null
+        pointer indicates that reads have to go through the checks (and the
+        memory mapped registers) in read16() and read32().
+      */
+      const uInt16* directReadBase;
+
+      /**
+        Pointer to the memory of this page, or the null pointer.  The null
+        pointer indicates that writes have to go through the checks in
+        write16() and write32(); this is the case for ROM, and for any RAM
+        page containing a protected driver area.
+      */
+      uInt16* directWriteBase;
+
+      PageAccess() : directReadBase(nullptr), directWriteBase(nullptr) { }
+    };
+
+    // The direct access pages cover ROM (0x00000000 - 0x00007FFF) and
+    // RAM (0x40000000 - 0x40007FFF, of which only the first 8K exist)
+    enum {
+      PAGE_SHIFT = 8,
+      PAGE_MASK  = (1 << PAGE_SHIFT) - 1,
+      PAGE_COUNT = (2 * ROMSIZE) >> PAGE_SHIFT
+    };
+    // Bits which must be clear in a paged address
+    static constexpr uInt32 UNPAGED_BITS = 0xBFFF8000;
+
+  private:
+    static Op decodeInstructionWord(uInt32 inst);
+
+    /**
+      Set up the direct access pages for the ROM and RAM, based on the
+      driver areas which are protected for the current configuration.
+    */
+    void mapMemory();
+    static uInt32 pageIndex(uInt32 addr) {
+      return ((addr >> 30) << (15 - PAGE_SHIFT)) | ((addr & ROMADDMASK) >> PAGE_SHIFT);
+    }
+
     uInt32 read_register(uInt32 reg);
     void write_register(uInt32 reg, uInt32 data);
     uInt32 fetch16(uInt32 addr);
@@ -123,12 +234,34 @@ class Thumbulator
     void dump_counters();
     void dump_regs();
     int execute();
+    int executeProfiled();
     int reset();
 
   private:
     const uInt16* rom;
     uInt16* ram;
 
+    // Decoded instruction for every halfword in ROM and RAM; writes to RAM
+    // mark the affected entry as undecoded
+    Op decodedRom[ROMSIZE/2];
+    Op decodedRam[RAMSIZE/2];
+
+    PageAccess pageAccess[PAGE_COUNT];
+
+    // Execution profile per instruction address; the first ROMSIZE/2
+    // entries are ROM, followed by RAMSIZE/2 entries for RAM
+    struct ProfileEntry
+    {
+      uInt64 calls, instructions, accesses;
+      ProfileEntry() : calls(0), instructions(0), accesses(0) { }
+    };
+    enum { PROFILE_SIZE = (ROMSIZE + RAMSIZE) / 2 };
+    unique_ptr<ProfileEntry[]> profile;
+    uInt64 profileRuns;
+
+    ProfileEntry* profileEntry(uInt32 addr) const;
+    static uInt32 profileAddress(uInt32 index);
+
     uInt32 reg_norm[16]; // normal execution mode, do not have a thread mode
     uInt32 cpsr, mamcr;
     bool handler_mode;
@@ -144,7 +277,7 @@ class Thumbulator
 
     ostringstream statusMsg;
 
-    static bool trapOnFatal;
+    bool trapOnFatal;
 
     ConfigureFor configuration;
 
@@ -3,6 +3,7 @@ MODULE := src/emucore
 MODULE_OBJS := \
 	src/emucore/AtariVox.o \
 	src/emucore/Booster.o \
+	src/emucore/BSTypeCache.o \
 	src/emucore/Cart.o \
 	src/emucore/CartDetector.o \
 	src/emucore/Cart0840.o \
@@ -71,6 +72,7 @@ MODULE_OBJS := \
 	src/emucore/PointingDevice.o \
 	src/emucore/Props.o \
 	src/emucore/PropsSet.o \
+	src/emucore/RomIndex.o \
 	src/emucore/SaveKey.o \
 	src/emucore/Serializer.o \
 	src/emucore/Settings.o \
@@ -43,6 +43,18 @@ class DelayQueue : public Serializable
 
     template<class T> void execute(T executor);
 
+    /**
+      Answer the number of clocks (at most 'limit') that pass before the
+      next pending write is executed.
+    */
+    uInt32 idleClocks(uInt32 limit) const;
+
+    /**
+      Advance the queue by the given number of clocks without executing
+      anything; only valid for spans reported by idleClocks().
+    */
+    void skip(uInt32 clocks);
+
     /**
       Serializable methods (see that class for more information).
     */
@@ -120,6 +132,23 @@ void DelayQueue<length, capacity>::execute(T executor)
   myIndex = smartmod<length>(myIndex + 1);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<unsigned length, unsigned capacity>
+uInt32 DelayQueue<length, capacity>::idleClocks(uInt32 limit) const
+{
+  for (uInt8 i = 0; i < length && i < limit; i++)
+    if (myMembers[smartmod<length>(myIndex + i)].mySize > 0) return i;
+
+  return limit;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<unsigned length, unsigned capacity>
+void DelayQueue<length, capacity>::skip(uInt32 clocks)
+{
+  myIndex = (myIndex + clocks) % length;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<unsigned length, unsigned capacity>
 bool DelayQueue<length, capacity>::save(Serializer& out) const
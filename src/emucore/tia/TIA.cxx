@@ -23,6 +23,7 @@
 #include "DelayQueueIteratorImpl.hxx"
 #include "TIAConstants.hxx"
 #include "frame-manager/FrameManager.hxx"
+#include "BenchmarkTimer.hxx"
 
 #ifdef DEBUGGER_SUPPORT
   #include "CartDebug.hxx"
@@ -93,6 +94,8 @@ TIA::TIA(Console& console, Sound& sound, Settings& settings)
   myEnableJitter = mySettings.getBool(devSettings ? "dev.tv.jitter" : "plr.tv.jitter");
   myJitterFactor = mySettings.getInt(devSettings ? "dev.tv.jitter_recovery" : "plr.tv.jitter_recovery");
 
+  setupPriorityEncoder();
+
   reset();
 }
 
@@ -1168,8 +1171,24 @@ void TIA::onHalt()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::cycle(uInt32 colorClocks)
 {
-  for (uInt32 i = 0; i < colorClocks; i++)
+  BenchmarkTimer::Scope timer(BenchmarkTimer::TIA);
+
+  while (colorClocks > 0)
   {
+    // No register changes until the delay queue fires its next write, so the
+    // clocks up to that point (or the end of the line) can be batched
+    const uInt32 idle =
+      myDelayQueue.idleClocks(std::min(colorClocks, 228u - myHctr));
+
+    if (idle > 0) {
+      const uInt32 clocks = cycleSpan(idle);
+
+      if (clocks > 0) {
+        colorClocks -= clocks;
+        continue;
+      }
+    }
+
     myDelayQueue.execute(
       [this] (uInt8 address, uInt8 value) {delayedWrite(address, value);}
     );
@@ -1191,9 +1210,46 @@ void TIA::cycle(uInt32 colorClocks)
       nextLine();
 
     myTimestamp++;
+    colorClocks--;
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uInt32 TIA::cycleSpan(uInt32 clocks)
+{
+  if (myLinesSinceChange < 2) {
+    if (myMovementInProgress) return 0;
+
+    if (myHstate == HState::blank) {
+      // tickHblank only has an effect on clocks 0, 67 and 75
+      if (myHctr == 0 || myHctr == 67 || myHctr == 75) return 0;
+
+      const uInt32 boundary = myHctr < 67 ? 67 : (myHctr < 75 ? 75 : 228);
+      clocks = std::min(clocks, boundary - myHctr);
+
+      myCollisionUpdateRequired = false;
+      myHctr += clocks;
+    }
+    else {
+      tickHframeSpan(clocks);
+      myHctr += clocks;
+    }
+  }
+  else {
+    // Line cache is active: objects are not ticked, the line is cloned
+    myCollisionUpdateRequired = false;
+    myHctr += clocks;
+  }
+
+  myDelayQueue.skip(clocks);
+  myTimestamp += clocks;
+
+  if (myHctr >= 228)
+    nextLine();
+
+  return clocks;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::tickMovement()
 {
@@ -1254,6 +1310,86 @@ void TIA::tickHframe()
     renderPixel(x, y);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::tickHframeSpan(uInt32 clocks)
+{
+  // Within the span no registers change and the objects don't interact, so
+  // each object can be run over the whole span on its own
+  uInt8 objects[228], pfColors[228];
+  uInt32 collisions[228];
+  const uInt32 x0 = myHctr - 68 - myHctrDelta;
+  uInt32 i;
+
+  myCollisionUpdateRequired = true;
+
+  for (i = 0; i < clocks; i++) {
+    myPlayfield.tick(x0 + i);
+    objects[i] = myPlayfield.isOn() << FixedObject::PF;
+    pfColors[i] = myPlayfield.getColor();
+    collisions[i] = myPlayfield.collision;
+  }
+  for (i = 0; i < clocks; i++) {
+    myMissile0.tick(myHctr + i);
+    objects[i] |= myMissile0.isOn() << FixedObject::M0;
+    collisions[i] &= myMissile0.collision;
+  }
+  for (i = 0; i < clocks; i++) {
+    myMissile1.tick(myHctr + i);
+    objects[i] |= myMissile1.isOn() << FixedObject::M1;
+    collisions[i] &= myMissile1.collision;
+  }
+  for (i = 0; i < clocks; i++) {
+    myPlayer0.tick();
+    objects[i] |= myPlayer0.isOn() << FixedObject::P0;
+    collisions[i] &= myPlayer0.collision;
+  }
+  for (i = 0; i < clocks; i++) {
+    myPlayer1.tick();
+    objects[i] |= myPlayer1.isOn() << FixedObject::P1;
+    collisions[i] &= myPlayer1.collision;
+  }
+  for (i = 0; i < clocks; i++) {
+    myBall.tick();
+    objects[i] |= myBall.isOn() << FixedObject::BL;
+    collisions[i] &= myBall.collision;
+  }
+
+  const bool vblank = myFrameManager->vblank();
+
+  if (!vblank) {
+    uInt32 collisionMask = 0;
+    for (i = 0; i < clocks; i++)
+      collisionMask |= collisions[i];
+
+    myCollisionMask |= collisionMask;
+  }
+
+  if (!myFrameManager->isRendering()) return;
+
+  uInt8* line = myFramebuffer + myFrameManager->getY() * 160;
+
+  if (vblank) {
+    for (i = 0; i < clocks; i++)
+      if (x0 + i < 160) line[x0 + i] = 0;
+
+    return;
+  }
+
+  const uInt8* encoder = myPriorityEncoder[myPriority];
+  uInt8 colors[7] = {
+    myPlayer0.getColor(), myMissile0.getColor(),
+    myPlayer1.getColor(), myMissile1.getColor(),
+    0, myBall.getColor(), myBackground.getColor()
+  };
+
+  for (i = 0; i < clocks; i++) {
+    if (x0 + i >= 160) continue;
+
+    colors[FixedObject::PF] = pfColors[i];
+    line[x0 + i] = colors[encoder[objects[i]]];
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::applyRsync()
 {
@@ -1370,6 +1506,30 @@ void TIA::renderPixel(uInt32 x, uInt32 y)
   myFramebuffer[y * 160 + x] = color;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TIA::setupPriorityEncoder()
+{
+  // Same priority orderings as in renderPixel, highest first
+  static constexpr uInt8 order[3][6] = {
+    { PF, BL, P0, M0, P1, M1 },  // pfp
+    { P0, M0, PF, P1, M1, BL },  // score
+    { P0, M0, P1, M1, PF, BL }   // normal
+  };
+
+  for (uInt8 priority = 0; priority < 3; priority++)
+    for (uInt8 objects = 0; objects < 64; objects++) {
+      uInt8 object = 6;  // background
+
+      for (uInt8 i = 0; i < 6; i++)
+        if (objects & (1 << order[priority][i])) {
+          object = order[priority][i];
+          break;
+        }
+
+      myPriorityEncoder[priority][objects] = object;
+    }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TIA::flushLineCache()
 {
@@ -490,6 +490,13 @@ class TIA : public Device
      */
     void cycle(uInt32 colorClocks);
 
+    /**
+     * Execute a span of up to 'clocks' color clocks during which no delayed
+     * writes are due and the current line does not end. Returns the number
+     * of clocks actually processed, or 0 if the span must be single-stepped.
+     */
+    uInt32 cycleSpan(uInt32 clocks);
+
     /**
      * Advance the movement logic by a single clock.
      */
@@ -505,6 +512,14 @@ class TIA : public Device
      */
     void tickHframe();
 
+    /**
+     * Advance a span of clocks during the visible part of the scanline. The
+     * span must not contain delayed writes or object movement. Each object is
+     * ticked over the whole span, and the line is then composed from the
+     * resulting object masks.
+     */
+    void tickHframeSpan(uInt32 clocks);
+
     /**
      * Execute a RSYNC.
      */
@@ -520,6 +535,11 @@ class TIA : public Device
      */
     void renderPixel(uInt32 x, uInt32 y);
 
+    /**
+     * Fill the priority encoder lookup table (see myPriorityEncoder).
+     */
+    void setupPriorityEncoder();
+
     /**
      * Clear the first 8 pixels of a scanline with black if we are in hblank
      * (called during HMOVE).
@@ -718,6 +738,13 @@ class TIA : public Device
      */
     Priority myPriority;
 
+    /**
+     * Lookup table for the priority encoder. For each priority mode, maps the
+     * set of objects that are on at a pixel (one bit per FixedObject) to the
+     * object which determines the color (background is 6).
+     */
+    uInt8 myPriorityEncoder[3][64];
+
     /**
      * The index of the last CPU cycle that was included in the simulation.
      */
@@ -260,6 +260,18 @@ void Dialog::addSurface(shared_ptr<FBSurface> surface)
   mySurfaceStack.push(surface);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Dialog::tick()
+{
+  // Give all widgets a chance to do any periodic processing
+  Widget* w = _firstWidget;
+  while(w)
+  {
+    w->tick();
+    w = w->_next;
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Dialog::drawDialog()
 {
@@ -56,6 +56,7 @@ class Dialog : public GuiObject
 
     virtual void center();
     virtual void drawDialog();
+    virtual void tick();
     virtual void loadConfig()  { }
     virtual void saveConfig()  { }
     virtual void setDefaults() { }
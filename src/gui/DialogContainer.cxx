@@ -57,6 +57,9 @@ void DialogContainer::updateTime(uInt64 time)
   // Check for pending continuous events and send them to the active dialog box
   Dialog* activeDialog = myDialogStack.top();
 
+  // Let the active dialog do any periodic processing
+  activeDialog->tick();
+
   // Key still pressed
   if(myCurrentKeyDown.keycode != 0 && myKeyRepeatTime < myTime)
   {
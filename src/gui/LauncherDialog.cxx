@@ -23,7 +23,6 @@
 #include "EditTextWidget.hxx"
 #include "FSNode.hxx"
 #include "GameList.hxx"
-#include "MD5.hxx"
 #include "OptionsDialog.hxx"
 #include "GlobalPropsDialog.hxx"
 #include "LauncherFilterDialog.hxx"
@@ -34,6 +33,7 @@
 #include "StellaKeys.hxx"
 #include "Props.hxx"
 #include "PropsSet.hxx"
+#include "RomIndex.hxx"
 #include "RomInfoWidget.hxx"
 #include "Settings.hxx"
 #include "StringListWidget.hxx"
@@ -201,8 +201,9 @@ const string& LauncherDialog::selectedRomMD5()
     return EmptyString;
 
   // Make sure we have a valid md5 for this ROM
-  if(myGameList->md5(item) == "")
-    myGameList->setMd5(item, MD5::hash(node));
+  RomIndex::Entry entry;
+  if(myGameList->md5(item) == "" && instance().romIndex().find(node, entry))
+    myGameList->setMd5(item, entry.md5);
 
   return myGameList->md5(item);
 }
@@ -299,6 +300,9 @@ void LauncherDialog::loadDirListing()
     myGameList->appendGame(" [..]", "", "", true);
 
   // Now add the directory entries
+  // ROM files are also indexed in the background, so their information
+  // is usually available by the time they're selected
+  FSList roms;
   bool domatch = myPattern && myPattern->getText() != "";
   for(const auto& f: files)
   {
@@ -321,7 +325,12 @@ void LauncherDialog::loadDirListing()
       continue;
 
     myGameList->appendGame(name, f.getPath(), "", isDir);
+
+    string extension;
+    if(!isDir && LauncherFilterDialog::isValidRomName(f, extension))
+      roms.push_back(f);
   }
+  instance().romIndex().scan(roms);
 
   // Sort the list by rom name (since that's what we see in the listview)
   myGameList->sortByName();
@@ -339,19 +348,55 @@ void LauncherDialog::loadRomInfo()
   if(!node.isDirectory() && LauncherFilterDialog::isValidRomName(node, extension))
   {
     // Make sure we have a valid md5 for this ROM
-    if(myGameList->md5(item) == "")
-      myGameList->setMd5(item, MD5::hash(node));
+    // The index usually has it already, so the file isn't read again
+    RomIndex::Entry entry;
+    bool indexed = instance().romIndex().find(node, entry);
+    if(indexed)
+      myGameList->setMd5(item, entry.md5);
 
     // Get the properties for this entry
     Properties props;
     instance().propSet().getMD5WithInsert(node, myGameList->md5(item), props);
 
+    // Show what was autodetected, unless the properties specify otherwise
+    if(indexed && props.get(Cartridge_Type) == "AUTO")
+      props.set(Cartridge_Type, Bankswitch::typeToName(entry.type) + "*");
+    if(indexed && props.get(Display_Format) == "AUTO" && entry.format != "")
+      props.set(Display_Format, entry.format);
+
     myRomInfoWidget->setProperties(props);
+    prefetchSnapshots(item);
   }
   else
     myRomInfoWidget->clearProperties();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LauncherDialog::prefetchSnapshots(int item)
+{
+  // The neighbouring ROMs are the most likely to be selected next
+  // Only those already indexed are considered, since the point is to
+  // avoid waiting for I/O
+  StringList names;
+  for(int i: { item + 1, item - 1, item + 2, item - 2 })
+  {
+    if(i < 0 || uInt32(i) >= myGameList->size() || myGameList->isDir(i))
+      continue;
+
+    const FilesystemNode node(myGameList->path(i));
+    RomIndex::Entry entry;
+    if(!instance().romIndex().find(node, entry, false))
+      continue;
+
+    Properties props;
+    if(instance().propSet().getMD5(entry.md5, props))
+      names.push_back(props.get(Cartridge_Name));
+    else
+      names.push_back(node.getNameWithExt(""));
+  }
+  myRomInfoWidget->prefetchSnapshots(names);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void LauncherDialog::handleContextMenu()
 {
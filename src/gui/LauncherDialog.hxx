@@ -87,6 +87,7 @@ class LauncherDialog : public Dialog
 
     void loadDirListing();
     void loadRomInfo();
+    void prefetchSnapshots(int item);
     void handleContextMenu();
     void setListFilters();
     bool matchPattern(const string& s, const string& pattern) const;
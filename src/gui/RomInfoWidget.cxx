@@ -25,6 +25,7 @@
 #include "Props.hxx"
 #include "PNGLibrary.hxx"
 #include "Rect.hxx"
+#include "SnapshotLoader.hxx"
 #include "Widget.hxx"
 #include "TIAConstants.hxx"
 #include "RomInfoWidget.hxx"
@@ -33,6 +34,7 @@
 RomInfoWidget::RomInfoWidget(GuiObject* boss, const GUI::Font& font,
                              int x, int y, int w, int h)
   : Widget(boss, font, x, y, w, h),
+    mySnapshotPending(false),
     mySurfaceIsValid(false),
     myHaveProperties(false),
     myAvail(w > 400 ? GUI::Size(640, TIAConstants::maxViewableHeight*2) :
@@ -40,6 +42,14 @@ RomInfoWidget::RomInfoWidget(GuiObject* boss, const GUI::Font& font,
 {
   _flags = WIDGET_ENABLED;
   _bgcolor = _bgcolorhi = kWidColor;
+
+  // Keep enough snapshots to quickly scroll back and forth a few pages
+  mySnapshotLoader = make_unique<SnapshotLoader>(32);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+RomInfoWidget::~RomInfoWidget()
+{
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -48,10 +58,30 @@ void RomInfoWidget::loadConfig()
   // The ROM may have changed since we were last in the browser, either
   // by saving a different image or through a change in video renderer,
   // so we reload the properties
+  // Any cached snapshots may have been overwritten in the meantime too
+  mySnapshotLoader->clear();
   if(myHaveProperties)
     parseProperties();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoWidget::tick()
+{
+  // Show the snapshot as soon as it has been decoded
+  if(mySnapshotPending && loadSnapshot())
+    mySnapshotPending = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void RomInfoWidget::prefetchSnapshots(const StringList& names)
+{
+  StringList filenames;
+  for(const auto& name: names)
+    filenames.push_back(instance().snapshotLoadDir() + name + ".png");
+
+  mySnapshotLoader->prefetch(filenames);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomInfoWidget::setProperties(const Properties& props)
 {
@@ -66,7 +96,7 @@ void RomInfoWidget::setProperties(const Properties& props)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomInfoWidget::clearProperties()
 {
-  myHaveProperties = mySurfaceIsValid = false;
+  myHaveProperties = mySurfaceIsValid = mySnapshotPending = false;
   if(mySurface)
     mySurface->setVisible(mySurfaceIsValid);
 
@@ -92,30 +122,21 @@ void RomInfoWidget::parseProperties()
 
   // Initialize to empty properties entry
   mySurfaceErrorMsg = "";
-  mySurfaceIsValid = true;
+  mySurfaceIsValid = false;
   myRomInfo.clear();
 
   // Get a valid filename representing a snapshot file for this rom
-  const string& filename = instance().snapshotLoadDir() +
+  mySnapshotFile = instance().snapshotLoadDir() +
       myProperties.get(Cartridge_Name) + ".png";
 
-  // Read the PNG file
-  try
+  // Unless the snapshot is already cached, it's decoded in the background
+  // and shown once it's available
+  mySnapshotPending = !loadSnapshot();
+  if(mySnapshotPending)
   {
-    instance().png().loadImage(filename, *mySurface);
-
-    // Scale surface to available image area
-    const GUI::Rect& src = mySurface->srcRect();
-    float scale = std::min(float(myAvail.w) / src.width(), float(myAvail.h) / src.height());
-    mySurface->setDstSize(uInt32(src.width() * scale), uInt32(src.height() * scale));
+    mySnapshotLoader->request(mySnapshotFile);
+    mySurface->setVisible(false);
   }
-  catch(const runtime_error& e)
-  {
-    mySurfaceIsValid = false;
-    mySurfaceErrorMsg = e.what();
-  }
-  if(mySurface)
-    mySurface->setVisible(mySurfaceIsValid);
 
   // Now add some info for the message box below the image
   myRomInfo.push_back("Name:  " + myProperties.get(Cartridge_Name));
@@ -123,6 +144,8 @@ void RomInfoWidget::parseProperties()
   myRomInfo.push_back("Model:  " + myProperties.get(Cartridge_ModelNo));
   myRomInfo.push_back("Rarity:  " + myProperties.get(Cartridge_Rarity));
   myRomInfo.push_back("Note:  " + myProperties.get(Cartridge_Note));
+  myRomInfo.push_back("Type:  " + myProperties.get(Cartridge_Type) +
+                      "    Format:  " + myProperties.get(Display_Format));
   bool swappedPorts = myProperties.get(Console_SwapPorts) == "YES";
   myRomInfo.push_back("Controllers:  " + (!swappedPorts
     ? myProperties.get(Controller_Left) + " (left), " + myProperties.get(Controller_Right) + " (right)"
@@ -135,6 +158,34 @@ void RomInfoWidget::parseProperties()
   setDirty();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool RomInfoWidget::loadSnapshot()
+{
+  auto snapshot = mySnapshotLoader->get(mySnapshotFile);
+  if(!snapshot)
+    return false;
+
+  if(snapshot->error == "")
+  {
+    instance().png().loadImage(snapshot->image, *mySurface);
+
+    // Scale surface to available image area
+    const GUI::Rect& src = mySurface->srcRect();
+    float scale = std::min(float(myAvail.w) / src.width(), float(myAvail.h) / src.height());
+    mySurface->setDstSize(uInt32(src.width() * scale), uInt32(src.height() * scale));
+    mySurfaceIsValid = true;
+  }
+  else
+  {
+    mySurfaceIsValid = false;
+    mySurfaceErrorMsg = snapshot->error;
+  }
+  mySurface->setVisible(mySurfaceIsValid);
+
+  setDirty();
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RomInfoWidget::drawWidget(bool hilite)
 {
@@ -20,6 +20,7 @@
 
 class FBSurface;
 class Properties;
+class SnapshotLoader;
 namespace GUI {
   struct Size;
 }
@@ -32,22 +33,39 @@ class RomInfoWidget : public Widget
   public:
     RomInfoWidget(GuiObject *boss, const GUI::Font& font,
                   int x, int y, int w, int h);
-    virtual ~RomInfoWidget() = default;
+    virtual ~RomInfoWidget();
 
     void setProperties(const Properties& props);
     void clearProperties();
     void loadConfig() override;
+    void tick() override;
+
+    /**
+      Start decoding the snapshots for the given ROMs in the background,
+      since they're likely to be shown soon.
+
+      @param names  The names of the ROMs, as used for their snapshots
+    */
+    void prefetchSnapshots(const StringList& names);
 
   protected:
     void drawWidget(bool hilite) override;
 
   private:
     void parseProperties();
+    bool loadSnapshot();
 
   private:
     // Surface pointer holding the PNG image
     shared_ptr<FBSurface> mySurface;
 
+    // Decodes snapshots in the background, and caches the results
+    unique_ptr<SnapshotLoader> mySnapshotLoader;
+
+    // The snapshot for the current ROM, and whether it's still being decoded
+    string mySnapshotFile;
+    bool mySnapshotPending;
+
     // Whether the surface should be redrawn by drawWidget()
     bool mySurfaceIsValid;
 
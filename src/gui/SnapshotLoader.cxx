@@ -0,0 +1,142 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#include <algorithm>
+
+#include "SnapshotLoader.hxx"
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SnapshotLoader::SnapshotLoader(uInt32 capacity)
+  : myCapacity(capacity),
+    myGeneration(0),
+    myQuit(false)
+{
+  myThread = std::thread([this] { run(); });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SnapshotLoader::~SnapshotLoader()
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQuit = true;
+  }
+  myCondition.notify_one();
+  myThread.join();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SnapshotLoader::SnapshotPtr SnapshotLoader::get(const string& filename)
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+
+  auto i = myCache.find(filename);
+  if(i == myCache.end())
+    return nullptr;
+
+  // Mark as the most recently used one
+  myLRU.splice(myLRU.begin(), myLRU, i->second.second);
+  return i->second.first;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotLoader::request(const string& filename)
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    myQueue.clear();
+    if(myCache.find(filename) == myCache.end())
+      myQueue.push_back(filename);
+  }
+  myCondition.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotLoader::prefetch(const StringList& filenames)
+{
+  {
+    std::lock_guard<std::mutex> lock(myMutex);
+    for(const auto& f: filenames)
+      if(myCache.find(f) == myCache.end() &&
+         std::find(myQueue.begin(), myQueue.end(), f) == myQueue.end())
+        myQueue.push_back(f);
+  }
+  myCondition.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotLoader::clear()
+{
+  std::lock_guard<std::mutex> lock(myMutex);
+  myCache.clear();
+  myLRU.clear();
+  myQueue.clear();
+  ++myGeneration;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotLoader::run()
+{
+  std::unique_lock<std::mutex> lock(myMutex);
+  for(;;)
+  {
+    myCondition.wait(lock, [this] { return myQuit || !myQueue.empty(); });
+    if(myQuit)
+      break;
+
+    const string filename = myQueue.front();
+    myQueue.pop_front();
+    uInt32 generation = myGeneration;
+
+    // The decoding itself is done without holding the lock
+    lock.unlock();
+    auto snapshot = make_shared<Snapshot>();
+    try
+    {
+      PNGLibrary::readImage(filename, snapshot->image);
+    }
+    catch(const runtime_error& e)
+    {
+      snapshot->error = e.what();
+    }
+    lock.lock();
+
+    if(generation == myGeneration)
+      insert(filename, snapshot);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SnapshotLoader::insert(const string& filename, SnapshotPtr snapshot)
+{
+  auto i = myCache.find(filename);
+  if(i != myCache.end())
+  {
+    i->second.first = snapshot;
+    myLRU.splice(myLRU.begin(), myLRU, i->second.second);
+    return;
+  }
+
+  // Make room by dropping the least recently used snapshot
+  if(myCache.size() >= myCapacity)
+  {
+    myCache.erase(myLRU.back());
+    myLRU.pop_back();
+  }
+  myLRU.push_front(filename);
+  myCache.emplace(filename, std::make_pair(snapshot, myLRU.begin()));
+}
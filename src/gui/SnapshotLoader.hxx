@@ -0,0 +1,126 @@
+//============================================================================
+//
+//   SSSS    tt          lll  lll
+//  SS  SS   tt           ll   ll
+//  SS     tttttt  eeee   ll   ll   aaaa
+//   SSSS    tt   ee  ee  ll   ll      aa
+//      SS   tt   eeeeee  ll   ll   aaaaa  --  "An Atari 2600 VCS Emulator"
+//  SS  SS   tt   ee      ll   ll  aa  aa
+//   SSSS     ttt  eeeee llll llll  aaaaa
+//
+// Copyright (c) 1995-2018 by Bradford W. Mott, Stephen Anthony
+// and the Stella Team
+//
+// See the file "License.txt" for information on usage and redistribution of
+// this file, and for a DISCLAIMER OF ALL WARRANTIES.
+//============================================================================
+
+#ifndef SNAPSHOT_LOADER_HXX
+#define SNAPSHOT_LOADER_HXX
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include "bspf.hxx"
+#include "PNGLibrary.hxx"
+
+/**
+  This class decodes ROM snapshot images in a background thread, and
+  keeps the most recently used ones in a cache of limited size.  It only
+  deals with decoded image data; loading it into a surface must still be
+  done from the main thread.
+
+  Failures to load an image are cached as well, so that a missing
+  snapshot doesn't cause repeated attempts to read it.
+*/
+class SnapshotLoader
+{
+  public:
+    struct Snapshot
+    {
+      PNGLibrary::ImageData image;
+      string error;  // empty if the image was decoded successfully
+    };
+    using SnapshotPtr = shared_ptr<const Snapshot>;
+
+  public:
+    /**
+      Create a loader which caches the given number of snapshots.
+    */
+    SnapshotLoader(uInt32 capacity);
+    ~SnapshotLoader();
+
+  public:
+    /**
+      Get the snapshot for the given file, if it has been decoded.
+
+      @param filename  The filename of the PNG image
+
+      @return  The snapshot, or nullptr if it isn't available (yet)
+    */
+    SnapshotPtr get(const string& filename);
+
+    /**
+      Decode the given file as soon as possible.  Any requests still
+      pending are discarded, since they're no longer of interest.
+
+      @param filename  The filename of the PNG image
+    */
+    void request(const string& filename);
+
+    /**
+      Decode the given files after any already requested ones, so that
+      they're available when needed later.
+
+      @param filenames  The filenames of the PNG images
+    */
+    void prefetch(const StringList& filenames);
+
+    /**
+      Discard all cached snapshots, since the files may have changed.
+    */
+    void clear();
+
+  private:
+    void run();
+
+    // Add the snapshot to the cache, as the most recently used one
+    // Must be called with the mutex held
+    void insert(const string& filename, SnapshotPtr snapshot);
+
+  private:
+    uInt32 myCapacity;
+
+    // Filenames in order of use (most recent first), and the cached
+    // snapshot for each of them
+    using LRUList = std::list<string>;
+    LRUList myLRU;
+    std::map<string, std::pair<SnapshotPtr, LRUList::iterator>> myCache;
+
+    // Filenames waiting to be decoded
+    std::deque<string> myQueue;
+
+    // Incremented whenever the cache is cleared, so that results from
+    // before that time are dropped
+    uInt32 myGeneration;
+
+    bool myQuit;
+
+    std::mutex myMutex;
+    std::condition_variable myCondition;
+    std::thread myThread;
+
+  private:
+    // Following constructors and assignment operators not supported
+    SnapshotLoader() = delete;
+    SnapshotLoader(const SnapshotLoader&) = delete;
+    SnapshotLoader(SnapshotLoader&&) = delete;
+    SnapshotLoader& operator=(const SnapshotLoader&) = delete;
+    SnapshotLoader& operator=(SnapshotLoader&&) = delete;
+};
+
+#endif
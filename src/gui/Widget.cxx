@@ -132,6 +132,18 @@ void Widget::draw()
   s.setDirty();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Widget::tick()
+{
+  // Pass the tick on to any child widgets
+  Widget* w = _firstWidget;
+  while(w)
+  {
+    w->tick();
+    w = w->_next;
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void Widget::receivedFocus()
 {
@@ -82,6 +82,7 @@ class Widget : public GuiObject
     virtual bool handleEvent(Event::Type event) { return false; }
 
     void draw() override;
+    virtual void tick();
     void receivedFocus();
     void lostFocus();
     void addFocusWidget(Widget* w) override { _focusList.push_back(w); }
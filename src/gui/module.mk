@@ -41,6 +41,7 @@ MODULE_OBJS := \
 	src/gui/RomInfoWidget.o \
 	src/gui/ScrollBarWidget.o \
 	src/gui/SnapshotDialog.o \
+	src/gui/SnapshotLoader.o \
 	src/gui/StringListWidget.o \
 	src/gui/TabWidget.o \
 	src/gui/TimeMachineDialog.o \
@@ -30,6 +30,54 @@ my $typesize = PropSet::num_prop_types();
 
 printf "Valid properties found: $setsize\n";
 
+# All distinct property values are stored only once, in a table of strings
+# (with the empty string at index 0); each ROM refers to them by index
+my @strings = ( "" );
+my %stringidx = ( "" => 0 );
+my @rows = ();
+my @md5s = ();
+for my $key ( sort keys %propset )
+{
+  if ($key !~ /^[0-9a-fA-F]{32}$/) {
+    die "Invalid md5sum: $key\n";
+  }
+  my @items = ();
+  for my $value ( PropSet::build_prop_values(@{ $propset{$key} }) )
+  {
+    if (!defined($stringidx{$value})) {
+      $stringidx{$value} = @strings;
+      push(@strings, $value);
+    }
+    push(@items, $stringidx{$value});
+  }
+  push(@rows, [ @items ]);
+  push(@md5s, $key);
+}
+my $stringsize = @strings;
+if ($stringsize > 65535 || $setsize > 65535) {
+  die "Too many properties for 16-bit indices\n";
+}
+
+# Find a perfect hash for the md5sums; using the 32-bit words w[0] - w[3]
+# of an md5sum, its slot in the hash table is
+#   (w[1] + displacement[w[0] % buckets] * (w[2] | 1)) % hashsize
+# Since the multiplier is odd, every md5sum can reach every slot
+# The displacement of each bucket is chosen so that none of its md5sums
+# collide with those already in the table (largest buckets first)
+my $hashsize = 1;
+$hashsize <<= 1 while ($hashsize < $setsize);
+my ($hashtable, $displacement);
+my $numbuckets = $hashsize / 4;
+while (!defined($hashtable))
+{
+  ($hashtable, $displacement) = build_hash($hashsize, $numbuckets);
+  if (!defined($hashtable)) {
+    if ($numbuckets < $hashsize) { $numbuckets *= 2; }
+    else                         { $hashsize *= 2; $numbuckets = $hashsize / 4; }
+  }
+}
+printf "Perfect hash: $hashsize slots, $numbuckets buckets\n";
+
 # Construct the output file in C++ format
 open(OUTFILE, ">$outfile");
 print OUTFILE "//============================================================================\n";
@@ -52,6 +100,8 @@ print OUTFILE "\n";
 print OUTFILE "#ifndef DEF_PROPS_HXX\n";
 print OUTFILE "#define DEF_PROPS_HXX\n";
 print OUTFILE "\n";
+print OUTFILE "#include \"bspf.hxx\"\n";
+print OUTFILE "\n";
 print OUTFILE "/**\n";
 print OUTFILE "  This code is generated using the 'create_props.pl' script,\n";
 print OUTFILE "  located in the src/tools directory.  All properties changes\n";
@@ -59,28 +109,102 @@ print OUTFILE "  should be made in stella.pro, and then this file should be\n";
 print OUTFILE "  regenerated and the application recompiled.\n";
 print OUTFILE "*/\n";
 print OUTFILE "\n#define DEF_PROPS_SIZE " . $setsize;
+print OUTFILE "\n#define DEF_PROPS_STRINGS_SIZE " . $stringsize;
+print OUTFILE "\n#define DEF_PROPS_HASH_SIZE " . $hashsize;
+print OUTFILE "\n#define DEF_PROPS_HASH_BUCKETS " . $numbuckets;
 print OUTFILE "\n\n";
-print OUTFILE "static const char* const DefProps[DEF_PROPS_SIZE][" . $typesize . "] = {\n";
 
-# Walk the hash map and print each item in order of md5sum
-my $idx = 0;
-for my $key ( sort keys %propset )
-{
-  print OUTFILE PropSet::build_prop_string(@{ $propset{$key} });
+print OUTFILE "// All distinct property values, each stored only once\n";
+print OUTFILE "static const char* const DefPropsStrings[DEF_PROPS_STRINGS_SIZE] = {\n";
+print OUTFILE join(",\n", map { "  \"$_\"" } @strings) . "\n";
+print OUTFILE "};\n\n";
 
-  if ($idx+1 < $setsize) {
-    print OUTFILE ",";
-  }
-  print OUTFILE "\n";
-  $idx++;
-}
+print OUTFILE "// The properties of each ROM (in order of md5sum), as indices into\n";
+print OUTFILE "// DefPropsStrings; values equal to the default are empty\n";
+print OUTFILE "static const uInt16 DefProps[DEF_PROPS_SIZE][" . $typesize . "] = {\n";
+print OUTFILE join(",\n", map { "  { " . join(", ", @$_) . " }" } @rows) . "\n";
+print OUTFILE "};\n\n";
+
+print OUTFILE "// The md5sum of each ROM, as 32-bit words (most significant first)\n";
+print OUTFILE "static const uInt32 DefPropsMD5[DEF_PROPS_SIZE][4] = {\n";
+print OUTFILE join(",\n", map { my $m = lc($_);
+  "  { " . join(", ", map { "0x" . substr($m, $_ * 8, 8) } (0..3)) . " }" } @md5s) . "\n";
+print OUTFILE "};\n\n";
+
+print OUTFILE "// Perfect hash of the md5sums; DefPropsHashTable holds the index of\n";
+print OUTFILE "// the ROM at each slot (or 0xFFFF if the slot is empty)\n";
+print OUTFILE "static constexpr uInt16 DefPropsHashDisplacement[DEF_PROPS_HASH_BUCKETS] = {\n";
+print OUTFILE number_list(@$displacement);
+print OUTFILE "};\n\n";
+print OUTFILE "static const uInt16 DefPropsHashTable[DEF_PROPS_HASH_SIZE] = {\n";
+print OUTFILE number_list(@$hashtable);
+print OUTFILE "};\n\n";
 
-print OUTFILE "};\n";
+print OUTFILE "// Returns the slot in DefPropsHashTable of the given md5sum\n";
+print OUTFILE "constexpr uInt32 DefPropsHash(uInt32 w0, uInt32 w1, uInt32 w2)\n";
+print OUTFILE "{\n";
+print OUTFILE "  return (w1 + DefPropsHashDisplacement[w0 % DEF_PROPS_HASH_BUCKETS] * (w2 | 1)) %\n";
+print OUTFILE "         DEF_PROPS_HASH_SIZE;\n";
+print OUTFILE "}\n";
 print OUTFILE "\n";
 print OUTFILE "#endif\n";
 
 close(OUTFILE);
 
+# Try to place all md5sums in a hash table of the given size, using the
+# given number of buckets; returns references to the table and the
+# displacement of each bucket, or nothing if that isn't possible
+sub build_hash {
+  my ($hashsize, $numbuckets) = @_;
+
+  my @buckets = map { [] } (1 .. $numbuckets);
+  for (my $i = 0; $i < @md5s; $i++) {
+    my @w = map { hex(substr($md5s[$i], $_ * 8, 8)) } (0..3);
+    push(@{ $buckets[$w[0] % $numbuckets] }, [ $i, $w[1], $w[2] | 1 ]);
+  }
+
+  my @table = (65535) x $hashsize;
+  my @displacement = (0) x $numbuckets;
+  for my $b ( sort { @{$buckets[$b]} <=> @{$buckets[$a]} || $a <=> $b } (0 .. $numbuckets-1) )
+  {
+    my $keys = $buckets[$b];
+    next if (!@$keys);
+
+    my $found = 0;
+    for (my $d = 0; $d < 65536 && !$found; $d++)
+    {
+      my %used = ();
+      $found = 1;
+      for my $k (@$keys) {
+        my $slot = ($k->[1] + $d * $k->[2]) % $hashsize;
+        if ($table[$slot] != 65535 || defined($used{$slot})) {
+          $found = 0;
+          last;
+        }
+        $used{$slot} = $k->[0];
+      }
+      if ($found) {
+        $table[$_] = $used{$_} for (keys %used);
+        $displacement[$b] = $d;
+      }
+    }
+    return () if (!$found);
+  }
+
+  return (\@table, \@displacement);
+}
+
+# Format a list of numbers, 16 per line
+sub number_list {
+  my @list = @_;
+  my $result = "";
+  for (my $i = 0; $i < @list; $i += 16) {
+    my $end = $i + 15 < $#list ? $i + 15 : $#list;
+    $result .= "  " . join(", ", @list[$i .. $end]);
+    $result .= ($end < $#list ? ",\n" : "\n");
+  }
+  return $result;
+}
 
 sub usage {
   print "create_props.pl <INPUT properties file> <OUTPUT C++ header>\n";
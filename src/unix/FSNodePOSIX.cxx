@@ -225,6 +225,18 @@ bool FilesystemNodePOSIX::rename(const string& newfile)
     return false;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool FilesystemNodePOSIX::getStats(uInt64& size, uInt64& modtime) const
+{
+  struct stat st;
+  if(stat(_path.c_str(), &st) != 0)
+    return false;
+
+  size = uInt64(st.st_size);
+  modtime = uInt64(st.st_mtime);
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AbstractFSNode* FilesystemNodePOSIX::getParent() const
 {
@@ -70,6 +70,7 @@ class FilesystemNodePOSIX : public AbstractFSNode
     bool isWritable() const override  { return access(_path.c_str(), W_OK) == 0; }
     bool makeDir() override;
     bool rename(const string& newfile) override;
+    bool getStats(uInt64& size, uInt64& modtime) const override;
 
     bool getChildren(AbstractFSList& list, ListMode mode, bool hidden) const override;
     AbstractFSNode* getParent() const override;